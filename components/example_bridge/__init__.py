@@ -2,42 +2,213 @@
 
 import os
 
+from esphome import pins
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.const import CONF_ID
+from esphome.const import CONF_ID, CONF_PLATFORM
+from esphome.core import CORE, TimePeriod
 
 CODEOWNERS = ["@dragan"]
 DEPENDENCIES = []
-AUTO_LOAD = ["binary_sensor"]
+AUTO_LOAD = ["binary_sensor", "sensor"]
 
 # Namespace
 home_esp_ns = cg.esphome_ns.namespace("home_esp")
 ExampleBridgeComponent = home_esp_ns.class_("ExampleBridgeComponent", cg.Component)
+RF433Timing = home_esp_ns.class_("RF433Timing")
+Gesture = home_esp_ns.enum("Gesture", is_class=True)
+remote_transmitter_ns = cg.esphome_ns.namespace("remote_transmitter")
+RemoteTransmitterComponent = remote_transmitter_ns.class_(
+    "RemoteTransmitterComponent", cg.Component
+)
 
 # Configuration keys
 CONF_PULSE_LENGTH = "pulse_length"
 CONF_TOLERANCE = "tolerance"
 CONF_MOTION_CODE = "motion_code"
+CONF_GLITCH_FILTER = "glitch_filter"
+CONF_MIN_SYNC_GAP = "min_sync_gap"
+CONF_DEDUP_WINDOW = "dedup_window"
+CONF_VOTES_REQUIRED = "votes_required"
+CONF_VOTE_FRAMES = "vote_frames"
+CONF_TRANSMITTER_ID = "transmitter_id"
+CONF_TRANSMIT_PIN = "transmit_pin"
+CONF_TRANSMIT_REPEATS = "transmit_repeats"
+CONF_REPEAT_GAP = "repeat_gap"
+CONF_DOUBLE_CLICK = "double_click"
+CONF_LONG_PRESS = "long_press"
+
+# PT2262 pulse shape the bridge decodes, in pulse_length units
+SYNC_LOW_PULSES = 31
+SHORTEST_PULSES = 1
+DEFAULT_GLITCH_FILTER_US = 100
+DEFAULT_MIN_SYNC_GAP_US = 4000
+
+# Binary sensor platform keys (shared with binary_sensor.py)
+CONF_EXAMPLE_BRIDGE_ID = "example_bridge_id"
+CONF_CODE = "code"
+CONF_PROTOCOL = "protocol"
+CONF_GESTURE = "gesture"
+CONF_AUTO_OFF = "auto_off"
+GESTURES = {
+    "single": Gesture.SINGLE,
+    "double": Gesture.DOUBLE,
+    "long": Gesture.LONG,
+}
+
+
+def validate_votes(config):
+    """Voting needs at least as many frames as votes."""
+    if config[CONF_VOTE_FRAMES] < config[CONF_VOTES_REQUIRED]:
+        raise cv.Invalid(f"{CONF_VOTE_FRAMES} must be at least {CONF_VOTES_REQUIRED}")
+    return config
+
+
+def min_width_us(config, pulses):
+    """Shortest width a pulse of that many pulse_lengths is accepted at."""
+    expected = config[CONF_PULSE_LENGTH] * pulses
+    return expected - expected * config[CONF_TOLERANCE] // 100
+
+
+def validate_filter(config):
+    """The pulse filter must pass every frame at the configured timing.
+
+    Glitches must be shorter than the shortest pulse and the sync gate
+    must open on the shortest sync low. The defaults are lowered to fit
+    short pulse lengths; explicit values that would drop frames are
+    rejected.
+    """
+    shortest_pulse = min_width_us(config, SHORTEST_PULSES)
+    shortest_sync = min_width_us(config, SYNC_LOW_PULSES)
+    if CONF_GLITCH_FILTER not in config:
+        config[CONF_GLITCH_FILTER] = cv.positive_time_period_microseconds(
+            f"{min(DEFAULT_GLITCH_FILTER_US, shortest_pulse // 2)}us"
+        )
+    elif config[CONF_GLITCH_FILTER].total_microseconds >= shortest_pulse:
+        raise cv.Invalid(
+            f"{CONF_GLITCH_FILTER} must be below the shortest pulse "
+            f"({shortest_pulse}us at this {CONF_PULSE_LENGTH} and {CONF_TOLERANCE})",
+            path=[CONF_GLITCH_FILTER],
+        )
+    if CONF_MIN_SYNC_GAP not in config:
+        config[CONF_MIN_SYNC_GAP] = cv.positive_time_period_microseconds(
+            f"{min(DEFAULT_MIN_SYNC_GAP_US, shortest_sync)}us"
+        )
+    elif config[CONF_MIN_SYNC_GAP].total_microseconds > shortest_sync:
+        raise cv.Invalid(
+            f"{CONF_MIN_SYNC_GAP} must not exceed the shortest sync low "
+            f"({shortest_sync}us at this {CONF_PULSE_LENGTH} and {CONF_TOLERANCE})",
+            path=[CONF_MIN_SYNC_GAP],
+        )
+    return config
+
 
 # Configuration schema
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.GenerateID(): cv.declare_id(ExampleBridgeComponent),
-        cv.Optional(CONF_PULSE_LENGTH, default=350): cv.int_range(min=100, max=1000),
-        cv.Optional(CONF_TOLERANCE, default=25): cv.int_range(min=5, max=50),
-        cv.Optional(CONF_MOTION_CODE, default=0): cv.uint32_t,
-    }
-).extend(cv.COMPONENT_SCHEMA)
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ExampleBridgeComponent),
+            cv.Optional(CONF_PULSE_LENGTH, default=350): cv.int_range(
+                min=100, max=1000
+            ),
+            cv.Optional(CONF_TOLERANCE, default=25): cv.int_range(min=5, max=50),
+            cv.Optional(CONF_MOTION_CODE, default=0): cv.uint32_t,
+            # Defaults to 100us, lowered for short pulse lengths
+            cv.Optional(CONF_GLITCH_FILTER): cv.All(
+                cv.positive_time_period_microseconds,
+                cv.Range(max=TimePeriod(microseconds=1000)),
+            ),
+            # 0 disables the sync gate; rc-switch protocol 4 needs ~1700us.
+            # Defaults to 4000us, lowered for short pulse lengths
+            cv.Optional(CONF_MIN_SYNC_GAP): cv.All(
+                cv.positive_time_period_microseconds,
+                cv.Range(max=TimePeriod(microseconds=65535)),
+            ),
+            cv.Optional(
+                CONF_DEDUP_WINDOW, default="500ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_VOTES_REQUIRED, default=1): cv.int_range(min=1, max=8),
+            cv.Optional(CONF_VOTE_FRAMES, default=1): cv.int_range(min=1, max=8),
+            # Send codes from an RMT channel of the bridge's own (ESP32,
+            # does not block loop()), or through a remote_transmitter that
+            # blocks for each frame; with neither the bridge only receives
+            cv.Exclusive(CONF_TRANSMIT_PIN, "transmitter"): cv.All(
+                cv.only_on_esp32, pins.internal_gpio_output_pin_number
+            ),
+            cv.Exclusive(CONF_TRANSMITTER_ID, "transmitter"): cv.use_id(
+                RemoteTransmitterComponent
+            ),
+            cv.Optional(CONF_TRANSMIT_REPEATS, default=4): cv.int_range(
+                min=1, max=20
+            ),
+            # Gesture timing for binary sensors with a `gesture:`; a
+            # double_click of 0 fires single presses on release
+            cv.Optional(CONF_REPEAT_GAP, default="150ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=TimePeriod(milliseconds=65535)),
+            ),
+            cv.Optional(CONF_DOUBLE_CLICK, default="400ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=TimePeriod(milliseconds=65535)),
+            ),
+            cv.Optional(CONF_LONG_PRESS, default="800ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=TimePeriod(milliseconds=65535)),
+            ),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_votes,
+    validate_filter,
+)
+
+
+def count_code_sensors(bridge_id):
+    """Number of binary sensors with a code routed through this bridge.
+
+    Gesture sensors are driven by the gesture detector, not the router.
+    """
+    count = 0
+    for conf in CORE.config.get("binary_sensor", []):
+        if (
+            conf.get(CONF_PLATFORM) == "example_bridge"
+            and CONF_CODE in conf
+            and CONF_GESTURE not in conf
+            and conf[CONF_EXAMPLE_BRIDGE_ID].id == bridge_id.id
+        ):
+            count += 1
+    return count
 
 
 async def to_code(config):
     """Generate C++ code for the component."""
-    var = cg.new_Pvariable(config[CONF_ID])
+    # Timing is baked into the component type so decoding uses constants,
+    # and the routing table is sized for exactly the configured codes
+    timing = RF433Timing.template(config[CONF_PULSE_LENGTH], config[CONF_TOLERANCE])
+    routes = max(1, count_code_sensors(config[CONF_ID]))
+    var = cg.new_Pvariable(config[CONF_ID], cg.TemplateArguments(timing, routes))
     await cg.register_component(var, config)
 
-    cg.add(var.set_pulse_length(config[CONF_PULSE_LENGTH]))
-    cg.add(var.set_tolerance(config[CONF_TOLERANCE]))
     cg.add(var.set_motion_code(config[CONF_MOTION_CODE]))
+    cg.add(var.set_glitch_filter(config[CONF_GLITCH_FILTER]))
+    cg.add(var.set_min_sync_gap(config[CONF_MIN_SYNC_GAP]))
+    cg.add(var.set_dedup_window(config[CONF_DEDUP_WINDOW]))
+    cg.add(var.set_votes(config[CONF_VOTES_REQUIRED], config[CONF_VOTE_FRAMES]))
+    cg.add(var.set_transmit_repeats(config[CONF_TRANSMIT_REPEATS]))
+    cg.add(
+        var.set_gesture_timing(
+            config[CONF_REPEAT_GAP],
+            config[CONF_DOUBLE_CLICK],
+            config[CONF_LONG_PRESS],
+        )
+    )
+
+    if CONF_TRANSMITTER_ID in config:
+        transmitter = await cg.get_variable(config[CONF_TRANSMITTER_ID])
+        cg.add_define("HOME_ESP_USE_REMOTE_TRANSMITTER")
+        cg.add(var.set_remote_transmitter(transmitter))
+    if CONF_TRANSMIT_PIN in config:
+        cg.add_define("HOME_ESP_USE_RMT_TRANSMITTER")
+        cg.add(var.set_transmit_pin(config[CONF_TRANSMIT_PIN]))
 
     # Add include paths for lib/ headers (core/* includes) and lib/core/ headers (interfaces/* includes)
     lib_path = os.path.abspath(
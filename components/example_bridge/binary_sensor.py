@@ -2,28 +2,110 @@
 
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome.components import binary_sensor
-from esphome.const import DEVICE_CLASS_MOTION
+from esphome.const import CONF_PLATFORM, DEVICE_CLASS_MOTION
 
-from . import ExampleBridgeComponent
+from . import (
+    CONF_AUTO_OFF,
+    CONF_CODE,
+    CONF_EXAMPLE_BRIDGE_ID,
+    CONF_GESTURE,
+    CONF_MOTION_CODE,
+    CONF_PROTOCOL,
+    GESTURES,
+    ExampleBridgeComponent,
+)
 
 DEPENDENCIES = ["example_bridge"]
 
-# Parent component ID key (separate from entity ID)
-CONF_EXAMPLE_BRIDGE_ID = "example_bridge_id"
+
+def validate_gesture(config):
+    """A gesture belongs to a button code and is momentary."""
+    if CONF_GESTURE in config and CONF_CODE not in config:
+        raise cv.Invalid(f"{CONF_GESTURE} requires {CONF_CODE}")
+    if CONF_GESTURE in config and CONF_AUTO_OFF in config:
+        raise cv.Invalid(f"{CONF_AUTO_OFF} cannot be combined with {CONF_GESTURE}")
+    return config
+
+
+def protocols_overlap(a, b):
+    """Protocol 0 matches every protocol."""
+    return a == b or a == 0 or b == 0
+
+
+def validate_gesture_codes(config):
+    """A gesture button's frames only reach the gesture detector, so no
+    plain sensor (code or motion) may listen for the same code."""
+    if CONF_GESTURE in config:
+        return config
+    full_config = fv.full_config.get()
+    bridge_id = config[CONF_EXAMPLE_BRIDGE_ID]
+    if CONF_CODE in config:
+        code = config[CONF_CODE]
+    else:
+        bridge_path = full_config.get_path_for_id(bridge_id)[:-1]
+        code = full_config.get_config_for_path(bridge_path)[CONF_MOTION_CODE]
+    for conf in full_config.get("binary_sensor", []):
+        if (
+            conf.get(CONF_PLATFORM) == "example_bridge"
+            and CONF_GESTURE in conf
+            and conf[CONF_EXAMPLE_BRIDGE_ID].id == bridge_id.id
+            and conf[CONF_CODE] == code
+            and protocols_overlap(conf[CONF_PROTOCOL], config[CONF_PROTOCOL])
+        ):
+            raise cv.Invalid(
+                f"Code 0x{code:08X} drives a {CONF_GESTURE} sensor; its frames "
+                f"go to the gesture detector only and cannot also drive this sensor"
+            )
+    return config
+
 
 # Configuration schema for the binary sensor platform
-CONFIG_SCHEMA = binary_sensor.binary_sensor_schema(
-    device_class=DEVICE_CLASS_MOTION,
-).extend(
-    {
-        cv.GenerateID(CONF_EXAMPLE_BRIDGE_ID): cv.use_id(ExampleBridgeComponent),
-    }
+CONFIG_SCHEMA = cv.All(
+    binary_sensor.binary_sensor_schema(
+        device_class=DEVICE_CLASS_MOTION,
+    ).extend(
+        {
+            cv.GenerateID(CONF_EXAMPLE_BRIDGE_ID): cv.use_id(ExampleBridgeComponent),
+            # Without a code the sensor follows the bridge's motion_code
+            cv.Optional(CONF_CODE): cv.uint32_t,
+            # 0 matches the code from any protocol
+            cv.Optional(CONF_PROTOCOL, default=0): cv.int_range(min=0, max=255),
+            # Pulse on/off when this press pattern is seen on the code's
+            # button, recognised on the device rather than in Home Assistant
+            cv.Optional(CONF_GESTURE): cv.enum(GESTURES, lower=True),
+            # Turn off this long after the code was last received, for
+            # transmitters that never send a "clear" code (e.g. PIRs)
+            cv.Optional(CONF_AUTO_OFF): cv.positive_time_period_milliseconds,
+        }
+    ),
+    validate_gesture,
 )
 
+FINAL_VALIDATE_SCHEMA = validate_gesture_codes
+
 
 async def to_code(config):
     """Generate C++ code for the binary sensor platform."""
     parent = await cg.get_variable(config[CONF_EXAMPLE_BRIDGE_ID])
     sens = await binary_sensor.new_binary_sensor(config)
-    cg.add(parent.set_motion_sensor(sens))
+    if CONF_GESTURE in config:
+        cg.add(
+            parent.add_gesture_sensor(
+                sens, config[CONF_CODE], config[CONF_PROTOCOL], config[CONF_GESTURE]
+            )
+        )
+    elif CONF_CODE in config:
+        cg.add(
+            parent.add_code_sensor(
+                sens,
+                config[CONF_CODE],
+                config[CONF_PROTOCOL],
+                config.get(CONF_AUTO_OFF, 0),
+            )
+        )
+    else:
+        cg.add(parent.set_motion_sensor(sens))
+        if CONF_AUTO_OFF in config:
+            cg.add(parent.set_motion_auto_off(config[CONF_AUTO_OFF]))
@@ -5,10 +5,24 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/sensor/sensor.h"
 
 // Include our abstracted business logic
+#include "core/gesture_detector.h"
 #include "core/rf433_codec.h"
+#include "core/rf433_codec_t.h"
+#include "core/rf433_profile_decoder.h"
+#include "core/rf433_stream_decoder.h"
+#include "core/timer_wheel.h"
+#include "core/timing_learner.h"
+#include "core/transmit_queue.h"
 #include "core/adapters/esphome_binary_adapter.h"
+#ifdef HOME_ESP_USE_REMOTE_TRANSMITTER
+#include "core/adapters/esphome_remote_transmitter_adapter.h"
+#endif
+#ifdef HOME_ESP_USE_RMT_TRANSMITTER
+#include "core/adapters/rmt_transmitter_adapter.h"
+#endif
 
 #include <memory>
 
@@ -16,73 +30,387 @@ namespace home_esp {
 
 static const char* const BRIDGE_TAG = "example_bridge";
 
+/// ISR-to-loop queue: 512 edges covers ~10 full PT2262 frames
+using RFPulseRing = PulseRingBuffer<512>;
+
+/// Diagnostic counters exposed by the bridge's sensor platform
+enum class BridgeStat : uint8_t {
+  FRAMES_SEEN,
+  FRAMES_ACCEPTED,
+  REJECTED_LENGTH,
+  REJECTED_SYNC,
+  REJECTED_BITS,
+  PULSE_ERROR,         // Mean timing error of accepted pulses, %
+  NOISE_EDGES,         // Edges removed by the pulse filter
+  REPEATS_SUPPRESSED,
+  COUNT,
+};
+
+/// How often the diagnostic sensors are republished
+static constexpr uint32_t STATS_PUBLISH_INTERVAL_MS = 60000;
+
+/// Quiet time after the last edge before held edges and a pending short
+/// frame are flushed to the decoder (longer than any gap inside a frame)
+static constexpr uint32_t RX_IDLE_FLUSH_MS = 50;
+
+/// Runtime timing profiles kept from learning mode (oldest replaced first)
+static constexpr size_t MAX_LEARNED_PROFILES = 4;
+
+/// Remote buttons whose presses are turned into gestures
+static constexpr size_t MAX_GESTURE_CODES = 8;
+
+/// RF433 bridge specialized on its YAML pulse_length/tolerance.
+///
+/// The timing is a template argument (emitted by __init__.py as
+/// `ExampleBridgeComponent<RF433Timing<pulse_length, tolerance>, routes>`)
+/// so the hot decode path runs on RF433CodecT's compile-time windows.
+/// MaxRoutes is the number of binary sensors with a `code:`, which sizes
+/// the code routing table.
+template <typename Timing = RF433Timing<>, size_t MaxRoutes = 1>
 class ExampleBridgeComponent : public esphome::Component {
  public:
+  using Codec = RF433CodecT<Timing>;
+
   ExampleBridgeComponent() = default;
 
   // ESPHome configuration setters
   void set_motion_sensor(esphome::binary_sensor::BinarySensor* sensor) {
     motion_sensor_ = sensor;
   }
-  void set_pulse_length(uint16_t length) { pulse_length_ = length; }
-  void set_tolerance(uint8_t tolerance) { tolerance_ = tolerance; }
   void set_motion_code(uint32_t code) { motion_code_ = code; }
+  /// Turn the motion sensor off auto_off_ms after its code was last seen
+  /// (PIR transmitters never send a "clear" code; 0 = stay on)
+  void set_motion_auto_off(uint32_t auto_off_ms) { motion_auto_off_ms_ = auto_off_ms; }
+  /// Publish `code` (from `protocol`, or any if 0) to its own sensor,
+  /// turning it off again auto_off_ms after the last frame (0 = never)
+  void add_code_sensor(esphome::binary_sensor::BinarySensor* sensor,
+                       uint32_t code, uint8_t protocol, uint32_t auto_off_ms = 0) {
+    if (route_count_ >= MaxRoutes) {
+      ESP_LOGE(BRIDGE_TAG, "No route left for code 0x%08X", code);
+      return;
+    }
+    auto& adapter = route_adapters_[route_count_++];
+    adapter = std::make_unique<ESPHomeBinaryAdapter>(sensor);
+    router_.add(code, protocol, adapter.get());
+    if (auto_off_ms > 0) {
+      add_auto_off(sensor, code, protocol, auto_off_ms);
+    }
+  }
+  /// Pulse sensor on/off when `gesture` is recognised on `code`. The
+  /// code's frames then only drive gestures, not a plain code sensor.
+  void add_gesture_sensor(esphome::binary_sensor::BinarySensor* sensor, uint32_t code,
+                          uint8_t protocol, Gesture gesture) {
+    GestureSensors* button = nullptr;
+    for (size_t i = 0; i < gesture_button_count_; ++i) {
+      if (gesture_buttons_[i].code == code && gesture_buttons_[i].protocol == protocol) {
+        button = &gesture_buttons_[i];
+      }
+    }
+    if (button == nullptr) {
+      if (gesture_button_count_ >= MAX_GESTURE_CODES) {
+        ESP_LOGE(BRIDGE_TAG, "No gesture slot left for code 0x%08X", code);
+        return;
+      }
+      button = &gesture_buttons_[gesture_button_count_++];
+      button->code = code;
+      button->protocol = protocol;
+      gesture_detector_.add(code, protocol, button);
+    }
+    button->sensors[static_cast<size_t>(gesture)] = sensor;
+  }
+  void set_gesture_timing(uint16_t repeat_gap_ms, uint16_t double_click_ms,
+                          uint16_t long_press_ms) {
+    GestureDetector::Config config;
+    config.repeat_gap_ms = repeat_gap_ms;
+    config.double_click_ms = double_click_ms;
+    config.long_press_ms = long_press_ms;
+    gesture_detector_.set_config(config);
+  }
+  void set_stat_sensor(BridgeStat stat, esphome::sensor::Sensor* sensor) {
+    stat_sensors_[static_cast<size_t>(stat)] = sensor;
+  }
+  void set_glitch_filter(uint16_t us) { filter_config_.glitch_us = us; }
+  void set_min_sync_gap(uint16_t us) { filter_config_.min_sync_gap_us = us; }
+  void set_dedup_window(uint32_t ms) { repeat_config_.dedup_window_ms = ms; }
+  void set_votes(uint8_t required, uint8_t frames) {
+    repeat_config_.votes_required = required;
+    repeat_config_.vote_frames = frames;
+  }
+  /// Decode a sensor type's frames into its field sensors, e.g. a
+  /// PayloadDecoder<LAYOUT> built in a lambda or custom component.
+  /// Must be called before setup().
+  void add_payload_decoder(IPayloadDecoder* decoder) {
+    if (payload_decoder_count_ >= RF433Receiver::MAX_PAYLOAD_DECODERS) {
+      ESP_LOGE(BRIDGE_TAG, "No payload decoder slot left");
+      return;
+    }
+    payload_decoders_[payload_decoder_count_++] = decoder;
+  }
+  /// Radio used by send_code(); without one the bridge is receive-only
+  void set_transmitter(IPulseTransmitter* transmitter) { transmitter_ = transmitter; }
+#ifdef HOME_ESP_USE_REMOTE_TRANSMITTER
+  /// remote_transmitter blocks until its frames are out, so it is handed
+  /// one frame per loop() and other components run between repeats
+  void set_remote_transmitter(esphome::remote_transmitter::RemoteTransmitterComponent* tx) {
+    transmitter_adapter_ = std::make_unique<ESPHomeRemoteTransmitterAdapter>(tx);
+    transmitter_ = transmitter_adapter_.get();
+    tx_config_.burst_repeats = 1;
+  }
+#endif
+#ifdef HOME_ESP_USE_RMT_TRANSMITTER
+  /// Send from an RMT channel of our own on pin, without blocking loop()
+  void set_transmit_pin(int pin) { transmit_pin_ = pin; }
+#endif
+  void set_transmit_repeats(uint8_t repeats) { transmit_repeats_ = repeats; }
 
   void setup() override {
     ESP_LOGCONFIG(BRIDGE_TAG, "Setting up RF433 Bridge...");
 
-    // Configure the codec
-    RF433Codec::TimingConfig config;
-    config.pulse_length_us = pulse_length_;
-    config.tolerance_percent = tolerance_;
+    // Runtime codec for inject_rf_data(); the ring is decoded by
+    // stream_decoder_ using the compile-time timing and learned profiles
+    codec_ = std::make_unique<RF433Codec>(Codec::timing_config());
 
-    codec_ = std::make_unique<RF433Codec>(config);
+    // Measuring every pulse costs about as much as decoding the frame,
+    // so only when a sensor reports timing error or sync rejects
+    timing_stats_ = stat_sensors_[static_cast<size_t>(BridgeStat::PULSE_ERROR)] != nullptr ||
+                    stat_sensors_[static_cast<size_t>(BridgeStat::REJECTED_SYNC)] != nullptr;
+    if (timing_stats_) {
+      codec_->set_timing_stats(true);
+      stream_decoder_.enable_timing_stats(Codec::timing_config());
+    }
+
+#ifdef HOME_ESP_USE_RMT_TRANSMITTER
+    if (transmit_pin_ >= 0) {
+      auto rmt = std::make_unique<RmtTransmitterAdapter>(transmit_pin_, Codec::timing_config());
+      if (rmt->begin()) {
+        transmitter_ = rmt.get();
+        transmitter_adapter_ = std::move(rmt);
+      } else {
+        ESP_LOGE(BRIDGE_TAG, "No RMT channel for transmit pin GPIO%d", transmit_pin_);
+      }
+    }
+#endif
+    if (transmitter_ != nullptr) {
+      tx_queue_ = std::make_unique<TransmitQueue<>>(codec_.get(), transmitter_, tx_config_);
+    }
 
     // Create adapter for binary sensor
     if (motion_sensor_ != nullptr) {
       motion_adapter_ = std::make_unique<ESPHomeBinaryAdapter>(motion_sensor_);
+    }
+
+    if (motion_adapter_ != nullptr || router_.size() > 0 || payload_decoder_count_ > 0 ||
+        gesture_detector_.size() > 0) {
       receiver_ = std::make_unique<RF433Receiver>(codec_.get(), motion_adapter_.get());
       receiver_->register_motion_code(motion_code_);
+      receiver_->set_router(&router_);
+      if (motion_adapter_ != nullptr && motion_auto_off_ms_ > 0) {
+        add_auto_off(motion_sensor_, motion_code_, CodeRouter::ANY_PROTOCOL,
+                     motion_auto_off_ms_);
+      }
+      if (auto_off_count_ > 0) {
+        receiver_->set_frame_router(&frame_router_);
+      }
+      receiver_->set_gesture_detector(&gesture_detector_);
+      for (size_t i = 0; i < payload_decoder_count_; ++i) {
+        receiver_->add_payload_decoder(payload_decoders_[i]);
+      }
+
+      if (admit_to_filter(Codec::timing_config())) {
+        ESP_LOGW(BRIDGE_TAG, "Pulse filter loosened for pulse_length: glitch %u us, sync gap %u us",
+                 static_cast<unsigned>(filter_config_.glitch_us),
+                 static_cast<unsigned>(filter_config_.min_sync_gap_us));
+      }
+      pulse_filter_ = PulseFilter(filter_config_);
+      repeat_filter_ = RepeatFilter(repeat_config_);
+      receiver_->set_repeat_filter(&repeat_filter_);
     }
   }
 
   void loop() override {
-    // In a real component, this would read from an RF receiver
-    // connected via GPIO interrupt or polling
-
-    // Example: check for received data
-    if (has_pending_rf_data()) {
-      uint8_t buffer[256];
-      size_t len = read_rf_data(buffer, sizeof(buffer));
-
-      if (len > 0 && receiver_ != nullptr) {
-        receiver_->process_pulses(buffer, len);
-
-        if (receiver_->has_valid_code()) {
+    // Edge durations are pushed into pulse_ring_ by the RF receiver's
+    // GPIO interrupt (see pulse_ring()); drain everything queued since
+    // the last pass in one go. Glitches and idle noise are filtered out
+    // first; frames are then decoded edge by edge, so a code is
+    // published on the pass that sees its last bit. Once the line has
+    // been quiet for RX_IDLE_FLUSH_MS, whatever the filter and decoder
+    // still hold is flushed, so a burst's final frame is not left
+    // waiting for the next edge.
+    uint32_t now = millis();
+    if (tx_queue_ != nullptr) {
+      tx_queue_->update(now);
+      if (tx_queue_->is_receive_paused()) {
+        // Our own frames, and the receiver's AGC settling after them
+        pulse_ring_.consume(pulse_ring_.available());
+        stream_decoder_.reset();
+        pulse_filter_.reset();
+        learner_.reset_frame();
+      }
+    }
+    if (receiver_ == nullptr) {
+      return;
+    }
+    if (learning_ && now - learning_started_ >= learning_duration_ms_) {
+      finish_learning();
+    }
+    repeat_filter_.update(now);
+    gesture_detector_.update(now);
+    auto_off_wheel_.update(now, [this](uint16_t id) {
+      esphome::binary_sensor::BinarySensor* sensor = auto_offs_[id].sensor;
+      if (sensor->state) {
+        sensor->publish_state(false);
+      }
+    });
+    if (now - last_stats_publish_ >= STATS_PUBLISH_INTERVAL_MS) {
+      last_stats_publish_ = now;
+      publish_stats();
+    }
+    if (pulse_ring_.empty()) {
+      if (rx_flush_pending_ && now - last_edge_millis_ >= RX_IDLE_FLUSH_MS) {
+        rx_flush_pending_ = false;
+        if (flush_receiver() > 0) {
           ESP_LOGD(BRIDGE_TAG, "Received RF code: 0x%08X",
                    receiver_->get_last_code());
         }
       }
+      return;
+    }
+    last_edge_millis_ = now;
+    rx_flush_pending_ = true;
+
+    size_t frames = 0;
+    if (learning_) {
+      LearningDecoder decoder{this};
+      frames = receiver_->drain(pulse_ring_, pulse_filter_, decoder);
+    } else {
+      frames = receiver_->drain(pulse_ring_, pulse_filter_, stream_decoder_);
+    }
+    if (frames > 0) {
+      ESP_LOGD(BRIDGE_TAG, "Received RF code: 0x%08X",
+               receiver_->get_last_code());
+    }
+
+    uint32_t overflows = pulse_ring_.overflow_count();
+    if (overflows != reported_overflows_) {
+      ESP_LOGW(BRIDGE_TAG, "Pulse ring overflowed (%u pulses dropped, high water %u)",
+               overflows, static_cast<unsigned>(pulse_ring_.high_water_mark()));
+      reported_overflows_ = overflows;
     }
   }
 
   void dump_config() override {
     ESP_LOGCONFIG(BRIDGE_TAG, "RF433 Bridge:");
-    ESP_LOGCONFIG(BRIDGE_TAG, "  Pulse length: %u us", pulse_length_);
-    ESP_LOGCONFIG(BRIDGE_TAG, "  Tolerance: %u%%", tolerance_);
+    ESP_LOGCONFIG(BRIDGE_TAG, "  Pulse length: %u us",
+                  static_cast<unsigned>(Timing::PULSE_LENGTH_US));
+    ESP_LOGCONFIG(BRIDGE_TAG, "  Tolerance: %u%%",
+                  static_cast<unsigned>(Timing::TOLERANCE_PERCENT));
     ESP_LOGCONFIG(BRIDGE_TAG, "  Motion code: 0x%08X", motion_code_);
+    ESP_LOGCONFIG(BRIDGE_TAG, "  Glitch filter: %u us, sync gap: %u us",
+                  static_cast<unsigned>(filter_config_.glitch_us),
+                  static_cast<unsigned>(filter_config_.min_sync_gap_us));
+    ESP_LOGCONFIG(BRIDGE_TAG, "  Dedup window: %u ms",
+                  static_cast<unsigned>(repeat_config_.dedup_window_ms));
+    ESP_LOGCONFIG(BRIDGE_TAG, "  Votes: %u of %u frames",
+                  static_cast<unsigned>(repeat_config_.votes_required),
+                  static_cast<unsigned>(repeat_config_.vote_frames));
     esphome::binary_sensor::log_binary_sensor(BRIDGE_TAG, "  ", "Motion", motion_sensor_);
+    ESP_LOGCONFIG(BRIDGE_TAG, "  Routed codes: %u/%u",
+                  static_cast<unsigned>(router_.size()),
+                  static_cast<unsigned>(MaxRoutes));
+    if (auto_off_count_ > 0) {
+      ESP_LOGCONFIG(BRIDGE_TAG, "  Auto-off sensors: %u",
+                    static_cast<unsigned>(auto_off_count_));
+    }
+    if (gesture_detector_.size() > 0) {
+      ESP_LOGCONFIG(BRIDGE_TAG, "  Gesture buttons: %u (double click %u ms, long press %u ms)",
+                    static_cast<unsigned>(gesture_detector_.size()),
+                    static_cast<unsigned>(gesture_detector_.get_config().double_click_ms),
+                    static_cast<unsigned>(gesture_detector_.get_config().long_press_ms));
+    }
+    ESP_LOGCONFIG(BRIDGE_TAG, "  Sensor payload types: %u",
+                  static_cast<unsigned>(payload_decoder_count_));
+    if (transmitter_ != nullptr) {
+      ESP_LOGCONFIG(BRIDGE_TAG, "  Transmit repeats: %u (%u per loop)",
+                    static_cast<unsigned>(transmit_repeats_),
+                    static_cast<unsigned>(tx_config_.burst_repeats));
+#ifdef HOME_ESP_USE_RMT_TRANSMITTER
+      if (transmit_pin_ >= 0) {
+        ESP_LOGCONFIG(BRIDGE_TAG, "  Transmit pin: GPIO%d", transmit_pin_);
+      }
+#endif
+    }
   }
 
   float get_setup_priority() const override {
     return esphome::setup_priority::DATA;
   }
 
-  /// Manually inject RF data for testing
-  void inject_rf_data(const uint8_t* data, size_t len) {
-    if (receiver_ != nullptr) {
-      receiver_->process_pulses(data, len);
+  /// Decode a whole capture (DMA buffer, test vector) in one call.
+  /// Every frame found is processed, including back-to-back repeats and
+  /// a short frame the capture ends in.
+  /// @return Bytes consumed (see RF433Codec::decode_all)
+  size_t inject_rf_data(const uint8_t* data, size_t len) {
+    if (receiver_ == nullptr) {
+      return 0;
     }
+
+    size_t consumed = 0;
+    while (consumed < len) {
+      DecodedMessage frames[8];
+      size_t found = 0;
+      size_t used = codec_->decode_all(data + consumed, len - consumed, frames,
+                                       sizeof(frames) / sizeof(frames[0]), found,
+                                       true);
+      for (size_t i = 0; i < found; ++i) {
+        receiver_->process_message(frames[i]);
+      }
+      consumed += used;
+      if (found == 0 || used == 0) {
+        break;
+      }
+    }
+    return consumed;
+  }
+
+  /// Queue a code for transmission (e.g. from a Home Assistant action).
+  /// Returns at once; frames go out from loop().
+  /// @param repeats Frames to send, or 0 for the configured transmit_repeats
+  /// @return false if there is no transmitter, the queue is full or the
+  ///         code cannot be encoded
+  bool send_code(uint32_t code, uint8_t bit_length = 24, uint8_t repeats = 0) {
+    if (tx_queue_ == nullptr) {
+      ESP_LOGW(BRIDGE_TAG, "No transmitter configured for code 0x%08X", code);
+      return false;
+    }
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bit_length;
+    msg.protocol = RF433Codec::PROTOCOL_PT2262;
+    if (!tx_queue_->enqueue(msg, repeats != 0 ? repeats : transmit_repeats_)) {
+      ESP_LOGW(BRIDGE_TAG, "Transmit queue rejected code 0x%08X", code);
+      return false;
+    }
+    return true;
+  }
+
+  /// Learn a remote's timing: press its buttons within duration_ms.
+  /// Frames keep decoding meanwhile; afterwards the learned profile is
+  /// logged, and until reboot frames with its sync are decoded with it
+  /// instead of the configured timing.
+  void start_learning(uint32_t duration_ms = 10000) {
+    learner_.reset();
+    learning_ = true;
+    learning_started_ = millis();
+    learning_duration_ms_ = duration_ms;
+    ESP_LOGI(BRIDGE_TAG, "Learning RF timing for %u ms", duration_ms);
+  }
+
+  bool is_learning() const { return learning_; }
+
+  /// Profiles learned since boot, oldest first until the table wraps
+  size_t learned_profile_count() const { return stream_decoder_.profile_count(); }
+  const RF433Codec::TimingConfig& learned_profile(size_t index) const {
+    return stream_decoder_.profile(index);
   }
 
   /// Get the last received code
@@ -90,24 +418,202 @@ class ExampleBridgeComponent : public esphome::Component {
     return receiver_ ? receiver_->get_last_code() : 0;
   }
 
- protected:
-  // Override these in subclass for real hardware
-  virtual bool has_pending_rf_data() { return false; }
-  virtual size_t read_rf_data(uint8_t* buffer, size_t max_len) {
-    (void)buffer;
-    (void)max_len;
-    return 0;
+  /// Decode counters of the stream decoder and inject_rf_data() combined;
+  /// each received frame is counted once, by the profile that decoded it
+  RF433DecodeStats decode_stats() const {
+    RF433DecodeStats stats = stream_decoder_.stats();
+    if (codec_ != nullptr) {
+      stats += codec_->get_stats();
+    }
+    return stats;
   }
 
+  /// Noise filter counters (merged/dropped edges)
+  const PulseFilter& pulse_filter() const { return pulse_filter_; }
+
+  /// Repeat handling counters (suppressed/rejected publishes)
+  const RepeatFilter& repeat_filter() const { return repeat_filter_; }
+
+  /// Ring the RF receiver interrupt pushes edge durations into.
+  /// push() is the only call that may be made from interrupt context.
+  RFPulseRing& pulse_ring() { return pulse_ring_; }
+
  private:
+  /// Timers: one per code sensor, plus the motion sensor
+  static constexpr size_t MAX_AUTO_OFF = MaxRoutes + 1;
+  using AutoOffWheel = TimerWheel<MAX_AUTO_OFF>;
+
+  /// Re-arms a sensor's auto-off timer on every frame of its code,
+  /// repeats included (routed from frame_router_)
+  struct AutoOff : public IBinaryPublisher {
+    esphome::binary_sensor::BinarySensor* sensor{nullptr};
+    uint32_t timeout_ms{0};
+    AutoOffWheel* wheel{nullptr};
+    uint16_t id{0};
+
+    void publish(bool) override { wheel->arm(id, timeout_ms); }
+  };
+
+  void add_auto_off(esphome::binary_sensor::BinarySensor* sensor, uint32_t code,
+                    uint8_t protocol, uint32_t timeout_ms) {
+    if (auto_off_count_ >= MAX_AUTO_OFF) {
+      return;
+    }
+    AutoOff& entry = auto_offs_[auto_off_count_];
+    entry.sensor = sensor;
+    entry.timeout_ms = timeout_ms;
+    entry.wheel = &auto_off_wheel_;
+    entry.id = static_cast<uint16_t>(auto_off_count_++);
+    frame_router_.add(code, protocol, &entry);
+  }
+
+  /// A gesture button's sensors, indexed by Gesture
+  struct GestureSensors : public IGestureHandler {
+    uint32_t code{0};
+    uint8_t protocol{0};
+    esphome::binary_sensor::BinarySensor* sensors[3]{};
+
+    void on_gesture(uint32_t, Gesture gesture) override {
+      esphome::binary_sensor::BinarySensor* sensor = sensors[static_cast<size_t>(gesture)];
+      if (sensor != nullptr) {
+        sensor->publish_state(true);
+        sensor->publish_state(false);
+      }
+    }
+  };
+
+  /// Decoder handed to drain() while learning: feeds the learner as
+  /// well as stream_decoder_
+  struct LearningDecoder {
+    ExampleBridgeComponent* bridge;
+
+    bool feed(uint16_t duration_us, DecodedMessage& out) {
+      bridge->learner_.feed(duration_us);
+      return bridge->stream_decoder_.feed(duration_us, out);
+    }
+
+    bool flush(DecodedMessage& out) { return bridge->stream_decoder_.flush(out); }
+  };
+
+  /// Flush whatever the filter and decoder still hold
+  size_t flush_receiver() {
+    return receiver_->flush(pulse_filter_, stream_decoder_);
+  }
+
+  /// Loosen the pulse filter so frames with timing pass it whole
+  /// @return true if the filter config changed
+  bool admit_to_filter(const RF433Codec::TimingConfig& timing) {
+    uint8_t units[] = {timing.sync_high_pulses, timing.zero_high_pulses,
+                       timing.zero_low_pulses, timing.one_high_pulses,
+                       timing.one_low_pulses};
+    uint8_t shortest = units[0];
+    for (uint8_t u : units) {
+      shortest = u < shortest ? u : shortest;
+    }
+    return filter_config_.admit(timing.min_width_us(shortest),
+                                timing.min_width_us(timing.sync_low_pulses));
+  }
+
+  void finish_learning() {
+    learning_ = false;
+    RF433Codec::TimingConfig config;
+    if (!learner_.result(config)) {
+      ESP_LOGW(BRIDGE_TAG, "Learning found no usable timing (%u frames)",
+               static_cast<unsigned>(learner_.get_frame_count()));
+      return;
+    }
+
+    size_t count = stream_decoder_.profile_count();
+    size_t slot = count < MAX_LEARNED_PROFILES ? count
+                                               : next_profile_++ % MAX_LEARNED_PROFILES;
+    stream_decoder_.set_profile(slot, config);
+    if (admit_to_filter(config)) {
+      pulse_filter_.set_config(filter_config_);
+      ESP_LOGI(BRIDGE_TAG, "Pulse filter loosened for learned timing: glitch %u us, sync gap %u us",
+               static_cast<unsigned>(filter_config_.glitch_us),
+               static_cast<unsigned>(filter_config_.min_sync_gap_us));
+    }
+    ESP_LOGI(BRIDGE_TAG,
+             "Learned timing from %u frames: pulse_length %u us, tolerance %u%%, "
+             "sync %u:%u, zero %u:%u, one %u:%u",
+             static_cast<unsigned>(learner_.get_frame_count()),
+             static_cast<unsigned>(config.pulse_length_us),
+             static_cast<unsigned>(config.tolerance_percent),
+             static_cast<unsigned>(config.sync_high_pulses),
+             static_cast<unsigned>(config.sync_low_pulses),
+             static_cast<unsigned>(config.zero_high_pulses),
+             static_cast<unsigned>(config.zero_low_pulses),
+             static_cast<unsigned>(config.one_high_pulses),
+             static_cast<unsigned>(config.one_low_pulses));
+  }
+
+  void publish_stats() {
+    RF433DecodeStats stats = decode_stats();
+    float values[static_cast<size_t>(BridgeStat::COUNT)] = {
+        static_cast<float>(stats.seen),
+        static_cast<float>(stats.accepted),
+        static_cast<float>(stats.rejected_count(RF433RejectReason::LENGTH)),
+        static_cast<float>(stats.rejected_count(RF433RejectReason::SYNC)),
+        static_cast<float>(stats.rejected_count(RF433RejectReason::BITS)),
+        stats.mean_error_percent(),
+        static_cast<float>(pulse_filter_.get_removed_count()),
+        static_cast<float>(repeat_filter_.get_suppressed_count()),
+    };
+    for (size_t i = 0; i < static_cast<size_t>(BridgeStat::COUNT); ++i) {
+      if (stat_sensors_[i] != nullptr) {
+        stat_sensors_[i]->publish_state(values[i]);
+      }
+    }
+  }
+
   esphome::binary_sensor::BinarySensor* motion_sensor_{nullptr};
-  uint16_t pulse_length_{350};
-  uint8_t tolerance_{25};
   uint32_t motion_code_{0};
 
   std::unique_ptr<RF433Codec> codec_;
+  RF433ProfileDecoder<typename Codec::StreamDecoder, MAX_LEARNED_PROFILES> stream_decoder_;
+  PulseFilter::Config filter_config_;
+  PulseFilter pulse_filter_;
   std::unique_ptr<ESPHomeBinaryAdapter> motion_adapter_;
   std::unique_ptr<RF433Receiver> receiver_;
+  FixedCodeRouter<MaxRoutes> router_;
+  std::unique_ptr<ESPHomeBinaryAdapter> route_adapters_[MaxRoutes];
+  size_t route_count_{0};
+  uint32_t motion_auto_off_ms_{0};
+  FixedCodeRouter<MAX_AUTO_OFF> frame_router_;
+  AutoOff auto_offs_[MAX_AUTO_OFF];
+  size_t auto_off_count_{0};
+  AutoOffWheel auto_off_wheel_;
+  FixedGestureDetector<MAX_GESTURE_CODES> gesture_detector_;
+  GestureSensors gesture_buttons_[MAX_GESTURE_CODES];
+  size_t gesture_button_count_{0};
+  IPayloadDecoder* payload_decoders_[RF433Receiver::MAX_PAYLOAD_DECODERS]{};
+  size_t payload_decoder_count_{0};
+  RepeatFilter::Config repeat_config_;
+  RepeatFilter repeat_filter_;
+
+  esphome::sensor::Sensor* stat_sensors_[static_cast<size_t>(BridgeStat::COUNT)]{};
+  uint32_t last_stats_publish_{0};
+  bool timing_stats_{false};
+
+  RFPulseRing pulse_ring_;
+  uint32_t reported_overflows_{0};
+  uint32_t last_edge_millis_{0};
+  bool rx_flush_pending_{false};
+
+  IPulseTransmitter* transmitter_{nullptr};
+  std::unique_ptr<IPulseTransmitter> transmitter_adapter_;
+#ifdef HOME_ESP_USE_RMT_TRANSMITTER
+  int transmit_pin_{-1};
+#endif
+  TransmitQueue<>::Config tx_config_;
+  std::unique_ptr<TransmitQueue<>> tx_queue_;
+  uint8_t transmit_repeats_{4};
+
+  TimingLearner learner_;
+  bool learning_{false};
+  uint32_t learning_started_{0};
+  uint32_t learning_duration_ms_{0};
+  size_t next_profile_{0};
 };
 
 }  // namespace home_esp
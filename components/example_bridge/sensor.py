@@ -0,0 +1,67 @@
+"""ESPHome Example Bridge diagnostic sensor platform."""
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_PERCENT,
+)
+
+from . import CONF_EXAMPLE_BRIDGE_ID, ExampleBridgeComponent, home_esp_ns
+
+DEPENDENCIES = ["example_bridge"]
+
+BridgeStat = home_esp_ns.enum("BridgeStat", is_class=True)
+
+CONF_FRAMES_SEEN = "frames_seen"
+CONF_FRAMES_ACCEPTED = "frames_accepted"
+CONF_REJECTED_LENGTH = "rejected_length"
+CONF_REJECTED_SYNC = "rejected_sync"
+CONF_REJECTED_BITS = "rejected_bits"
+CONF_PULSE_ERROR = "pulse_error"
+CONF_NOISE_EDGES = "noise_edges"
+CONF_REPEATS_SUPPRESSED = "repeats_suppressed"
+
+# Counter keys and the C++ BridgeStat each one publishes
+COUNTERS = {
+    CONF_FRAMES_SEEN: BridgeStat.FRAMES_SEEN,
+    CONF_FRAMES_ACCEPTED: BridgeStat.FRAMES_ACCEPTED,
+    CONF_REJECTED_LENGTH: BridgeStat.REJECTED_LENGTH,
+    CONF_REJECTED_SYNC: BridgeStat.REJECTED_SYNC,
+    CONF_REJECTED_BITS: BridgeStat.REJECTED_BITS,
+    CONF_NOISE_EDGES: BridgeStat.NOISE_EDGES,
+    CONF_REPEATS_SUPPRESSED: BridgeStat.REPEATS_SUPPRESSED,
+}
+
+counter_schema = sensor.sensor_schema(
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+# Configuration schema: every statistic is optional, published once a minute
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_EXAMPLE_BRIDGE_ID): cv.use_id(ExampleBridgeComponent),
+        **{cv.Optional(key): counter_schema for key in COUNTERS},
+        cv.Optional(CONF_PULSE_ERROR): sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+
+async def to_code(config):
+    """Generate C++ code for the diagnostic sensors."""
+    parent = await cg.get_variable(config[CONF_EXAMPLE_BRIDGE_ID])
+    stats = dict(COUNTERS, **{CONF_PULSE_ERROR: BridgeStat.PULSE_ERROR})
+    for key, stat in stats.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(parent.set_stat_sensor(stat, sens))
@@ -20,6 +20,11 @@ ExampleSensorComponent = home_esp_ns.class_(
 CONF_OFFSET = "offset"
 CONF_MIN_TEMP = "min_temperature"
 CONF_MAX_TEMP = "max_temperature"
+CONF_OVERSAMPLING = "oversampling"
+CONF_MAINS_FREQUENCY = "mains_frequency"
+CONF_DEADBAND = "deadband"
+CONF_HEARTBEAT = "heartbeat"
+CONF_RESTORE_ACROSS_SLEEP = "restore_across_sleep"
 
 # Configuration schema
 CONFIG_SCHEMA = cv.Schema(
@@ -28,6 +33,18 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_OFFSET, default=0.0): cv.float_,
         cv.Optional(CONF_MIN_TEMP, default=-40.0): cv.float_,
         cv.Optional(CONF_MAX_TEMP, default=85.0): cv.float_,
+        # ADC samples averaged per update; 4^n samples gain n bits
+        cv.Optional(CONF_OVERSAMPLING, default=1): cv.one_of(
+            1, 2, 4, 8, 16, 32, 64, int=True
+        ),
+        # Spread each burst over one mains cycle to cancel hum
+        cv.Optional(CONF_MAINS_FREQUENCY): cv.one_of(50, 60, int=True),
+        # Skip publishes until the reported value moves this far (Celsius)
+        cv.Optional(CONF_DEADBAND): cv.float_range(min=0.0),
+        # Publish at least this often, even when unchanged
+        cv.Optional(CONF_HEARTBEAT): cv.positive_time_period_milliseconds,
+        # Keep deadband/heartbeat state in RTC memory over deep sleep
+        cv.Optional(CONF_RESTORE_ACROSS_SLEEP): cv.All(cv.boolean, cv.only_on_esp32),
     }
 ).extend(cv.polling_component_schema("60s"))
 
@@ -40,6 +57,15 @@ async def to_code(config):
     cg.add(var.set_offset(config[CONF_OFFSET]))
     cg.add(var.set_min_temperature(config[CONF_MIN_TEMP]))
     cg.add(var.set_max_temperature(config[CONF_MAX_TEMP]))
+    cg.add(var.set_oversampling(config[CONF_OVERSAMPLING]))
+    if CONF_MAINS_FREQUENCY in config:
+        cg.add(var.set_mains_frequency(config[CONF_MAINS_FREQUENCY]))
+    if CONF_DEADBAND in config:
+        cg.add(var.set_deadband(config[CONF_DEADBAND]))
+    if CONF_HEARTBEAT in config:
+        cg.add(var.set_heartbeat(config[CONF_HEARTBEAT]))
+    if CONF_RESTORE_ACROSS_SLEEP in config:
+        cg.add(var.set_restore_across_sleep(config[CONF_RESTORE_ACROSS_SLEEP]))
 
     # Add include paths for lib/ headers (core/* includes) and lib/core/ headers (interfaces/* includes)
     lib_path = os.path.abspath(
@@ -3,8 +3,17 @@
 
 #include "example_sensor.h"
 
+#ifdef USE_ESP32
+#include <esp_attr.h>
+#endif
+
 namespace home_esp {
 
+#ifdef USE_ESP32
+// Loaded from the image on every boot, left alone on a deep sleep wake
+RTC_DATA_ATTR RtcPublishState rtc_publish_state;
+#endif
+
 // Component implementation is fully in the header for this simple example.
 // For more complex components, implement methods here.
 
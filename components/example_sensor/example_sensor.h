@@ -4,20 +4,43 @@
 // ESPHome component that wraps TemperatureReader business logic
 
 #include "esphome/core/component.h"
+#include "esphome/core/hal.h"
 #include "esphome/components/sensor/sensor.h"
 
 // Include our abstracted business logic
+#include "core/oversampler.h"
+#include "core/publish_policy.h"
 #include "core/temperature_reader.h"
 #include "core/adapters/esphome_sensor_adapter.h"
 
 #include <memory>
 
+#ifdef USE_ESP32
+#include <sys/time.h>
+#endif
+
 namespace home_esp {
 
 static const char* const TAG = "example_sensor";
 
+#ifdef USE_ESP32
+/// Publish policy state kept in RTC memory over deep sleep
+/// (defined in example_sensor.cpp)
+struct RtcPublishState {
+  static constexpr uint32_t MAGIC = 0x50424C53;  // "PBLS"
+
+  uint32_t magic;
+  int8_t accuracy_decimals;
+  PublishPolicy::Snapshot snapshot;
+};
+extern RtcPublishState rtc_publish_state;
+#endif
+
 class ExampleSensorComponent : public esphome::PollingComponent {
  public:
+  /// Most ADC samples averaged per published value
+  static constexpr size_t MAX_OVERSAMPLING = 64;
+
   ExampleSensorComponent() = default;
 
   // ESPHome configuration setters
@@ -25,6 +48,19 @@ class ExampleSensorComponent : public esphome::PollingComponent {
   void set_offset(float offset) { offset_ = offset; }
   void set_min_temperature(float min_temp) { min_temp_ = min_temp; }
   void set_max_temperature(float max_temp) { max_temp_ = max_temp; }
+  void set_oversampling(uint16_t samples) { oversampling_.samples = samples; }
+  void set_mains_frequency(uint8_t hz) { oversampling_.mains_hz = hz; }
+  void set_deadband(float deadband) {
+    publish_config_.deadband = deadband;
+    use_publish_policy_ = true;
+  }
+  void set_heartbeat(uint32_t heartbeat_ms) {
+    publish_config_.heartbeat_ms = heartbeat_ms;
+    use_publish_policy_ = true;
+  }
+  /// Keep the last publish over deep sleep (ESP32), so deadband and
+  /// heartbeat span wakes instead of each wake publishing as the first
+  void set_restore_across_sleep(bool restore) { restore_across_sleep_ = restore; }
 
   void setup() override {
     ESP_LOGCONFIG(TAG, "Setting up Example Sensor...");
@@ -33,26 +69,86 @@ class ExampleSensorComponent : public esphome::PollingComponent {
     adapter_ = std::make_unique<ESPHomeSensorAdapter>(sensor_);
 
     // Configure and create the business logic
-    TemperatureReader::Config config;
+    PlatformTemperatureReader::Config config;
     config.offset = offset_;
     config.min_valid_temp = min_temp_;
     config.max_valid_temp = max_temp_;
 
-    reader_ = std::make_unique<TemperatureReader>(adapter_.get(), config);
+    if (!oversampler_.set_config(oversampling_)) {
+      ESP_LOGE(TAG, "Oversampling must be a power of two up to %u",
+               static_cast<unsigned>(MAX_OVERSAMPLING));
+      mark_failed();
+      return;
+    }
+    // Averaged readings carry extra bits: widen the ADC full scale to match
+    config.adc_resolution =
+        static_cast<uint16_t>(oversampler_.output_resolution(config.adc_resolution));
+
+    reader_ = std::make_unique<PlatformTemperatureReader>(adapter_.get(), config);
+
+    if (use_publish_policy_) {
+      // Compare readings as the entity will report them
+      if (sensor_ != nullptr) {
+        publish_config_.accuracy_decimals = sensor_->get_accuracy_decimals();
+      }
+      publish_policy_.set_config(publish_config_);
+      reader_->set_publish_policy(&publish_policy_);
+#ifdef USE_ESP32
+      if (restore_across_sleep_ && rtc_publish_state.magic == RtcPublishState::MAGIC &&
+          rtc_publish_state.accuracy_decimals == publish_config_.accuracy_decimals) {
+        publish_policy_.restore(rtc_publish_state.snapshot);
+      }
+#endif
+    }
   }
 
   void update() override {
-    // In a real component, this would read from actual hardware (ADC, I2C, etc.)
-    // For this example, we simulate a reading
-    uint16_t raw_adc = read_adc_value();
+    publish_policy_.update(policy_millis());
 
-    reader_->process_raw_reading(raw_adc);
+    // In a real component, this would read from actual hardware (ADC, I2C, etc.)
+    // For this example, we simulate a reading. A burst of samples, spread
+    // over one mains cycle when configured, decimates to one value.
+    uint32_t interval_us = oversampler_.sample_interval_us();
+    for (uint16_t i = 0; i < oversampling_.samples; ++i) {
+      if (i > 0 && interval_us > 0) {
+        esphome::delayMicroseconds(interval_us);
+      }
+      if (oversampler_.add(read_adc_value())) {
+        reader_->process_raw_reading(oversampler_.value());
+      }
+    }
+
+#ifdef USE_ESP32
+    if (use_publish_policy_ && restore_across_sleep_) {
+      rtc_publish_state.magic = RtcPublishState::MAGIC;
+      rtc_publish_state.accuracy_decimals = publish_config_.accuracy_decimals;
+      rtc_publish_state.snapshot = publish_policy_.snapshot();
+    }
+#endif
   }
 
   void dump_config() override {
     ESP_LOGCONFIG(TAG, "Example Sensor:");
     ESP_LOGCONFIG(TAG, "  Offset: %.1f°C", offset_);
     ESP_LOGCONFIG(TAG, "  Valid range: %.1f°C to %.1f°C", min_temp_, max_temp_);
+    ESP_LOGCONFIG(TAG, "  Oversampling: %u samples (+%u bits)",
+                  static_cast<unsigned>(oversampling_.samples),
+                  static_cast<unsigned>(oversampler_.extra_bits()));
+    if (oversampling_.mains_hz > 0) {
+      ESP_LOGCONFIG(TAG, "  Mains rejection: %u Hz, %u us between samples",
+                    static_cast<unsigned>(oversampling_.mains_hz),
+                    static_cast<unsigned>(oversampler_.sample_interval_us()));
+    }
+    if (use_publish_policy_) {
+      ESP_LOGCONFIG(TAG, "  Deadband: %.2f°C at %d decimals", publish_config_.deadband,
+                    publish_config_.accuracy_decimals);
+      ESP_LOGCONFIG(TAG, "  Heartbeat: %u ms",
+                    static_cast<unsigned>(publish_config_.heartbeat_ms));
+      ESP_LOGCONFIG(TAG, "  Restore across sleep: %s",
+                    restore_across_sleep_ ? "yes" : "no");
+      ESP_LOGCONFIG(TAG, "  Suppressed publishes: %u",
+                    static_cast<unsigned>(publish_policy_.get_suppressed_count()));
+    }
     LOG_SENSOR("  ", "Temperature", sensor_);
   }
 
@@ -69,13 +165,41 @@ class ExampleSensorComponent : public esphome::PollingComponent {
   }
 
  private:
+  /// Clock for the publish policy. millis() restarts on every wake, so
+  /// state restored over deep sleep is timed on the system clock, which
+  /// the RTC keeps running (an SNTP step moves one heartbeat at most).
+  uint32_t policy_millis() const {
+#ifdef USE_ESP32
+    if (restore_across_sleep_) {
+      struct timeval now;
+      gettimeofday(&now, nullptr);
+      return static_cast<uint32_t>(static_cast<uint64_t>(now.tv_sec) * 1000u +
+                                   now.tv_usec / 1000);
+    }
+#endif
+    return esphome::millis();
+  }
+
+  /// Default: one sample per update, as without oversampling
+  static Oversampler<MAX_OVERSAMPLING>::Config single_sample() {
+    Oversampler<MAX_OVERSAMPLING>::Config config;
+    config.samples = 1;
+    return config;
+  }
+
   esphome::sensor::Sensor* sensor_{nullptr};
   float offset_{0.0f};
   float min_temp_{-40.0f};
   float max_temp_{85.0f};
+  Oversampler<MAX_OVERSAMPLING>::Config oversampling_{single_sample()};
+  Oversampler<MAX_OVERSAMPLING> oversampler_;
+  PublishPolicy::Config publish_config_;
+  PublishPolicy publish_policy_;
+  bool use_publish_policy_{false};
+  bool restore_across_sleep_{false};
 
   std::unique_ptr<ESPHomeSensorAdapter> adapter_;
-  std::unique_ptr<TemperatureReader> reader_;
+  std::unique_ptr<PlatformTemperatureReader> reader_;
 };
 
 }  // namespace home_esp
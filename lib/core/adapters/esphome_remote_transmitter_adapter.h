@@ -0,0 +1,48 @@
+#pragma once
+
+// ESPHomeRemoteTransmitterAdapter
+// Bridges IPulseTransmitter interface to ESPHome's remote_transmitter
+
+#ifdef UNIT_TEST
+#include "esphome.h"
+#else
+#include "esphome/components/remote_transmitter/remote_transmitter.h"
+#endif
+
+#include "interfaces/i_pulse_transmitter.h"
+
+namespace home_esp {
+
+/// remote_transmitter's perform() returns once the RMT has sent every
+/// repeat, so is_busy() is always false and loop() stalls for the whole
+/// call. Run its TransmitQueue with burst_repeats = 1 so each update()
+/// blocks for one frame; on ESP32 prefer RmtTransmitterAdapter, which
+/// returns at once.
+class ESPHomeRemoteTransmitterAdapter : public IPulseTransmitter {
+ public:
+  explicit ESPHomeRemoteTransmitterAdapter(
+      esphome::remote_transmitter::RemoteTransmitterComponent* transmitter)
+      : transmitter_(transmitter) {}
+
+  bool transmit(const DecodedMessage&, PulseSpan frame, uint8_t repeats) override {
+    if (transmitter_ == nullptr) {
+      return false;
+    }
+    auto call = transmitter_->transmit();
+    auto* data = call.get_data();
+    data->reserve(frame.size());
+    for (size_t i = 0; i + 1 < frame.size(); i += 2) {
+      data->item(frame[i], frame[i + 1]);
+    }
+    call.set_send_times(repeats);
+    call.perform();
+    return true;
+  }
+
+  bool is_busy() const override { return false; }
+
+ private:
+  esphome::remote_transmitter::RemoteTransmitterComponent* transmitter_;
+};
+
+}  // namespace home_esp
@@ -0,0 +1,120 @@
+#pragma once
+
+// RmtTransmitterAdapter
+// Bridges IPulseTransmitter interface to the ESP-IDF 5 RMT TX driver
+
+#include "driver/rmt_tx.h"
+
+#include "interfaces/i_pulse_transmitter.h"
+#include "rmt_waveform.h"
+
+namespace home_esp {
+
+/// Sends RF433Codec frames from an RMT channel without blocking.
+///
+/// Waveforms come from an RmtWaveformCache, so a repeated command hands
+/// the items built for its first send straight to rmt_transmit(). The
+/// call returns once the transfer is queued; is_busy() polls the channel
+/// with a zero timeout. The copy encoder reads the cache slot while the
+/// frame goes out, so transmit() refuses while busy - the slot is never
+/// evicted mid-transfer.
+class RmtTransmitterAdapter : public IPulseTransmitter {
+ public:
+  /// @param gpio Output pin of the transmitter's data line
+  /// @param timing Codec timing the cached waveforms are built with
+  RmtTransmitterAdapter(int gpio, const RF433Codec::TimingConfig& timing)
+      : gpio_(gpio), cache_(RmtWaveformEncoder(timing, encoder_config())) {}
+
+  ~RmtTransmitterAdapter() override { end(); }
+
+  RmtTransmitterAdapter(const RmtTransmitterAdapter&) = delete;
+  RmtTransmitterAdapter& operator=(const RmtTransmitterAdapter&) = delete;
+
+  /// Claim and enable the RMT channel
+  /// @return false if the timing does not fit RMT items or the driver
+  ///         has no channel to give
+  bool begin() {
+    if (channel_ != nullptr) {
+      return true;
+    }
+    if (!cache_.encoder().is_valid()) {
+      return false;
+    }
+
+    rmt_tx_channel_config_t config = {};
+    config.gpio_num = static_cast<gpio_num_t>(gpio_);
+    config.clk_src = RMT_CLK_SRC_DEFAULT;
+    config.resolution_hz = RESOLUTION_HZ;
+#ifdef SOC_RMT_MEM_WORDS_PER_CHANNEL
+    config.mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+#else
+    config.mem_block_symbols = 64;
+#endif
+    config.trans_queue_depth = 1;
+    if (rmt_new_tx_channel(&config, &channel_) != ESP_OK) {
+      channel_ = nullptr;
+      return false;
+    }
+
+    rmt_copy_encoder_config_t encoder_config = {};
+    if (rmt_new_copy_encoder(&encoder_config, &encoder_) != ESP_OK ||
+        rmt_enable(channel_) != ESP_OK) {
+      end();
+      return false;
+    }
+    return true;
+  }
+
+  /// Wait for any frame in flight, then release the channel
+  void end() {
+    if (channel_ != nullptr) {
+      rmt_tx_wait_all_done(channel_, -1);
+      rmt_disable(channel_);
+      rmt_del_channel(channel_);
+      channel_ = nullptr;
+    }
+    if (encoder_ != nullptr) {
+      rmt_del_encoder(encoder_);
+      encoder_ = nullptr;
+    }
+  }
+
+  /// Queue msg's cached waveform on the channel and return.
+  /// frame is not used: the cache encodes msg with the same timing.
+  bool transmit(const DecodedMessage& msg, PulseSpan, uint8_t repeats) override {
+    if (channel_ == nullptr || is_busy()) {
+      return false;
+    }
+    size_t count = 0;
+    const RmtItem* items = cache_.get(msg, repeats, count);
+    if (items == nullptr) {
+      return false;
+    }
+    rmt_transmit_config_t config = {};
+    config.loop_count = 0;
+    return rmt_transmit(channel_, encoder_, items, count * sizeof(RmtItem), &config) == ESP_OK;
+  }
+
+  bool is_busy() const override {
+    return channel_ != nullptr && rmt_tx_wait_all_done(channel_, 0) == ESP_ERR_TIMEOUT;
+  }
+
+  const RmtWaveformCache<>& cache() const { return cache_; }
+
+ private:
+  static constexpr uint32_t RESOLUTION_HZ = 1000000;  // One tick per microsecond
+
+  static RmtWaveformEncoder::Config encoder_config() {
+    RmtWaveformEncoder::Config config;
+    config.ticks_per_us = RESOLUTION_HZ / 1000000;
+    config.end_marker = false;  // rmt_transmit() ends on the byte count
+    return config;
+  }
+
+  int gpio_;
+  RmtWaveformCache<> cache_;
+  rmt_channel_handle_t channel_{nullptr};
+  rmt_encoder_handle_t encoder_{nullptr};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,143 @@
+#pragma once
+
+// BitstreamDecoder - RF433 decoding from timer-sampled GPIO bitstreams
+// Pure C++ with no ESPHome dependencies
+// For boards that sample the RF pin into packed words instead of edge IRQs
+
+#include "rf433_codec.h"
+#include "rf433_stream_decoder.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Decodes RF frames from a packed bitstream of pin samples.
+///
+/// Each uint32_t holds 32 consecutive samples, the earliest in bit 31.
+/// Pulse widths come from run lengths: the bits where the level changes
+/// are found with one XOR, count-leading-zeros walks them, and a word
+/// with no change (the common case: idle or inside a long pulse) costs a
+/// single compare. The widths go to a streaming decoder, so frames are
+/// classified exactly as RF433Codec would.
+///
+/// Superregenerative receivers chatter during idle and long lows. A word
+/// with more than max_word_edges changes (counted with popcount) cannot
+/// hold real pulses at the configured rate, so its edges are ignored and
+/// it extends the run in progress.
+///
+/// @tparam Decoder Any type with `bool feed(uint16_t, DecodedMessage&)`,
+///         e.g. RF433StreamDecoder, RF433LutStreamDecoder or a decoder bank
+template <typename Decoder = RF433StreamDecoder>
+class BitstreamDecoder {
+ public:
+  /// Configuration for sampling
+  struct Config {
+    uint32_t sample_rate_hz;     // Timer sampling rate
+    uint8_t max_word_edges;      // More changes per word = noise
+    bool idle_high;              // Receiver output is high when idle
+
+    // 4 edges per 32 samples at 50 kHz allows pulses down to ~160us
+    Config()
+        : sample_rate_hz(50000),
+          max_word_edges(4),
+          idle_high(false) {}
+  };
+
+  explicit BitstreamDecoder(Config config = Config(), Decoder decoder = Decoder())
+      : config_(config),
+        decoder_(decoder),
+        us_per_sample_q16_((uint64_t{1000000} << 16) / config.sample_rate_hz),
+        max_run_samples_(static_cast<uint32_t>(
+            (uint64_t{UINT16_MAX} << 16) / us_per_sample_q16_ + 1)) {}
+
+  /// Decode count words of samples.
+  /// @param on_frame Called as on_frame(const DecodedMessage&) per frame
+  /// @return Number of frames decoded
+  template <typename Handler>
+  size_t feed(const uint32_t* words, size_t count, Handler&& on_frame) {
+    size_t frames = 0;
+    const uint32_t invert = config_.idle_high ? ~0u : 0u;
+
+    for (size_t i = 0; i < count; ++i) {
+      uint32_t word = words[i] ^ invert;
+      uint32_t steady = level_ ? ~0u : 0u;
+      if (word == steady) {
+        extend(32);
+        continue;
+      }
+
+      // Bit k is set where sample k differs from the sample before it
+      uint32_t changes = word ^ ((word >> 1) | (steady << 31));
+      if (__builtin_popcount(changes) > config_.max_word_edges) {
+        noise_words_++;
+        extend(32);
+        continue;
+      }
+
+      uint32_t consumed = 0;
+      while (changes != 0) {
+        uint32_t pos = __builtin_clz(changes);
+        extend(pos - consumed);
+        consumed = pos;
+        changes &= ~(0x80000000u >> pos);
+        frames += edge(on_frame);
+      }
+      extend(32 - consumed);
+    }
+    return frames;
+  }
+
+  /// Drop the run in progress and any partial frame
+  void reset() {
+    run_samples_ = 0;
+    level_ = false;
+    started_ = false;
+    decoder_.reset();
+  }
+
+  /// Words skipped as receiver noise
+  uint32_t get_noise_word_count() const { return noise_words_; }
+
+  Decoder& decoder() { return decoder_; }
+  const Config& get_config() const { return config_; }
+
+ private:
+  void extend(uint32_t samples) {
+    run_samples_ += samples;
+    if (run_samples_ > max_run_samples_) {
+      run_samples_ = max_run_samples_;  // Saturates at 65535us anyway
+    }
+  }
+
+  /// Level changed: the run that just ended is one pulse width
+  template <typename Handler>
+  size_t edge(Handler& on_frame) {
+    level_ = !level_;
+    if (!started_) {
+      // Widths start with a high, so skip the idle before the first rise
+      started_ = level_;
+      run_samples_ = 0;
+      return 0;
+    }
+
+    uint32_t us = static_cast<uint32_t>((uint64_t{run_samples_} * us_per_sample_q16_) >> 16);
+    run_samples_ = 0;
+    DecodedMessage msg;
+    if (!decoder_.feed(us > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(us), msg)) {
+      return 0;
+    }
+    on_frame(static_cast<const DecodedMessage&>(msg));
+    return 1;
+  }
+
+  Config config_;
+  Decoder decoder_;
+  uint32_t us_per_sample_q16_;
+  uint32_t max_run_samples_;
+  uint32_t run_samples_{0};
+  uint32_t noise_words_{0};
+  bool level_{false};       // Level of the last sample seen
+  bool started_{false};     // First rising edge seen
+};
+
+}  // namespace home_esp
@@ -0,0 +1,165 @@
+#pragma once
+
+// CodeRouter - Maps decoded RF codes to the entity that owns them
+// Pure C++ with no ESPHome dependencies
+// Fixed-capacity open-addressing hash table, no heap
+
+#include "interfaces/i_binary_publisher.h"
+#include "interfaces/i_protocol_codec.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Constant-time (code, protocol) -> IBinaryPublisher lookup.
+///
+/// Linear probing over a power-of-two table kept at most half full, so a
+/// lookup is one multiply-shift hash and, typically, one or two probes.
+/// Keys and publishers live in separate arrays: probing only walks the
+/// 8-byte keys, and the publisher pointer is read once on a hit.
+///
+/// A route registered with ANY_PROTOCOL matches its code from any
+/// protocol; an exact (code, protocol) route takes precedence.
+///
+/// This class works over caller-provided storage so RF433Receiver can hold
+/// a router of any size; use FixedCodeRouter<N> to own the storage.
+class CodeRouter {
+ public:
+  /// Protocol id that matches every protocol
+  static constexpr uint8_t ANY_PROTOCOL = 0;
+
+  /// One table slot's key; `used` marks occupied slots
+  struct Key {
+    uint32_t code;
+    uint8_t protocol;
+    uint8_t used;
+  };
+
+  /// @param keys, publishers Arrays of table_size slots
+  /// @param table_size Power of two, at least twice max_routes
+  /// @param max_routes Routes accepted before add() fails
+  CodeRouter(Key* keys, IBinaryPublisher** publishers, size_t table_size,
+             size_t max_routes)
+      : keys_(keys),
+        publishers_(publishers),
+        mask_(table_size - 1),
+        max_routes_(max_routes) {}
+
+  CodeRouter(const CodeRouter&) = delete;
+  CodeRouter& operator=(const CodeRouter&) = delete;
+
+  /// Route a code to a publisher, replacing any existing route for it
+  /// @return false if the table is full
+  bool add(uint32_t code, uint8_t protocol, IBinaryPublisher* publisher) {
+    size_t idx = hash(code, protocol) & mask_;
+    while (keys_[idx].used) {
+      if (keys_[idx].code == code && keys_[idx].protocol == protocol) {
+        publishers_[idx] = publisher;
+        return true;
+      }
+      idx = (idx + 1) & mask_;
+    }
+
+    if (size_ >= max_routes_) {
+      return false;
+    }
+    keys_[idx] = Key{code, protocol, 1};
+    publishers_[idx] = publisher;
+    size_++;
+    if (protocol == ANY_PROTOCOL) {
+      any_protocol_routes_++;
+    }
+    return true;
+  }
+
+  /// Find the publisher for a code
+  /// @return nullptr if the code is not routed
+  IBinaryPublisher* find(uint32_t code, uint8_t protocol) const {
+    IBinaryPublisher* publisher = find_exact(code, protocol);
+    if (publisher == nullptr && any_protocol_routes_ > 0 &&
+        protocol != ANY_PROTOCOL) {
+      publisher = find_exact(code, ANY_PROTOCOL);
+    }
+    return publisher;
+  }
+
+  /// Publish a decoded message to its route
+  /// @return true if the message had a route
+  bool route(const DecodedMessage& msg, bool state = true) const {
+    IBinaryPublisher* publisher = find(msg.code, msg.protocol);
+    if (publisher == nullptr) {
+      return false;
+    }
+    publisher->publish(state);
+    return true;
+  }
+
+  /// Remove every route
+  void clear() {
+    for (size_t i = 0; i <= mask_; ++i) {
+      keys_[i].used = 0;
+    }
+    size_ = 0;
+    any_protocol_routes_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  size_t max_routes() const { return max_routes_; }
+
+ protected:
+  /// Smallest power of two holding max_routes at <= 50% load
+  static constexpr size_t table_size_for(size_t max_routes) {
+    size_t size = 2;
+    while (size < max_routes * 2) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+ private:
+  static uint32_t hash(uint32_t code, uint8_t protocol) {
+    // Fibonacci hashing; the fold mixes high code bits into the low
+    // bits used as the index (remotes often differ only in high bits)
+    uint32_t h = (code ^ (static_cast<uint32_t>(protocol) << 24)) * 0x9E3779B1u;
+    return h ^ (h >> 16);
+  }
+
+  IBinaryPublisher* find_exact(uint32_t code, uint8_t protocol) const {
+    size_t idx = hash(code, protocol) & mask_;
+    while (keys_[idx].used) {
+      if (keys_[idx].code == code && keys_[idx].protocol == protocol) {
+        return publishers_[idx];
+      }
+      idx = (idx + 1) & mask_;
+    }
+    return nullptr;
+  }
+
+  Key* keys_;
+  IBinaryPublisher** publishers_;
+  size_t mask_;
+  size_t max_routes_;
+  size_t size_{0};
+  size_t any_protocol_routes_{0};
+};
+
+/// CodeRouter owning a table sized for MaxRoutes entries.
+///
+/// @tparam MaxRoutes Number of routed codes (e.g. binary sensors in YAML)
+template <size_t MaxRoutes>
+class FixedCodeRouter : public CodeRouter {
+ public:
+  static_assert(MaxRoutes > 0, "FixedCodeRouter needs at least one route");
+
+  static constexpr size_t TABLE_SIZE = table_size_for(MaxRoutes);
+
+  FixedCodeRouter() : CodeRouter(keys_, publishers_, TABLE_SIZE, MaxRoutes) {
+    clear();
+  }
+
+ private:
+  Key keys_[TABLE_SIZE];
+  IBinaryPublisher* publishers_[TABLE_SIZE];
+};
+
+}  // namespace home_esp
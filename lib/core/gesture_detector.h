@@ -0,0 +1,219 @@
+#pragma once
+
+// GestureDetector - Single/double/long press recognition for RF remotes
+// Pure C++ with no ESPHome dependencies
+// Per-code state machines over fixed storage, driven by update(millis)
+
+#include "interfaces/i_gesture_handler.h"
+#include "interfaces/i_protocol_codec.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Turns the frame bursts of registered button codes into gestures.
+///
+/// A remote repeats its code for as long as a button is held, so a press
+/// is a run of frames less than repeat_gap_ms apart; a longer gap is a
+/// release. Per code:
+/// - LONG fires once the press has lasted long_press_ms, while the
+///   button is still held.
+/// - DOUBLE fires as soon as a second press starts within
+///   double_click_ms of the first one's release.
+/// - SINGLE fires when no second press came within double_click_ms, or
+///   on release if double_click_ms is 0 (no doubles, lower latency).
+/// Frames after LONG or DOUBLE are absorbed until the button is released.
+///
+/// Frames must reach feed() unfiltered: RF433Receiver offers them here
+/// before its RepeatFilter, which would otherwise swallow the repeats
+/// that make up a long press.
+///
+/// Timeouts advance in update(), which also sets the clock feed() uses;
+/// call it every loop. Each tracked code costs one Slot (about 20 bytes)
+/// of caller-provided storage; use FixedGestureDetector<N> to own it.
+///
+/// @note Timing uses unsigned 32-bit arithmetic which correctly handles
+///       millis() overflow (~49.7 days).
+class GestureDetector {
+ public:
+  /// Protocol id that matches every protocol
+  static constexpr uint8_t ANY_PROTOCOL = 0;
+
+  /// Configuration for gesture timing
+  struct Config {
+    uint16_t repeat_gap_ms;     // Longer silence ends a press
+    uint16_t double_click_ms;   // Wait for a second press after release (0 = no doubles)
+    uint16_t long_press_ms;     // Hold time for a long press
+
+    Config()
+        : repeat_gap_ms(150),
+          double_click_ms(400),
+          long_press_ms(800) {}
+  };
+
+  /// One tracked code and its press state
+  struct Slot {
+    IGestureHandler* handler;
+    uint32_t code;
+    uint32_t press_start_ms;
+    uint32_t last_frame_ms;
+    uint8_t protocol;
+    uint8_t state;
+  };
+
+  /// @param slots Array of capacity slots
+  GestureDetector(Slot* slots, size_t capacity, Config config = Config())
+      : slots_(slots), capacity_(capacity), config_(config) {}
+
+  GestureDetector(const GestureDetector&) = delete;
+  GestureDetector& operator=(const GestureDetector&) = delete;
+
+  /// Recognise gestures on a code and report them to handler
+  /// @return false if every slot is taken
+  bool add(uint32_t code, uint8_t protocol, IGestureHandler* handler) {
+    if (size_ >= capacity_) {
+      return false;
+    }
+    slots_[size_++] = Slot{handler, code, 0, 0, protocol, IDLE};
+    return true;
+  }
+
+  /// Update timing and fire gestures whose timeouts have passed
+  /// (call this regularly with current millis)
+  void update(uint32_t current_millis) {
+    current_millis_ = current_millis;
+    for (size_t i = 0; i < size_; ++i) {
+      advance(slots_[i]);
+    }
+  }
+
+  /// Offer a decoded frame, timestamped with the last update()
+  /// @return true if the code is tracked here (the frame is consumed)
+  bool feed(const DecodedMessage& msg) {
+    Slot* slot = find(msg.code, msg.protocol);
+    if (slot == nullptr) {
+      return false;
+    }
+    advance(*slot);
+
+    switch (slot->state) {
+      case IDLE:
+        slot->state = PRESSED;
+        slot->press_start_ms = current_millis_;
+        break;
+      case RELEASED:
+        slot->state = ABSORB;
+        emit(*slot, Gesture::DOUBLE);
+        break;
+      default:
+        repeat_count_++;  // Same press, still held
+        break;
+    }
+    slot->last_frame_ms = current_millis_;
+    return true;
+  }
+
+  /// Return every code to idle without firing pending gestures
+  void reset() {
+    for (size_t i = 0; i < size_; ++i) {
+      slots_[i].state = IDLE;
+    }
+  }
+
+  void set_config(const Config& config) { config_ = config; }
+  const Config& get_config() const { return config_; }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  /// Frames recognised as repeats of a press in progress
+  uint32_t get_repeat_count() const { return repeat_count_; }
+
+  /// Gestures fired
+  uint32_t get_gesture_count() const { return gesture_count_; }
+
+ private:
+  enum State : uint8_t {
+    IDLE,
+    PRESSED,    // Held, no gesture yet
+    RELEASED,   // One short press, waiting for a second
+    ABSORB,     // Gesture fired; ignore frames until release
+  };
+
+  Slot* find(uint32_t code, uint8_t protocol) {
+    for (size_t i = 0; i < size_; ++i) {
+      Slot& slot = slots_[i];
+      if (slot.code == code &&
+          (slot.protocol == protocol || slot.protocol == ANY_PROTOCOL)) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  void advance(Slot& slot) {
+    uint32_t silent_ms = current_millis_ - slot.last_frame_ms;
+    bool released = silent_ms > config_.repeat_gap_ms;
+
+    switch (slot.state) {
+      case PRESSED:
+        if (released) {
+          // Judge by the last frame, in case update() ran late
+          if (slot.last_frame_ms - slot.press_start_ms >= config_.long_press_ms) {
+            slot.state = IDLE;
+            emit(slot, Gesture::LONG);
+            return;
+          }
+          slot.state = RELEASED;
+          break;  // Check the double-click window below
+        }
+        if (current_millis_ - slot.press_start_ms >= config_.long_press_ms) {
+          slot.state = ABSORB;
+          emit(slot, Gesture::LONG);
+        }
+        return;
+      case ABSORB:
+        if (released) {
+          slot.state = IDLE;
+        }
+        return;
+      case RELEASED:
+        break;
+      default:
+        return;
+    }
+
+    if (silent_ms >= uint32_t{config_.repeat_gap_ms} + config_.double_click_ms) {
+      slot.state = IDLE;
+      emit(slot, Gesture::SINGLE);
+    }
+  }
+
+  void emit(const Slot& slot, Gesture gesture) {
+    gesture_count_++;
+    if (slot.handler != nullptr) {
+      slot.handler->on_gesture(slot.code, gesture);
+    }
+  }
+
+  Slot* slots_;
+  size_t capacity_;
+  size_t size_{0};
+  Config config_;
+  uint32_t current_millis_{0};
+  uint32_t repeat_count_{0};
+  uint32_t gesture_count_{0};
+};
+
+/// GestureDetector that owns storage for MaxCodes codes
+template <size_t MaxCodes>
+class FixedGestureDetector : public GestureDetector {
+ public:
+  explicit FixedGestureDetector(Config config = Config())
+      : GestureDetector(storage_, MaxCodes, config) {}
+
+ private:
+  Slot storage_[MaxCodes]{};
+};
+
+}  // namespace home_esp
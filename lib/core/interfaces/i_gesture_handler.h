@@ -0,0 +1,26 @@
+#pragma once
+
+// IGestureHandler Interface
+// Receives button gestures recognised from RF remote presses
+// Allows business logic to be tested without ESPHome dependencies
+
+#include <cstdint>
+
+namespace home_esp {
+
+/// Click patterns recognised on a remote button
+enum class Gesture : uint8_t {
+  SINGLE,  // One short press, no second press followed
+  DOUBLE,  // Two presses in quick succession
+  LONG,    // Held past the long-press time
+};
+
+class IGestureHandler {
+ public:
+  virtual ~IGestureHandler() = default;
+
+  /// Handle a gesture on the button that sends code
+  virtual void on_gesture(uint32_t code, Gesture gesture) = 0;
+};
+
+}  // namespace home_esp
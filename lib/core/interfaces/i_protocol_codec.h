@@ -4,6 +4,7 @@
 // Abstraction for encoding/decoding protocol messages (RF433, IR, etc.)
 // Allows business logic to be tested without ESPHome dependencies
 
+#include "pulse_span.h"
 #include <cstddef>
 #include <cstdint>
 
@@ -23,7 +24,7 @@ class IProtocolCodec {
   virtual ~IProtocolCodec() = default;
 
   /// Decode raw data into a message
-  /// @param data Raw input data (timing pulses, bytes, etc.)
+  /// @param data Raw input data (timing pulses as little-endian uint16_t, etc.)
   /// @param len Length of input data
   /// @param out Output decoded message
   /// @return true if decoding succeeded
@@ -36,6 +37,26 @@ class IProtocolCodec {
   /// @return true if encoding succeeded
   virtual bool encode(const DecodedMessage& msg, uint8_t* out, size_t& len) = 0;
 
+  /// Decode pulse durations in place (ring segment, capture, RMT buffer)
+  /// @param pulses [high_us, low_us, ...] durations
+  /// @param out Output decoded message
+  /// @return true if decoding succeeded
+  virtual bool decode(PulseSpan pulses, DecodedMessage& out) = 0;
+
+  /// Decode 32-bit pulse durations in place
+  virtual bool decode(PulseSpan32 pulses, DecodedMessage& out) = 0;
+
+  /// Encode a message as pulse durations
+  /// @param msg Message to encode
+  /// @param out Caller-owned duration buffer
+  /// @param count Output: durations written
+  /// @return true if encoding succeeded (false if out is too small)
+  virtual bool encode(const DecodedMessage& msg, MutablePulseSpan out, size_t& count) = 0;
+
+  /// Encode a message as 32-bit pulse durations, for buffers whose
+  /// durations can exceed 65535us
+  virtual bool encode(const DecodedMessage& msg, MutablePulseSpan32 out, size_t& count) = 0;
+
   /// Get protocol name for logging
   virtual const char* get_protocol_name() const = 0;
 };
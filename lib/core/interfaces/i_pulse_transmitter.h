@@ -0,0 +1,31 @@
+#pragma once
+
+// IPulseTransmitter Interface
+// Abstraction for keying an RF transmitter with edge durations
+// Allows transmit scheduling to be tested without ESPHome dependencies
+
+#include "i_protocol_codec.h"
+#include "pulse_span.h"
+#include <cstdint>
+
+namespace home_esp {
+
+class IPulseTransmitter {
+ public:
+  virtual ~IPulseTransmitter() = default;
+
+  /// Start sending a frame repeats times back to back
+  /// @param msg The command frame was encoded from, for transmitters that
+  ///        keep prebuilt waveforms per message (see RmtWaveformCache)
+  /// @param frame Edge durations in microseconds, high first (the
+  ///        IProtocolCodec::encode format); only valid during the call
+  /// @param repeats Number of consecutive copies
+  /// @return false if the transmitter could not start (retry later)
+  virtual bool transmit(const DecodedMessage& msg, PulseSpan frame, uint8_t repeats) = 0;
+
+  /// True while a transmission started by transmit() is still on air.
+  /// Blocking implementations always return false.
+  virtual bool is_busy() const = 0;
+};
+
+}  // namespace home_esp
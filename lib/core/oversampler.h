@@ -0,0 +1,157 @@
+#pragma once
+
+// Oversampler - Oversampling and decimation for noisy ADC readings
+// Pure C++ with no ESPHome dependencies
+// Running sum over a fixed ring, one higher-resolution value per burst
+
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Averages raw ADC samples into fewer, higher-resolution values.
+///
+/// The last `samples` readings sit in a ring with a running sum, so each
+/// add() is one subtract, one add and one store however long the window.
+/// Every `decimation` samples (by default once per full window) the sum
+/// becomes an output: averaging 4^n samples of a noisy input gains n bits,
+/// so outputs carry extra_bits() more than the ADC. Pass the ADC full
+/// scale through output_resolution() to the converter that consumes them.
+///
+/// Mains hum is rejected by spreading a burst evenly over one mains cycle:
+/// sample_interval_us() gives the spacing for the configured frequency,
+/// and the sum then cancels the hum and its harmonics below the sample
+/// count. Timing the samples is the caller's job.
+///
+/// @tparam MaxSamples Ring capacity, a power of two
+template <size_t MaxSamples>
+class Oversampler {
+ public:
+  static_assert(MaxSamples > 0 && MaxSamples <= 4096 && (MaxSamples & (MaxSamples - 1)) == 0,
+                "MaxSamples must be a power of two, at most 4096");
+
+  /// Configuration for oversampling
+  struct Config {
+    uint16_t samples;      // Window averaged per output, a power of two
+    uint16_t decimation;   // Samples between outputs (0 = samples)
+    uint8_t mains_hz;      // Mains frequency to reject (0 = none)
+
+    Config()
+        : samples(MaxSamples),
+          decimation(0),
+          mains_hz(0) {}
+  };
+
+  explicit Oversampler(Config config = Config()) {
+    if (!set_config(config)) {
+      set_config(Config());
+    }
+  }
+
+  /// Apply a new configuration and clear the window
+  /// @return false (config unchanged) if samples is not a power of two
+  ///         no larger than MaxSamples
+  bool set_config(const Config& config) {
+    if (config.samples == 0 || config.samples > MaxSamples ||
+        (config.samples & (config.samples - 1)) != 0) {
+      return false;
+    }
+    config_ = config;
+    decimation_ = config.decimation > 0 ? config.decimation : config.samples;
+    uint8_t window_bits = 0;
+    while ((1u << window_bits) < config.samples) {
+      window_bits++;
+    }
+    extra_bits_ = window_bits / 2;
+    shift_ = window_bits - extra_bits_;
+    reset();
+    return true;
+  }
+
+  const Config& get_config() const { return config_; }
+
+  /// Add one sample
+  /// @return true if it completed an output, read with value()
+  bool add(uint16_t raw) {
+    sum_ += raw;
+    sum_ -= ring_[index_];
+    ring_[index_] = raw;
+    index_ = (index_ + 1) & (config_.samples - 1);
+    if (filled_ < config_.samples) {
+      filled_++;
+    }
+    if (++since_output_ < decimation_ || filled_ < config_.samples) {
+      return false;
+    }
+    since_output_ = 0;
+    uint32_t scaled = (sum_ + ((uint32_t{1} << shift_) >> 1)) >> shift_;
+    value_ = scaled > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(scaled);
+    output_count_++;
+    return true;
+  }
+
+  /// Add a run of samples, calling on_output(uint16_t value) for each
+  /// output completed along the way
+  /// @return Number of outputs
+  template <typename OnOutput>
+  size_t add_batch(const uint16_t* samples, size_t count, OnOutput&& on_output) {
+    size_t outputs = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (add(samples[i])) {
+        on_output(value_);
+        outputs++;
+      }
+    }
+    return outputs;
+  }
+
+  /// Latest output, scaled to output_resolution()
+  uint16_t value() const { return value_; }
+
+  /// Resolution gained over a single sample, in bits
+  uint8_t extra_bits() const { return extra_bits_; }
+
+  /// Full-scale output for an ADC whose full scale is adc_resolution
+  uint32_t output_resolution(uint32_t adc_resolution) const {
+    return adc_resolution << extra_bits_;
+  }
+
+  /// Spacing that spreads one window over exactly one mains cycle
+  /// @return 0 if mains_hz is 0 (sample back to back)
+  uint32_t sample_interval_us() const {
+    if (config_.mains_hz == 0) {
+      return 0;
+    }
+    return (1000000u + config_.mains_hz * config_.samples / 2) /
+           (uint32_t{config_.mains_hz} * config_.samples);
+  }
+
+  /// Forget the window; the next output needs a full window again
+  void reset() {
+    for (auto& sample : ring_) {
+      sample = 0;
+    }
+    sum_ = 0;
+    index_ = 0;
+    filled_ = 0;
+    since_output_ = 0;
+  }
+
+  /// Outputs produced
+  uint32_t get_output_count() const { return output_count_; }
+
+ private:
+  Config config_;
+  uint16_t decimation_{1};
+  uint8_t extra_bits_{0};
+  uint8_t shift_{0};
+  uint16_t ring_[MaxSamples]{};
+  uint32_t sum_{0};
+  uint16_t index_{0};
+  uint16_t filled_{0};
+  uint16_t since_output_{0};
+  uint16_t value_{0};
+  uint32_t output_count_{0};
+};
+
+}  // namespace home_esp
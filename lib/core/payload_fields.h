@@ -0,0 +1,161 @@
+#pragma once
+
+// PayloadFields - Compile-time bitfield layouts for RF sensor payloads
+// Pure C++ with no ESPHome dependencies
+// Turns thermometer/hygrometer codes into ISensorPublisher values
+
+#include "interfaces/i_protocol_codec.h"
+#include "interfaces/i_sensor_publisher.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace home_esp {
+
+/// One value packed into a code: value = raw * scale + bias.
+///
+/// Bits are numbered from the LSB of DecodedMessage::code, i.e. bit 0 is
+/// the last bit received.
+struct FieldSpec {
+  uint8_t offset;     // Position of the field's LSB
+  uint8_t width;      // Bits, 1-32
+  bool is_signed;     // Two's complement
+  float scale;
+  float bias;
+
+  constexpr uint32_t mask() const {
+    return width >= 32 ? 0xFFFFFFFFu : (uint32_t{1} << width) - 1;
+  }
+
+  constexpr int32_t raw(uint32_t code) const {
+    uint32_t bits = (code >> offset) & mask();
+    if (is_signed && width < 32 && (bits >> (width - 1)) != 0) {
+      bits |= ~mask();  // Sign-extend
+    }
+    return static_cast<int32_t>(bits);
+  }
+
+  constexpr float value(uint32_t code) const {
+    return static_cast<float>(raw(code)) * scale + bias;
+  }
+};
+
+/// A device type's frame: which codes belong to it and where its fields
+/// are. Declare layouts constexpr so PayloadDecoder can use them as
+/// template arguments:
+/// @code
+///   constexpr PayloadLayout<2> THERMO = {
+///       24, 0xF00000, 0x500000,          // 24-bit frames starting 0101
+///       {{8, 12, true, 0.1f, 0.0f},      // Temperature, 0.1 C
+///        {0, 7, false, 1.0f, 0.0f}}};    // Humidity, %
+/// @endcode
+template <size_t N>
+struct PayloadLayout {
+  static constexpr size_t FIELD_COUNT = N;
+
+  uint16_t bit_length;   // Frame length the device sends (0 = any)
+  uint32_t id_mask;      // Bits that identify the device type or channel
+  uint32_t id_value;     // Required value of those bits
+  FieldSpec fields[N];
+
+  constexpr bool matches(const DecodedMessage& msg) const {
+    return (bit_length == 0 || msg.bit_length == bit_length) &&
+           (msg.code & id_mask) == id_value;
+  }
+
+  /// Fields fit the frame, do not overlap each other or the id bits
+  constexpr bool is_valid() const {
+    uint32_t used = id_mask;
+    if ((id_value & ~id_mask) != 0) {
+      return false;
+    }
+    for (size_t i = 0; i < N; ++i) {
+      const FieldSpec& f = fields[i];
+      if (f.width == 0 || f.width > 32 || f.offset + f.width > 32 ||
+          (bit_length != 0 && f.offset + f.width > bit_length)) {
+        return false;
+      }
+      uint32_t bits = f.mask() << f.offset;
+      if ((used & bits) != 0) {
+        return false;
+      }
+      used |= bits;
+    }
+    return true;
+  }
+};
+
+/// Type-erased handle RF433Receiver keeps for each device type.
+/// One virtual call per frame and device type; the fields themselves are
+/// extracted inline.
+class IPayloadDecoder {
+ public:
+  virtual ~IPayloadDecoder() = default;
+
+  /// Publish msg's fields if it belongs to this device type
+  /// @return true if msg matched
+  virtual bool process(const DecodedMessage& msg) = 0;
+};
+
+/// Decodes frames of one device type into one publisher per field.
+///
+/// The layout is a template argument, so every shift, mask, sign
+/// extension and scale is a constant and the field loop unrolls into
+/// straight-line code. Nothing is allocated; fields without a publisher
+/// are skipped.
+///
+/// @tparam Layout A constexpr PayloadLayout with static storage
+template <const auto& Layout>
+class PayloadDecoder : public IPayloadDecoder {
+  using LayoutType = std::remove_cv_t<std::remove_reference_t<decltype(Layout)>>;
+  static_assert(Layout.is_valid(), "PayloadLayout fields overlap or exceed the frame");
+
+ public:
+  static constexpr size_t FIELD_COUNT = LayoutType::FIELD_COUNT;
+
+  /// Publish field index to publisher (nullptr to skip it)
+  void set_publisher(size_t field, ISensorPublisher* publisher) {
+    if (field < FIELD_COUNT) {
+      publishers_[field] = publisher;
+    }
+  }
+
+  bool process(const DecodedMessage& msg) override {
+    if (!Layout.matches(msg)) {
+      return false;
+    }
+    publish_fields(msg.code, std::make_index_sequence<FIELD_COUNT>{});
+    matched_count_++;
+    return true;
+  }
+
+  /// Extract every field of a code without publishing
+  static constexpr void decode(uint32_t code, float (&values)[FIELD_COUNT]) {
+    for (size_t i = 0; i < FIELD_COUNT; ++i) {
+      values[i] = Layout.fields[i].value(code);
+    }
+  }
+
+  /// Frames that matched the layout
+  uint32_t get_matched_count() const { return matched_count_; }
+
+ private:
+  template <size_t... I>
+  void publish_fields(uint32_t code, std::index_sequence<I...>) {
+    (publish_field<I>(code), ...);
+  }
+
+  template <size_t I>
+  void publish_field(uint32_t code) {
+    constexpr FieldSpec field = Layout.fields[I];
+    if (publishers_[I] != nullptr) {
+      publishers_[I]->publish(field.value(code));
+    }
+  }
+
+  ISensorPublisher* publishers_[FIELD_COUNT]{};
+  uint32_t matched_count_{0};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,149 @@
+#pragma once
+
+// PublishPolicy - Deadband and heartbeat for sensor publishes
+// Pure C++ with no ESPHome dependencies
+// Decides which readings are worth a radio frame
+
+#include <cmath>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Suppresses sensor publishes that would not change what the entity shows.
+///
+/// Readings are compared as the entity reports them: rounded to
+/// accuracy_decimals and held as integer steps, so 21.04 and 20.96 at one
+/// decimal are the same 21.0 and only the first is sent. A new value is
+/// published once it is at least deadband away from the last *published*
+/// one; comparing against that rather than the previous reading gives
+/// hysteresis, so noise on a rounding boundary stays quiet while a slow
+/// drift still gets through.
+///
+/// heartbeat_ms bounds the silence: when that long has passed since the
+/// last publish, the next reading goes out regardless. Changes between a
+/// value and unavailable always publish.
+///
+/// A device that restarts between readings (deep sleep) keeps snapshot()
+/// and restore()s it on wake; update() must then be given a clock that
+/// ran on through the restart.
+///
+/// @note Timing uses unsigned 32-bit arithmetic which correctly handles
+///       millis() overflow (~49.7 days).
+class PublishPolicy {
+ public:
+  /// Configuration for publish suppression
+  struct Config {
+    int8_t accuracy_decimals;   // Decimals the entity reports
+    float deadband;             // Change needed to publish (0 = any reported change)
+    uint32_t heartbeat_ms;      // Longest silence between publishes (0 = unbounded)
+
+    Config()
+        : accuracy_decimals(1),
+          deadband(0.0f),
+          heartbeat_ms(0) {}
+  };
+
+  /// Last publish, for carrying the policy over a restart
+  struct Snapshot {
+    uint32_t last_publish_millis;
+    int32_t last_steps;
+    uint8_t state;
+  };
+
+  explicit PublishPolicy(Config config = Config()) { set_config(config); }
+
+  /// Apply a new configuration; the next reading publishes
+  void set_config(const Config& config) {
+    config_ = config;
+    scale_ = 1.0f;
+    for (int8_t i = 0; i < config.accuracy_decimals; ++i) {
+      scale_ *= 10.0f;
+    }
+    for (int8_t i = 0; i > config.accuracy_decimals; --i) {
+      scale_ /= 10.0f;
+    }
+    long steps = std::lround(config.deadband * scale_);
+    deadband_steps_ = steps > 1 ? static_cast<uint32_t>(steps) : 1;
+    reset();
+  }
+
+  const Config& get_config() const { return config_; }
+
+  /// Update timing (call this regularly with current millis)
+  void update(uint32_t current_millis) {
+    current_millis_ = current_millis;
+  }
+
+  /// Decide whether to publish a reading
+  /// @return true if it should be published
+  bool accept(float value) {
+    int32_t steps = static_cast<int32_t>(std::lround(value * scale_));
+    if (state_ == VALUE && !heartbeat_due()) {
+      uint32_t change = steps > last_steps_ ? uint32_t(steps) - uint32_t(last_steps_)
+                                            : uint32_t(last_steps_) - uint32_t(steps);
+      if (change < deadband_steps_) {
+        suppressed_count_++;
+        return false;
+      }
+    }
+    state_ = VALUE;
+    last_steps_ = steps;
+    last_publish_millis_ = current_millis_;
+    return true;
+  }
+
+  /// Decide whether to publish the unavailable state
+  /// @return true if it should be published
+  bool accept_unavailable() {
+    if (state_ == UNAVAILABLE && !heartbeat_due()) {
+      suppressed_count_++;
+      return false;
+    }
+    state_ = UNAVAILABLE;
+    last_publish_millis_ = current_millis_;
+    return true;
+  }
+
+  /// Forget the last publish so the next reading goes out
+  void reset() { state_ = NONE; }
+
+  Snapshot snapshot() const {
+    return Snapshot{last_publish_millis_, last_steps_, static_cast<uint8_t>(state_)};
+  }
+
+  /// Continue from a snapshot taken with the same accuracy_decimals
+  void restore(const Snapshot& snapshot) {
+    last_publish_millis_ = snapshot.last_publish_millis;
+    last_steps_ = snapshot.last_steps;
+    state_ = snapshot.state <= UNAVAILABLE ? static_cast<State>(snapshot.state) : NONE;
+  }
+
+  /// Readings that were not published
+  uint32_t get_suppressed_count() const { return suppressed_count_; }
+
+  void reset_stats() { suppressed_count_ = 0; }
+
+ private:
+  enum State : uint8_t {
+    NONE,          // Nothing published yet
+    VALUE,
+    UNAVAILABLE,
+  };
+
+  bool heartbeat_due() const {
+    return config_.heartbeat_ms > 0 &&
+           current_millis_ - last_publish_millis_ >= config_.heartbeat_ms;
+  }
+
+  Config config_;
+  float scale_{1.0f};
+  uint32_t deadband_steps_{1};
+  State state_{NONE};
+  int32_t last_steps_{0};
+
+  uint32_t current_millis_{0};
+  uint32_t last_publish_millis_{0};
+  uint32_t suppressed_count_{0};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,213 @@
+#pragma once
+
+// PulseClassifier - Lookup-table classification of RF433 pulse durations
+// Pure C++ with no ESPHome dependencies
+// Replaces per-pulse window compares with a quantize-and-load
+
+#include "rf433_codec.h"
+#include "rf433_protocols.h"
+#include "rf433_stream_decoder.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace home_esp {
+
+/// Classifies pulses for up to 8 protocols with one table load per edge.
+///
+/// Durations are quantized into 256 buckets: 16us wide below 2048us,
+/// where data symbols live, and 256us wide above it for sync gaps. Each
+/// bucket stores two masks over the protocols' symbol halves:
+/// - full: windows that contain the whole bucket (answered by the load)
+/// - partial: windows whose edge falls inside the bucket
+/// Only a pulse landing in a window's edge bucket is compared against
+/// the exact bounds, so results are identical to RF433Codec's windows
+/// while typical pulses and most noise cost a shift and a load.
+///
+/// Mask bit layout for protocol p: sync at p, '0' at N + p, '1' at 2N + p.
+/// classify(high, low) ANDs the high and low masks, so a set bit means
+/// the pair is that symbol.
+///
+/// Tables take 4 * 256 * sizeof(Mask) bytes: 1 KB for one protocol,
+/// 4 KB for a full 8-protocol bank.
+///
+/// @tparam N Number of protocols (1-8)
+template <size_t N = 1>
+class PulseClassifier {
+  static_assert(N >= 1 && N <= 8, "PulseClassifier supports 1-8 protocols");
+
+ public:
+  using TimingConfig = RF433Codec::TimingConfig;
+  /// Smallest unsigned type holding 3 bits per protocol
+  using Mask = std::conditional_t<(N <= 2), uint8_t,
+                                  std::conditional_t<(N <= 5), uint16_t, uint32_t>>;
+
+  static constexpr size_t BUCKETS = 256;
+  static constexpr Mask PROTOCOL_MASK = static_cast<Mask>((1u << N) - 1);
+
+  /// Single-protocol classifier; implicit so it can stand in for
+  /// RF433TimingWindows as a stream decoder's Symbols
+  PulseClassifier(const TimingConfig& config = TimingConfig()) {
+    static_assert(N == 1, "Build multi-protocol classifiers from a protocol table");
+    add_protocol(0, config);
+    build_tables();
+  }
+
+  /// Build from a descriptor table (protocol p takes mask bit p)
+  explicit PulseClassifier(const RF433Protocol (&protocols)[N]) {
+    for (size_t p = 0; p < N; ++p) {
+      add_protocol(p, protocols[p].to_timing_config());
+    }
+    build_tables();
+  }
+
+  /// Symbol halves a high pulse could be
+  Mask classify_high(uint16_t high_us) const {
+    return lookup(high_table_, high_windows_, high_us);
+  }
+
+  /// Symbol halves a low pulse could be
+  Mask classify_low(uint16_t low_us) const {
+    return lookup(low_table_, low_windows_, low_us);
+  }
+
+  /// Symbols a high/low pair matches, in the layout described above
+  Mask classify(uint16_t high_us, uint16_t low_us) const {
+    return classify_high(high_us) & classify_low(low_us);
+  }
+
+  static Mask sync_bits(Mask mask) { return mask & PROTOCOL_MASK; }
+  static Mask zero_bits(Mask mask) { return (mask >> N) & PROTOCOL_MASK; }
+  static Mask one_bits(Mask mask) { return (mask >> (2 * N)) & PROTOCOL_MASK; }
+
+  /// Protocol 0 sync test (Symbols interface)
+  bool is_sync_pulse(uint16_t high_us, uint16_t low_us) const {
+    // Most noise is rejected by the high pulse alone
+    return (sync_bits(classify_high(high_us)) & 1) &&
+           (sync_bits(classify_low(low_us)) & 1);
+  }
+
+  /// Protocol 0 bit (Symbols interface)
+  /// @return 1 or 0 for a data bit, -1 if the pair is neither
+  int decode_bit(uint16_t high_us, uint16_t low_us) const {
+    Mask mask = classify_high(high_us);
+    if ((one_bits(mask) | zero_bits(mask)) == 0) {
+      return -1;
+    }
+    mask &= classify_low(low_us);
+    if (one_bits(mask) & 1) {
+      return 1;
+    }
+    if (zero_bits(mask) & 1) {
+      return 0;
+    }
+    return -1;
+  }
+
+  /// Bucket index for a duration
+  static size_t quantize(uint16_t duration_us) {
+    // Both candidates are computed so the compiler can select without a
+    // branch; noise durations would make one unpredictable
+    size_t fine = duration_us >> FINE_SHIFT;
+    size_t coarse = COARSE_BASE + (duration_us >> COARSE_SHIFT);
+    coarse = coarse < BUCKETS ? coarse : BUCKETS - 1;
+    return duration_us < FINE_LIMIT_US ? fine : coarse;
+  }
+
+ private:
+  static constexpr uint16_t FINE_LIMIT_US = 2048;
+  static constexpr unsigned FINE_SHIFT = 4;
+  static constexpr unsigned COARSE_SHIFT = 8;
+  // First coarse bucket follows the last fine one
+  static constexpr size_t COARSE_BASE =
+      (FINE_LIMIT_US >> FINE_SHIFT) - (FINE_LIMIT_US >> COARSE_SHIFT);
+  static constexpr size_t WINDOWS = 3 * N;
+
+  /// Inclusive [min, max] acceptance range for one pulse
+  struct Window {
+    uint16_t min;
+    uint16_t max;
+
+    bool contains(uint16_t value) const {
+      return value >= min && value <= max;
+    }
+  };
+
+  struct Entry {
+    Mask full;
+    Mask partial;
+  };
+
+  static Mask lookup(const Entry* table, const Window* windows, uint16_t duration_us) {
+    const Entry& entry = table[quantize(duration_us)];
+    Mask mask = entry.full;
+    for (Mask edge = entry.partial; edge != 0; edge &= edge - 1) {
+      unsigned i = static_cast<unsigned>(__builtin_ctz(edge));
+      if (windows[i].contains(duration_us)) {
+        mask |= static_cast<Mask>(1u << i);
+      }
+    }
+    return mask;
+  }
+
+  static Window window(const TimingConfig& config, uint8_t pulses) {
+    // Same arithmetic as RF433Codec::is_within_tolerance()
+    uint16_t expected = config.pulse_length_us * pulses;
+    uint16_t margin = expected * config.tolerance_percent / 100;
+    return Window{static_cast<uint16_t>(expected - margin),
+                  static_cast<uint16_t>(expected + margin)};
+  }
+
+  void add_protocol(size_t p, const TimingConfig& config) {
+    high_windows_[p] = window(config, config.sync_high_pulses);
+    low_windows_[p] = window(config, config.sync_low_pulses);
+    high_windows_[N + p] = window(config, config.zero_high_pulses);
+    low_windows_[N + p] = window(config, config.zero_low_pulses);
+    high_windows_[2 * N + p] = window(config, config.one_high_pulses);
+    low_windows_[2 * N + p] = window(config, config.one_low_pulses);
+  }
+
+  /// Inclusive duration range covered by a bucket
+  static Window bucket_range(size_t bucket) {
+    if (bucket < (FINE_LIMIT_US >> FINE_SHIFT)) {
+      uint32_t min = static_cast<uint32_t>(bucket) << FINE_SHIFT;
+      return Window{static_cast<uint16_t>(min),
+                    static_cast<uint16_t>(min + (1u << FINE_SHIFT) - 1)};
+    }
+    uint32_t min = static_cast<uint32_t>(bucket - COARSE_BASE) << COARSE_SHIFT;
+    uint32_t max = bucket == BUCKETS - 1 ? UINT16_MAX : min + (1u << COARSE_SHIFT) - 1;
+    return Window{static_cast<uint16_t>(min), static_cast<uint16_t>(max)};
+  }
+
+  static void fill(Entry* table, const Window* windows) {
+    for (size_t b = 0; b < BUCKETS; ++b) {
+      Window range = bucket_range(b);
+      Entry entry{0, 0};
+      for (size_t i = 0; i < WINDOWS; ++i) {
+        const Window& w = windows[i];
+        Mask bit = static_cast<Mask>(1u << i);
+        if (w.min <= range.min && w.max >= range.max) {
+          entry.full |= bit;
+        } else if (w.min <= range.max && w.max >= range.min) {
+          entry.partial |= bit;
+        }
+      }
+      table[b] = entry;
+    }
+  }
+
+  void build_tables() {
+    fill(high_table_, high_windows_);
+    fill(low_table_, low_windows_);
+  }
+
+  Entry high_table_[BUCKETS];
+  Entry low_table_[BUCKETS];
+  Window high_windows_[WINDOWS];
+  Window low_windows_[WINDOWS];
+};
+
+/// Stream decoder classifying pulses through a PulseClassifier table
+using RF433LutStreamDecoder = BasicRF433StreamDecoder<PulseClassifier<1>>;
+
+}  // namespace home_esp
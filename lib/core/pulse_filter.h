@@ -0,0 +1,224 @@
+#pragma once
+
+// PulseFilter - Glitch and idle-noise pre-filter for RF pulse streams
+// Pure C++ with no ESPHome dependencies
+// Sits between the pulse source and the decoder, one edge at a time
+
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Removes edges no decoder could use before they reach one.
+///
+/// Two stages:
+/// - Glitch merge: an edge shorter than glitch_us is a spike that split
+///   a real pulse, so it and the edge after it are folded into the
+///   previous edge (keeping high/low order intact).
+/// - Sync gate: every supported frame starts with a long sync gap. Edges
+///   are only forwarded from the one before a gap of at least
+///   min_sync_gap_us (the sync high) for max_frame_edges edges; outside
+///   that, idle receiver noise is dropped.
+///
+/// With the gate on, merging is limited to where a split pulse can be
+/// told apart from the edges around a frame: only inside a frame's
+/// window, never into a sync gap or the edge right after one, never into
+/// the window's last edge, and a sync gap is never absorbed. Otherwise a
+/// glitch between the final bit and idle noise would fuse the two into a
+/// shorter (still valid looking) code, and one just before a sync high
+/// would swallow the sync. Glitches outside a frame pass on unchanged;
+/// the gate drops them with the rest of the noise.
+///
+/// Edges leave the filter one edge late, since the next edge may turn
+/// out to be a glitch to merge; flush() releases the held edge.
+///
+/// The gate is what saves decode work: it pays off ahead of a
+/// multi-protocol RF433DecoderBank (about 20 down to 3 ns per idle edge
+/// on a host). A single stream decoder is already about as cheap as the
+/// filter itself, so in front of one the filter is for glitch merging and
+/// saves little or no time.
+class PulseFilter {
+ public:
+  /// Configuration for filtering
+  struct Config {
+    uint16_t glitch_us;          // Edges shorter than this are merged (0 = off)
+    uint16_t min_sync_gap_us;    // Shortest gap that can be a sync low (0 = no gate)
+    uint8_t max_frame_edges;     // Edges forwarded after each sync gap (2 per bit)
+
+    // The default gap admits every table protocol except rc-switch 4,
+    // whose 2280us sync needs min_sync_gap_us lowered to ~1700
+    Config()
+        : glitch_us(100),
+          min_sync_gap_us(4000),
+          max_frame_edges(48) {}
+
+    /// Loosen both stages so a timing whose shortest pulse and shortest
+    /// sync low (at the low edge of its tolerance) are these still passes
+    /// whole: glitches must be shorter than any real pulse, and the gate
+    /// must open on the sync
+    /// @return true if anything changed
+    bool admit(uint16_t shortest_pulse_us, uint16_t shortest_sync_low_us) {
+      bool changed = false;
+      if (glitch_us >= shortest_pulse_us) {
+        glitch_us = shortest_pulse_us / 2;
+        changed = true;
+      }
+      if (min_sync_gap_us > shortest_sync_low_us) {
+        min_sync_gap_us = shortest_sync_low_us;
+        changed = true;
+      }
+      return changed;
+    }
+  };
+
+  explicit PulseFilter(Config config = Config()) : config_(config) {}
+
+  /// Apply a new configuration, keeping the counters; drops held edges
+  void set_config(const Config& config) {
+    config_ = config;
+    reset();
+  }
+
+  /// Filter the next edge duration.
+  /// @param sink Called as sink(uint16_t duration_us) for each edge passed
+  template <typename Sink>
+  void feed(uint16_t duration_us, Sink&& sink) {
+    if (absorb_next_) {
+      absorb_next_ = false;
+      if (!is_sync_gap(duration_us)) {
+        // Second half of a pulse split by a glitch
+        pending_ = saturating_add(saturating_add(pending_, glitch_), duration_us);
+        merged_count_ += 2;
+        return;
+      }
+      // A sync gap is never folded away: release the glitch as an edge
+      gate(pending_, sink);
+      pending_ = glitch_;
+      pending_after_gap_ = false;
+    } else if (duration_us < config_.glitch_us && have_pending_ && can_merge()) {
+      glitch_ = duration_us;
+      absorb_next_ = true;
+      return;
+    }
+
+    if (have_pending_) {
+      gate(pending_, sink);
+      pending_after_gap_ = is_sync_gap(pending_);
+    }
+    pending_ = duration_us;
+    have_pending_ = true;
+  }
+
+  /// Release the held edge (e.g. once the channel has gone quiet)
+  template <typename Sink>
+  void flush(Sink&& sink) {
+    if (have_pending_) {
+      gate(pending_, sink);
+      have_pending_ = false;
+    }
+    absorb_next_ = false;  // The glitch's second half never came
+    pending_after_gap_ = false;
+  }
+
+  /// Drop held edges and close the gate
+  void reset() {
+    have_pending_ = false;
+    absorb_next_ = false;
+    pending_after_gap_ = false;
+    have_candidate_ = false;
+    open_edges_ = 0;
+  }
+
+  /// Edges folded into neighbours as glitches
+  uint32_t get_merged_count() const { return merged_count_; }
+
+  /// Edges dropped by the sync gate
+  uint32_t get_dropped_count() const { return dropped_count_; }
+
+  /// Total edges removed from the stream
+  uint32_t get_removed_count() const { return merged_count_ + dropped_count_; }
+
+  /// Edges forwarded to the sink
+  uint32_t get_passed_count() const { return passed_count_; }
+
+  void reset_stats() {
+    merged_count_ = 0;
+    dropped_count_ = 0;
+    passed_count_ = 0;
+  }
+
+  const Config& get_config() const { return config_; }
+
+ private:
+  static uint16_t saturating_add(uint16_t a, uint16_t b) {
+    uint32_t sum = static_cast<uint32_t>(a) + b;
+    return sum > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(sum);
+  }
+
+  bool is_sync_gap(uint16_t edge) const {
+    return config_.min_sync_gap_us > 0 && edge >= config_.min_sync_gap_us;
+  }
+
+  /// Whether a glitch may be folded into the held edge
+  bool can_merge() const {
+    if (config_.min_sync_gap_us == 0) {
+      return true;  // No gate: frames are not tracked
+    }
+    // open_edges_ still counts the held edge, so 1 means it is the last
+    return open_edges_ > 1 && !pending_after_gap_ && !is_sync_gap(pending_);
+  }
+
+  /// Second stage: decide whether a complete edge is forwarded
+  template <typename Sink>
+  void gate(uint16_t edge, Sink& sink) {
+    if (config_.min_sync_gap_us == 0) {
+      pass(edge, sink);
+      return;
+    }
+
+    if (edge >= config_.min_sync_gap_us) {
+      if (open_edges_ == 0 && have_candidate_) {
+        pass(candidate_, sink);  // The sync high before this gap
+      }
+      have_candidate_ = false;
+      pass(edge, sink);
+      open_edges_ = config_.max_frame_edges;
+      return;
+    }
+
+    if (open_edges_ > 0) {
+      open_edges_--;
+      pass(edge, sink);
+      return;
+    }
+
+    // Gate closed: keep this edge in case a sync gap follows it
+    if (have_candidate_) {
+      dropped_count_++;
+    }
+    candidate_ = edge;
+    have_candidate_ = true;
+  }
+
+  template <typename Sink>
+  void pass(uint16_t edge, Sink& sink) {
+    passed_count_++;
+    sink(edge);
+  }
+
+  Config config_;
+  uint16_t pending_{0};
+  uint16_t glitch_{0};
+  uint16_t candidate_{0};
+  uint8_t open_edges_{0};
+  bool have_pending_{false};
+  bool absorb_next_{false};
+  bool pending_after_gap_{false};
+  bool have_candidate_{false};
+
+  uint32_t merged_count_{0};
+  uint32_t dropped_count_{0};
+  uint32_t passed_count_{0};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,114 @@
+#pragma once
+
+// PulseRingBuffer - Lock-free ISR-to-loop pulse queue
+// Pure C++ with no ESPHome dependencies
+// Single-producer/single-consumer ring of edge durations (microseconds)
+
+#include "pulse_span.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Single-producer/single-consumer ring of pulse durations.
+///
+/// The producer (GPIO interrupt, or a thread in host tests) calls push();
+/// the consumer (component loop()) calls read_window() and consume().
+/// Neither side takes a lock.
+///
+/// Every value is stored twice, at `i` and `i + Capacity`, so the readable
+/// region is always one contiguous run starting at the read index. The
+/// consumer can hand that run straight to a decoder without copying or
+/// special-casing wrap-around.
+///
+/// @tparam Capacity Number of pulses held; must be a power of two.
+template <size_t Capacity>
+class PulseRingBuffer {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "PulseRingBuffer capacity must be a power of two");
+
+ public:
+  static constexpr size_t CAPACITY = Capacity;
+
+  /// Producer side: append one edge duration.
+  /// @return false if the ring was full (the pulse is dropped and counted)
+  bool push(uint16_t duration_us) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    size_t used = head - tail;
+
+    if (used >= Capacity) {
+      overflow_count_.store(overflow_count_.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+      return false;
+    }
+
+    size_t idx = head & (Capacity - 1);
+    buffer_[idx] = duration_us;
+    buffer_[idx + Capacity] = duration_us;
+    head_.store(head + 1, std::memory_order_release);
+
+    if (used + 1 > high_water_mark_.load(std::memory_order_relaxed)) {
+      high_water_mark_.store(used + 1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  /// Consumer side: get every pulse currently readable.
+  /// @param count Output: number of pulses at the returned pointer
+  /// @return Pointer to the oldest unread pulse; valid until consume()
+  const uint16_t* read_window(size_t& count) const {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_acquire);
+    count = head - tail;
+    return &buffer_[tail & (Capacity - 1)];
+  }
+
+  /// Consumer side: read_window() as a span for IProtocolCodec::decode()
+  PulseSpan read_span() const {
+    size_t count = 0;
+    const uint16_t* pulses = read_window(count);
+    return PulseSpan(pulses, count);
+  }
+
+  /// Consumer side: release pulses obtained from read_window()
+  void consume(size_t count) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    tail_.store(tail + count, std::memory_order_release);
+  }
+
+  /// Number of pulses waiting to be read
+  size_t available() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return available() == 0; }
+
+  /// Pulses dropped because the ring was full
+  uint32_t overflow_count() const {
+    return overflow_count_.load(std::memory_order_relaxed);
+  }
+
+  /// Highest fill level observed since construction or reset_stats()
+  size_t high_water_mark() const {
+    return high_water_mark_.load(std::memory_order_relaxed);
+  }
+
+  /// Reset the diagnostic counters (call from the consumer side only
+  /// while the producer is quiescent)
+  void reset_stats() {
+    overflow_count_.store(0, std::memory_order_relaxed);
+    high_water_mark_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  uint16_t buffer_[Capacity * 2]{};
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<uint32_t> overflow_count_{0};
+  std::atomic<size_t> high_water_mark_{0};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,124 @@
+#pragma once
+
+// PulseSpan - Non-owning views over pulse duration buffers
+// Pure C++ with no ESPHome dependencies
+// Lets codecs read ring segments, capture files and RMT buffers in place
+
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Read-only view of edge durations in microseconds.
+///
+/// Never copies or owns the pulses; the buffer must outlive the span.
+/// T is the storage width: uint16_t for ISR rings and RF433Codec's wire
+/// format, uint32_t for sources such as RMT or capture files that can
+/// record gaps longer than 65ms.
+template <typename T>
+class BasicPulseSpan {
+ public:
+  constexpr BasicPulseSpan() = default;
+  constexpr BasicPulseSpan(const T* data, size_t size) : data_(data), size_(size) {}
+
+  template <size_t N>
+  constexpr BasicPulseSpan(const T (&pulses)[N]) : data_(pulses), size_(N) {}
+
+  constexpr const T* data() const { return data_; }
+  constexpr size_t size() const { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
+
+  constexpr T operator[](size_t i) const { return data_[i]; }
+
+  /// Duration i as uint16_t; longer durations saturate at 65535us, which
+  /// no RF433 symbol window reaches
+  constexpr uint16_t duration_us(size_t i) const {
+    if constexpr (sizeof(T) > sizeof(uint16_t)) {
+      return data_[i] > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(data_[i]);
+    } else {
+      return data_[i];
+    }
+  }
+
+  constexpr const T* begin() const { return data_; }
+  constexpr const T* end() const { return data_ + size_; }
+
+  /// View of count pulses starting at offset (clamped to the span)
+  constexpr BasicPulseSpan subspan(size_t offset, size_t count = SIZE_MAX) const {
+    offset = offset < size_ ? offset : size_;
+    size_t rest = size_ - offset;
+    return BasicPulseSpan(data_ + offset, count < rest ? count : rest);
+  }
+
+ private:
+  const T* data_{nullptr};
+  size_t size_{0};
+};
+
+/// Writable view of a caller-owned duration buffer (e.g. for encode)
+template <typename T>
+class BasicMutablePulseSpan {
+ public:
+  constexpr BasicMutablePulseSpan() = default;
+  constexpr BasicMutablePulseSpan(T* data, size_t size) : data_(data), size_(size) {}
+
+  template <size_t N>
+  constexpr BasicMutablePulseSpan(T (&pulses)[N]) : data_(pulses), size_(N) {}
+
+  constexpr T* data() const { return data_; }
+  constexpr size_t size() const { return size_; }
+
+  T& operator[](size_t i) const { return data_[i]; }
+  void set(size_t i, T duration_us) const { data_[i] = duration_us; }
+
+  /// Read-only view of the first count pulses, e.g. after encoding
+  constexpr BasicPulseSpan<T> first(size_t count) const {
+    return BasicPulseSpan<T>(data_, count < size_ ? count : size_);
+  }
+
+ private:
+  T* data_{nullptr};
+  size_t size_{0};
+};
+
+using PulseSpan = BasicPulseSpan<uint16_t>;
+using PulseSpan32 = BasicPulseSpan<uint32_t>;
+using MutablePulseSpan = BasicMutablePulseSpan<uint16_t>;
+using MutablePulseSpan32 = BasicMutablePulseSpan<uint32_t>;
+
+/// Durations stored as little-endian uint16_t bytes (IProtocolCodec's
+/// byte API). Reads byte by byte, so any alignment and host endianness
+/// work.
+class LEPulseBytes {
+ public:
+  LEPulseBytes(const uint8_t* data, size_t len) : data_(data), size_(len / 2) {}
+
+  size_t size() const { return size_; }
+
+  uint16_t duration_us(size_t i) const {
+    return static_cast<uint16_t>(data_[i * 2] | (data_[i * 2 + 1] << 8));
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+};
+
+/// Writable counterpart of LEPulseBytes
+class MutableLEPulseBytes {
+ public:
+  MutableLEPulseBytes(uint8_t* data, size_t len) : data_(data), size_(len / 2) {}
+
+  size_t size() const { return size_; }
+
+  void set(size_t i, uint16_t duration_us) const {
+    data_[i * 2] = static_cast<uint8_t>(duration_us & 0xFF);
+    data_[i * 2 + 1] = static_cast<uint8_t>(duration_us >> 8);
+  }
+
+ private:
+  uint8_t* data_;
+  size_t size_;
+};
+
+}  // namespace home_esp
@@ -0,0 +1,196 @@
+#pragma once
+
+// RepeatFilter - Repeat-frame deduplication and N-of-M voting
+// Pure C++ with no ESPHome dependencies
+// Decides which decoded RF frames are worth publishing
+
+#include "interfaces/i_protocol_codec.h"
+#include <cstdint>
+
+namespace home_esp {
+
+/// Filters the burst of identical frames a remote sends per key press.
+///
+/// Two independent stages, both off-heap and O(HISTORY_SIZE) per frame:
+/// - Voting: a code is only accepted once votes_required of the last
+///   vote_frames frames carry it, rejecting single corrupted decodes.
+/// - Deduplication: once accepted, further copies of the same code are
+///   suppressed until the channel has been free of it for
+///   dedup_window_ms. The window restarts on every copy, so a held button
+///   publishes once rather than once per window. Each accepted code keeps
+///   its own window (up to ACCEPTED_SIZE codes, the least recently seen
+///   giving way), so remotes whose bursts interleave are each published
+///   once.
+///
+/// Voting history is cleared after a gap longer than dedup_window_ms, so
+/// frames from separate key presses never vote together.
+///
+/// @note Timing uses unsigned 32-bit arithmetic which correctly handles
+///       millis() overflow (~49.7 days).
+class RepeatFilter {
+ public:
+  /// Frames remembered for voting; vote_frames is clamped to this
+  static constexpr uint8_t HISTORY_SIZE = 8;
+
+  /// Accepted codes deduplicated at the same time
+  static constexpr uint8_t ACCEPTED_SIZE = 4;
+
+  /// Configuration for repeat handling
+  struct Config {
+    uint32_t dedup_window_ms;   // Quiet time before a code may publish again (0 = off)
+    uint8_t votes_required;     // Matching frames needed to accept (N)
+    uint8_t vote_frames;        // Recent frames considered when voting (M)
+
+    Config()
+        : dedup_window_ms(500),
+          votes_required(1),
+          vote_frames(1) {}
+  };
+
+  explicit RepeatFilter(Config config = Config()) : config_(config) {
+    if (config_.vote_frames > HISTORY_SIZE) {
+      config_.vote_frames = HISTORY_SIZE;
+    }
+    if (config_.vote_frames < config_.votes_required) {
+      config_.vote_frames = config_.votes_required;
+    }
+  }
+
+  /// Update timing (call this regularly with current millis)
+  void update(uint32_t current_millis) {
+    current_millis_ = current_millis;
+  }
+
+  /// Record a decoded frame and decide whether to publish it
+  /// @return true if the frame is a newly accepted code
+  bool accept(const DecodedMessage& msg) {
+    Entry entry{msg.code, msg.protocol};
+
+    if (config_.dedup_window_ms > 0 && count_ > 0 &&
+        current_millis_ - last_frame_millis_ > config_.dedup_window_ms) {
+      count_ = 0;  // Channel went quiet: new burst
+    }
+    last_frame_millis_ = current_millis_;
+    remember(entry);
+
+    Accepted* accepted = find_accepted(entry);
+    if (accepted != nullptr) {
+      accepted->last_millis = current_millis_;
+      suppressed_count_++;
+      return false;
+    }
+
+    if (count_votes(entry) < config_.votes_required) {
+      rejected_count_++;
+      return false;
+    }
+
+    if (config_.dedup_window_ms > 0) {
+      Accepted& slot = accepted_slot();
+      slot.entry = entry;
+      slot.last_millis = current_millis_;
+      slot.used = true;
+    }
+    return true;
+  }
+
+  /// Forget history so the next frame starts a new burst
+  void reset() {
+    count_ = 0;
+    for (auto& accepted : accepted_) {
+      accepted.used = false;
+    }
+  }
+
+  /// Copies of an accepted code that were not published
+  uint32_t get_suppressed_count() const { return suppressed_count_; }
+
+  /// Frames that did not collect enough votes
+  uint32_t get_rejected_count() const { return rejected_count_; }
+
+  void reset_stats() {
+    suppressed_count_ = 0;
+    rejected_count_ = 0;
+  }
+
+  const Config& get_config() const { return config_; }
+
+ private:
+  struct Entry {
+    uint32_t code;
+    uint8_t protocol;
+
+    bool operator==(const Entry& other) const {
+      return code == other.code && protocol == other.protocol;
+    }
+  };
+
+  /// An accepted code and when a copy of it was last seen
+  struct Accepted {
+    Entry entry;
+    uint32_t last_millis;
+    bool used;
+  };
+
+  bool is_live(const Accepted& accepted) const {
+    return accepted.used &&
+           current_millis_ - accepted.last_millis <= config_.dedup_window_ms;
+  }
+
+  /// @return The entry's slot if it is still inside its window
+  Accepted* find_accepted(const Entry& entry) {
+    for (auto& accepted : accepted_) {
+      if (accepted.entry == entry && is_live(accepted)) {
+        return &accepted;
+      }
+    }
+    return nullptr;
+  }
+
+  /// A free or expired slot, else the least recently seen code's
+  Accepted& accepted_slot() {
+    Accepted* oldest = &accepted_[0];
+    for (auto& accepted : accepted_) {
+      if (!is_live(accepted)) {
+        return accepted;
+      }
+      if (current_millis_ - accepted.last_millis > current_millis_ - oldest->last_millis) {
+        oldest = &accepted;
+      }
+    }
+    return *oldest;
+  }
+
+  void remember(const Entry& entry) {
+    history_[head_] = entry;
+    head_ = (head_ + 1) % HISTORY_SIZE;
+    if (count_ < HISTORY_SIZE) {
+      count_++;
+    }
+  }
+
+  /// Matching entries among the newest vote_frames (including this one)
+  uint8_t count_votes(const Entry& entry) const {
+    uint8_t window = count_ < config_.vote_frames ? count_ : config_.vote_frames;
+    uint8_t votes = 0;
+    for (uint8_t i = 1; i <= window; ++i) {
+      if (history_[(head_ + HISTORY_SIZE - i) % HISTORY_SIZE] == entry) {
+        votes++;
+      }
+    }
+    return votes;
+  }
+
+  Config config_;
+  Entry history_[HISTORY_SIZE]{};
+  Accepted accepted_[ACCEPTED_SIZE]{};
+  uint8_t head_{0};
+  uint8_t count_{0};
+
+  uint32_t current_millis_{0};
+  uint32_t last_frame_millis_{0};
+  uint32_t suppressed_count_{0};
+  uint32_t rejected_count_{0};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,220 @@
+#pragma once
+
+// RF433Capture - On-disk format for recorded RF pulse streams
+// Pure C++ with no ESPHome dependencies
+// Reads captures in place (e.g. from an mmap) and writes them through a sink
+
+#include "pulse_span.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace home_esp {
+
+/// Capture file layout (all fields little-endian):
+///
+///   Header, HEADER_SIZE bytes
+///     0  char[4]  magic "RF4C"
+///     4  uint16   version
+///     6  uint16   header size (readers skip fields they don't know)
+///     8  uint32   expected code (valid if expected bits > 0)
+///     12 uint8    expected bits, 0 = unlabelled field recording
+///     13 uint8    protocol hint (RF433_PROTOCOLS id, 0 = unknown)
+///     14 uint16   reserved, 0
+///     16 uint32   expected frames, 0 = unknown (absent from the first
+///                 16-byte headers, which read as 0)
+///
+///   Runs until end of file, each RUN_HEADER_SIZE bytes followed by the
+///   edges
+///     0  uint32   timestamp, ms since the start of the capture
+///     4  uint16   edge count
+///     6  uint16   reserved, 0
+///     8  uint16[] edge durations in microseconds, high first
+///
+/// A run is a burst of edges between quiet periods (or one ring drain on
+/// the device); it is 2-byte aligned whenever the file is.
+struct RF433CaptureHeader {
+  static constexpr char MAGIC[4] = {'R', 'F', '4', 'C'};
+  static constexpr uint16_t VERSION = 1;
+  static constexpr size_t HEADER_SIZE = 20;
+  static constexpr size_t MIN_HEADER_SIZE = 16;  // Before expected frames
+  static constexpr size_t RUN_HEADER_SIZE = 8;
+
+  uint16_t version{VERSION};
+  uint32_t expected_code{0};
+  uint8_t expected_bits{0};
+  uint8_t protocol_hint{0};
+  uint32_t expected_frames{0};
+
+  /// Whether the capture is labelled with the code it should decode to
+  bool has_expected_code() const { return expected_bits > 0; }
+};
+
+/// One run of edges, viewed in place in the capture buffer
+struct RF433CaptureRun {
+  uint32_t timestamp_ms{0};
+  const uint8_t* data{nullptr};  // edge_count little-endian uint16 durations
+  uint16_t edge_count{0};
+
+  LEPulseBytes edges() const { return LEPulseBytes(data, byte_size()); }
+  size_t byte_size() const { return static_cast<size_t>(edge_count) * 2; }
+};
+
+namespace capture_detail {
+
+inline uint16_t read_u16(const uint8_t* p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t read_u32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline void write_u16(uint8_t* p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void write_u32(uint8_t* p, uint32_t v) {
+  write_u16(p, static_cast<uint16_t>(v));
+  write_u16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+
+}  // namespace capture_detail
+
+/// Walks the runs of a capture held in memory, without copying.
+///
+/// The buffer (typically a read-only mmap of the file) must outlive the
+/// reader and every run it returns.
+class RF433CaptureReader {
+ public:
+  /// Parse the header.
+  /// @return false if the magic, version or header size is not usable
+  bool open(const uint8_t* data, size_t len) {
+    data_ = data;
+    len_ = len;
+    pos_ = 0;
+    truncated_ = false;
+
+    using namespace capture_detail;
+    if (len < RF433CaptureHeader::MIN_HEADER_SIZE ||
+        std::memcmp(data, RF433CaptureHeader::MAGIC, 4) != 0) {
+      return false;
+    }
+    header_.version = read_u16(data + 4);
+    uint16_t header_size = read_u16(data + 6);
+    if (header_.version == 0 || header_.version > RF433CaptureHeader::VERSION ||
+        header_size < RF433CaptureHeader::MIN_HEADER_SIZE || header_size > len) {
+      return false;
+    }
+    header_.expected_code = read_u32(data + 8);
+    header_.expected_bits = data[12];
+    header_.protocol_hint = data[13];
+    header_.expected_frames =
+        header_size >= RF433CaptureHeader::HEADER_SIZE ? read_u32(data + 16) : 0;
+
+    start_ = header_size;
+    pos_ = start_;
+    return true;
+  }
+
+  const RF433CaptureHeader& header() const { return header_; }
+
+  /// Advance to the next run.
+  /// @return false at the end of the capture, or if the last run is cut
+  ///         short (see truncated())
+  bool next(RF433CaptureRun& run) {
+    using namespace capture_detail;
+    if (len_ - pos_ < RF433CaptureHeader::RUN_HEADER_SIZE) {
+      truncated_ = pos_ != len_;
+      return false;
+    }
+
+    const uint8_t* p = data_ + pos_;
+    run.timestamp_ms = read_u32(p);
+    run.edge_count = read_u16(p + 4);
+    run.data = p + RF433CaptureHeader::RUN_HEADER_SIZE;
+
+    size_t size = RF433CaptureHeader::RUN_HEADER_SIZE + run.byte_size();
+    if (size > len_ - pos_) {
+      truncated_ = true;
+      return false;
+    }
+    pos_ += size;
+    return true;
+  }
+
+  /// Whether reading stopped on an incomplete run (e.g. a capture still
+  /// being written, or cut off by a full disk)
+  bool truncated() const { return truncated_; }
+
+  /// Start again from the first run
+  void rewind() {
+    pos_ = start_;
+    truncated_ = false;
+  }
+
+ private:
+  RF433CaptureHeader header_;
+  const uint8_t* data_{nullptr};
+  size_t len_{0};
+  size_t start_{0};
+  size_t pos_{0};
+  bool truncated_{false};
+};
+
+/// Serialises a capture through a byte sink.
+///
+/// Sink is any callable `sink(const uint8_t* data, size_t len)`, e.g.
+/// an fwrite() wrapper on the host or a UART/flash writer on the device.
+template <typename Sink>
+class RF433CaptureWriter {
+ public:
+  explicit RF433CaptureWriter(Sink sink) : sink_(sink) {}
+
+  void write_header(const RF433CaptureHeader& header) {
+    using namespace capture_detail;
+    uint8_t buf[RF433CaptureHeader::HEADER_SIZE] = {};
+    std::memcpy(buf, RF433CaptureHeader::MAGIC, 4);
+    write_u16(buf + 4, RF433CaptureHeader::VERSION);
+    write_u16(buf + 6, RF433CaptureHeader::HEADER_SIZE);
+    write_u32(buf + 8, header.expected_code);
+    buf[12] = header.expected_bits;
+    buf[13] = header.protocol_hint;
+    write_u32(buf + 16, header.expected_frames);
+    sink_(buf, sizeof(buf));
+  }
+
+  /// Append edges as one or more runs (runs hold at most 65535 edges)
+  void write_run(uint32_t timestamp_ms, PulseSpan edges) {
+    using namespace capture_detail;
+    do {
+      PulseSpan chunk = edges.subspan(0, UINT16_MAX);
+      uint8_t head[RF433CaptureHeader::RUN_HEADER_SIZE] = {};
+      write_u32(head, timestamp_ms);
+      write_u16(head + 4, static_cast<uint16_t>(chunk.size()));
+      sink_(head, sizeof(head));
+
+      uint8_t buf[64];
+      size_t used = 0;
+      for (uint16_t d : chunk) {
+        write_u16(buf + used, d);
+        used += 2;
+        if (used == sizeof(buf)) {
+          sink_(buf, used);
+          used = 0;
+        }
+      }
+      if (used > 0) {
+        sink_(buf, used);
+      }
+      edges = edges.subspan(chunk.size());
+    } while (!edges.empty());
+  }
+
+ private:
+  Sink sink_;
+};
+
+}  // namespace home_esp
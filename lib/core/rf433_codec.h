@@ -6,6 +6,14 @@
 
 #include "interfaces/i_protocol_codec.h"
 #include "interfaces/i_binary_publisher.h"
+#include "code_router.h"
+#include "gesture_detector.h"
+#include "payload_fields.h"
+#include "pulse_filter.h"
+#include "pulse_ring_buffer.h"
+#include "pulse_span.h"
+#include "repeat_filter.h"
+#include "rf433_decode_stats.h"
 #include <cstring>
 
 namespace home_esp {
@@ -17,6 +25,10 @@ class RF433Codec : public IProtocolCodec {
   // Protocol identifiers
   static constexpr uint8_t PROTOCOL_PT2262 = 1;
   static constexpr uint8_t PROTOCOL_EV1527 = 2;
+  static constexpr uint8_t PROTOCOL_RCSWITCH_2 = 3;
+  static constexpr uint8_t PROTOCOL_RCSWITCH_3 = 4;
+  static constexpr uint8_t PROTOCOL_RCSWITCH_4 = 5;
+  static constexpr uint8_t PROTOCOL_RCSWITCH_5 = 6;
 
   /// Timing configuration for the protocol
   struct TimingConfig {
@@ -38,47 +50,140 @@ class RF433Codec : public IProtocolCodec {
           one_high_pulses(3),
           one_low_pulses(1),
           tolerance_percent(25) {}
+
+    /// Shortest width a pulse of `pulses` base lengths is accepted at
+    uint16_t min_width_us(uint8_t pulses) const {
+      uint16_t expected = pulse_length_us * pulses;
+      return static_cast<uint16_t>(expected - expected * tolerance_percent / 100);
+    }
   };
 
-  explicit RF433Codec(TimingConfig config = TimingConfig()) : config_(config) {}
+  explicit RF433Codec(TimingConfig config = TimingConfig()) : config_(config) {
+    uint8_t multiples[NOMINAL_COUNT] = {
+        config_.sync_high_pulses, config_.sync_low_pulses,
+        config_.zero_high_pulses, config_.zero_low_pulses,
+        config_.one_high_pulses,  config_.one_low_pulses,
+    };
+    for (size_t i = 0; i < NOMINAL_COUNT; ++i) {
+      nominal_[i].us = static_cast<uint16_t>(config_.pulse_length_us * multiples[i]);
+      nominal_[i].scale = RF433DecodeStats::error_scale(nominal_[i].us);
+    }
+  }
 
   bool decode(const uint8_t* data, size_t len, DecodedMessage& out) override {
-    // Simplified decoding: expects raw pulse timings as uint16_t pairs
+    // Raw pulse timings as little-endian uint16_t pairs
     // Format: [high_us, low_us, high_us, low_us, ...]
+    if (len % 4 != 0) {
+      stats_.seen++;
+      return reject(RF433RejectReason::LENGTH, out);
+    }
+    return decode_pulses(LEPulseBytes(data, len), out);
+  }
+
+  bool decode(PulseSpan pulses, DecodedMessage& out) override {
+    return decode_pulses(pulses, out);
+  }
 
-    if (len < 4 || len % 4 != 0) {
-      out.valid = false;
+  bool decode(PulseSpan32 pulses, DecodedMessage& out) override {
+    return decode_pulses(pulses, out);
+  }
+
+  /// Extract every frame from a long capture.
+  ///
+  /// Unlike decode(), the buffer need not start with a sync: it is scanned
+  /// edge by edge for sync pairs, so preamble noise and odd alignment are
+  /// skipped and back-to-back repeats are all returned. Nothing is
+  /// allocated; frames go into the caller's array.
+  ///
+  /// Scanning stops when out is full or at a frame that runs off the end
+  /// of the buffer (it may continue in the next capture, so even a short
+  /// code there waits for more edges). The return value tells the caller
+  /// where to resume. Pass end_of_input once no capture will follow: a
+  /// frame running off the end is then finished with the bits it has,
+  /// as the stream decoder's flush() does.
+  ///
+  /// @param pulses Edge durations, any alignment
+  /// @param out Array receiving decoded frames in order
+  /// @param max_out Capacity of out
+  /// @param found Output: number of frames written to out
+  /// @param end_of_input True if nothing follows these pulses
+  /// @return Pulses consumed; unconsumed pulses should be re-submitted
+  ///         ahead of the next capture
+  size_t decode_all(PulseSpan pulses, DecodedMessage* out, size_t max_out,
+                    size_t& found, bool end_of_input = false) const {
+    return scan_frames(pulses, out, max_out, found, end_of_input);
+  }
+
+  /// decode_all() over the byte format decode() takes
+  /// @param len Length of data in bytes
+  /// @return Bytes consumed
+  size_t decode_all(const uint8_t* data, size_t len, DecodedMessage* out,
+                    size_t max_out, size_t& found, bool end_of_input = false) const {
+    return scan_frames(LEPulseBytes(data, len), out, max_out, found, end_of_input) * 2;
+  }
+
+  bool encode(const DecodedMessage& msg, uint8_t* out, size_t& len) override {
+    size_t count = 0;
+    if (!encode_pulses(msg, MutableLEPulseBytes(out, len), count)) {
       return false;
     }
+    len = count * 2;  // Convert to bytes
+    return true;
+  }
+
+  bool encode(const DecodedMessage& msg, MutablePulseSpan out, size_t& count) override {
+    return encode_pulses(msg, out, count);
+  }
+
+  bool encode(const DecodedMessage& msg, MutablePulseSpan32 out, size_t& count) override {
+    return encode_pulses(msg, out, count);
+  }
+
+  const char* get_protocol_name() const override {
+    return "RF433/PT2262";
+  }
+
+  /// Get timing configuration
+  const TimingConfig& get_config() const { return config_; }
+
+  /// Decode attempts, rejections by reason and, with timing stats on,
+  /// the timing error histogram
+  const RF433DecodeStats& get_stats() const { return stats_; }
+  void reset_stats() { stats_ = RF433DecodeStats(); }
+
+  /// Histogram accepted frames' timing error (off by default: measuring
+  /// every pulse of a frame costs about as much as decoding it)
+  void set_timing_stats(bool enabled) { timing_stats_ = enabled; }
+
+ private:
+  static constexpr uint16_t MIN_BITS = 8;    // Shortest accepted code
+  static constexpr uint16_t MAX_BITS = 24;   // Frame completes at this length
+
+  // The cores below take any pulse view with size() and duration_us(i):
+  // PulseSpan, PulseSpan32 or LEPulseBytes (and set(i, us) for encode,
+  // which computes durations wide enough for either span)
+
+  template <typename Pulses>
+  bool decode_pulses(const Pulses& pulses, DecodedMessage& out) const {
+    stats_.seen++;
 
     // Number of pulse pairs
-    size_t num_pairs = len / 4;
-    if (num_pairs < 2) {  // Need at least sync + 1 bit
-      out.valid = false;
-      return false;
+    size_t num_pairs = pulses.size() / 2;
+    if (pulses.size() % 2 != 0 || num_pairs < 2) {  // Need at least sync + 1 bit
+      return reject(RF433RejectReason::LENGTH, out);
     }
 
-    // Cast to uint16_t pairs
-    const uint16_t* pulses = reinterpret_cast<const uint16_t*>(data);
-
     // Check for sync pulse (first pair)
-    uint16_t sync_high = pulses[0];
-    uint16_t sync_low = pulses[1];
-
-    if (!is_sync_pulse(sync_high, sync_low)) {
-      out.valid = false;
-      return false;
+    if (!is_sync_pulse(pulses.duration_us(0), pulses.duration_us(1))) {
+      return reject(RF433RejectReason::SYNC, out);
     }
 
     // Decode data bits
     uint32_t code = 0;
     uint16_t bits = 0;
 
-    for (size_t i = 1; i < num_pairs && bits < 24; ++i) {
-      uint16_t high_us = pulses[i * 2];
-      uint16_t low_us = pulses[i * 2 + 1];
-
-      int bit = decode_bit(high_us, low_us);
+    for (size_t i = 1; i < num_pairs && bits < MAX_BITS; ++i) {
+      int bit = decode_bit(pulses.duration_us(i * 2), pulses.duration_us(i * 2 + 1));
       if (bit < 0) {
         // Invalid timing, stop decoding
         break;
@@ -88,9 +193,8 @@ class RF433Codec : public IProtocolCodec {
       bits++;
     }
 
-    if (bits < 8) {
-      out.valid = false;
-      return false;
+    if (bits < MIN_BITS) {
+      return reject(RF433RejectReason::BITS, out);
     }
 
     out.code = code;
@@ -98,50 +202,127 @@ class RF433Codec : public IProtocolCodec {
     out.bit_length = bits;
     out.valid = true;
 
+    stats_.accepted++;
+    if (timing_stats_) {
+      record_errors(pulses, 0, code, bits);
+    }
     return true;
   }
 
-  bool encode(const DecodedMessage& msg, uint8_t* out, size_t& len) override {
-    // Calculate required buffer size
-    // Sync + data bits, each as uint16_t pair
-    size_t pairs_needed = 1 + msg.bit_length;  // sync + bits
-    size_t bytes_needed = pairs_needed * 4;    // Each pair is 4 bytes
+  /// @return Pulses consumed (see decode_all())
+  template <typename Pulses>
+  size_t scan_frames(const Pulses& pulses, DecodedMessage* out, size_t max_out,
+                     size_t& found, bool end_of_input) const {
+    size_t count = pulses.size();
+    size_t pos = 0;
+    found = 0;
+
+    while (found < max_out && count - pos >= 4) {
+      if (!is_sync_pulse(pulses.duration_us(pos), pulses.duration_us(pos + 1))) {
+        pos++;
+        continue;
+      }
+
+      // Decode data bits following the sync
+      uint32_t code = 0;
+      uint16_t bits = 0;
+      size_t next = pos + 2;
+      while (bits < MAX_BITS && next + 1 < count) {
+        int bit = decode_bit(pulses.duration_us(next), pulses.duration_us(next + 1));
+        if (bit < 0) {
+          break;
+        }
+        code = (code << 1) | bit;
+        bits++;
+        next += 2;
+      }
+
+      bool ran_off = bits < MAX_BITS && next + 1 >= count;
+      if (ran_off && !end_of_input) {
+        break;  // Ran off the end; frame may continue in the next capture
+      }
+
+      stats_.seen++;
+      if (bits < MIN_BITS) {
+        stats_.reject(ran_off ? RF433RejectReason::LENGTH : RF433RejectReason::BITS);
+        pos++;
+        continue;
+      }
 
-    if (len < bytes_needed) {
+      stats_.accepted++;
+      if (timing_stats_) {
+        record_errors(pulses, pos, code, bits);
+      }
+      DecodedMessage& msg = out[found++];
+      msg.code = code;
+      msg.protocol = PROTOCOL_PT2262;
+      msg.bit_length = bits;
+      msg.valid = true;
+      pos = next;
+    }
+
+    // A tail shorter than sync + one bit is left unconsumed as well
+    return pos;
+  }
+
+  bool reject(RF433RejectReason reason, DecodedMessage& out) const {
+    stats_.reject(reason);
+    out.valid = false;
+    return false;
+  }
+
+  /// Add an accepted frame starting at start to the error histogram
+  template <typename Pulses>
+  void record_errors(const Pulses& pulses, size_t start, uint32_t code,
+                     uint16_t bits) const {
+    uint32_t sum = pulse_error(pulses.duration_us(start), NOMINAL_SYNC_HIGH) +
+                   pulse_error(pulses.duration_us(start + 1), NOMINAL_SYNC_HIGH + 1);
+
+    for (uint16_t i = 0; i < bits; ++i) {
+      size_t symbol = (code >> (bits - 1 - i)) & 1 ? NOMINAL_ONE_HIGH : NOMINAL_ZERO_HIGH;
+      size_t idx = start + 2 + i * 2;
+      sum += pulse_error(pulses.duration_us(idx), symbol) +
+             pulse_error(pulses.duration_us(idx + 1), symbol + 1);
+    }
+    stats_.record_frame_error(sum, (bits + 1) * 2u);
+  }
+
+  uint32_t pulse_error(uint16_t measured_us, size_t nominal) const {
+    return RF433DecodeStats::error_percent(measured_us, nominal_[nominal].us,
+                                           nominal_[nominal].scale);
+  }
+
+  template <typename Pulses>
+  bool encode_pulses(const DecodedMessage& msg, const Pulses& pulses,
+                     size_t& count) const {
+    // Sync + data bits, each as a high/low pair
+    size_t needed = (1 + static_cast<size_t>(msg.bit_length)) * 2;
+    if (pulses.size() < needed) {
       return false;
     }
 
-    uint16_t* pulses = reinterpret_cast<uint16_t*>(out);
     size_t idx = 0;
 
     // Sync pulse
-    pulses[idx++] = config_.pulse_length_us * config_.sync_high_pulses;
-    pulses[idx++] = config_.pulse_length_us * config_.sync_low_pulses;
+    pulses.set(idx++, config_.pulse_length_us * config_.sync_high_pulses);
+    pulses.set(idx++, config_.pulse_length_us * config_.sync_low_pulses);
 
     // Data bits (MSB first)
     for (int i = msg.bit_length - 1; i >= 0; --i) {
       bool bit = (msg.code >> i) & 1;
       if (bit) {
-        pulses[idx++] = config_.pulse_length_us * config_.one_high_pulses;
-        pulses[idx++] = config_.pulse_length_us * config_.one_low_pulses;
+        pulses.set(idx++, config_.pulse_length_us * config_.one_high_pulses);
+        pulses.set(idx++, config_.pulse_length_us * config_.one_low_pulses);
       } else {
-        pulses[idx++] = config_.pulse_length_us * config_.zero_high_pulses;
-        pulses[idx++] = config_.pulse_length_us * config_.zero_low_pulses;
+        pulses.set(idx++, config_.pulse_length_us * config_.zero_high_pulses);
+        pulses.set(idx++, config_.pulse_length_us * config_.zero_low_pulses);
       }
     }
 
-    len = idx * 2;  // Convert to bytes
+    count = idx;
     return true;
   }
 
-  const char* get_protocol_name() const override {
-    return "RF433/PT2262";
-  }
-
-  /// Get timing configuration
-  const TimingConfig& get_config() const { return config_; }
-
- private:
   bool is_sync_pulse(uint16_t high_us, uint16_t low_us) const {
     uint16_t expected_high = config_.pulse_length_us * config_.sync_high_pulses;
     uint16_t expected_low = config_.pulse_length_us * config_.sync_low_pulses;
@@ -177,12 +358,27 @@ class RF433Codec : public IProtocolCodec {
     return actual >= (expected - margin) && actual <= (expected + margin);
   }
 
+  /// Nominal durations (high, then low) of sync, '0' and '1' symbols
+  static constexpr size_t NOMINAL_SYNC_HIGH = 0;
+  static constexpr size_t NOMINAL_ZERO_HIGH = 2;
+  static constexpr size_t NOMINAL_ONE_HIGH = 4;
+  static constexpr size_t NOMINAL_COUNT = 6;
+  struct NominalPulse {
+    uint16_t us;
+    uint32_t scale;  // RF433DecodeStats::error_scale(us)
+  };
+
   TimingConfig config_;
+  NominalPulse nominal_[NOMINAL_COUNT];
+  bool timing_stats_{false};
+  // Mutable so the const decode paths can count
+  mutable RF433DecodeStats stats_;
 };
 
 /// RF433 receiver that decodes signals and publishes events
 class RF433Receiver {
  public:
+  /// @param motion_publisher May be nullptr when only routed codes are used
   RF433Receiver(IProtocolCodec* codec, IBinaryPublisher* motion_publisher)
       : codec_(codec), motion_publisher_(motion_publisher) {}
 
@@ -190,32 +386,230 @@ class RF433Receiver {
   void process_pulses(const uint8_t* data, size_t len) {
     DecodedMessage msg;
     if (codec_->decode(data, len, msg)) {
+      process_message(msg);
+    }
+  }
+
+  /// Act on an already-decoded message (e.g. one of decode_all()'s frames)
+  void process_message(const DecodedMessage& msg) {
+    protocol_frames_[msg.protocol < MAX_PROTOCOL_SLOTS ? msg.protocol : 0]++;
+
+    // Gesture buttons need every repeat to time presses
+    if (gesture_detector_ != nullptr && gesture_detector_->feed(msg)) {
       last_code_ = msg.code;
       last_valid_ = true;
+      return;
+    }
+
+    // Every copy counts as activity, e.g. to re-arm auto-off timers
+    if (frame_router_ != nullptr) {
+      frame_router_->route(msg);
+    }
 
-      // Example: treat certain codes as motion detection
-      if (is_motion_code(msg.code)) {
-        motion_publisher_->publish(true);
+    if (repeat_filter_ != nullptr && !repeat_filter_->accept(msg)) {
+      return;  // Repeat of a published code, or not yet confirmed
+    }
+
+    last_code_ = msg.code;
+    last_valid_ = true;
+
+    // Sensor frames carry readings, not button codes
+    for (size_t i = 0; i < payload_decoder_count_; ++i) {
+      if (payload_decoders_[i]->process(msg)) {
+        return;
       }
     }
+
+    if (router_ != nullptr) {
+      router_->route(msg);
+    }
+
+    // Example: treat certain codes as motion detection
+    if (motion_publisher_ != nullptr && is_motion_code(msg.code)) {
+      motion_publisher_->publish(true);
+    }
+  }
+
+  /// Decode every complete frame waiting in an ISR ring buffer.
+  ///
+  /// Frames are decoded in place from the ring's contiguous read window.
+  /// Scanning stops once fewer pulses remain than a full-length frame,
+  /// since a frame there may still be arriving; those pulses stay in the
+  /// ring for the next call.
+  /// @param flush Decode trailing short frames too (e.g. after RF goes idle)
+  /// @return Number of frames decoded
+  template <size_t Capacity>
+  size_t drain(PulseRingBuffer<Capacity>& ring, bool flush = false) {
+    size_t count = 0;
+    const uint16_t* pulses = ring.read_window(count);
+    size_t pos = 0;
+    size_t frames = 0;
+
+    while (count - pos >= 4) {
+      if (!flush && count - pos < MAX_FRAME_PULSES) {
+        break;  // Possibly truncated; wait for more edges
+      }
+
+      size_t window = (count - pos) & ~static_cast<size_t>(1);
+      DecodedMessage msg;
+
+      if (!codec_->decode(PulseSpan(pulses + pos, window), msg)) {
+        pos++;  // Not a sync at this edge; slide by one to re-align
+        continue;
+      }
+
+      process_message(msg);
+      pos += (1 + static_cast<size_t>(msg.bit_length)) * 2;
+      frames++;
+    }
+
+    if (flush) {
+      pos = count;
+    }
+    ring.consume(pos);
+    return frames;
+  }
+
+  /// Feed one edge duration through a streaming decoder.
+  ///
+  /// Decoder is any type with `bool feed(uint16_t, DecodedMessage&)`,
+  /// e.g. RF433StreamDecoder; the call is resolved at compile time.
+  /// @return true if this edge completed a frame
+  template <typename Decoder>
+  bool process_pulse(Decoder& decoder, uint16_t duration_us) {
+    DecodedMessage msg;
+    if (!decoder.feed(duration_us, msg)) {
+      return false;
+    }
+    process_message(msg);
+    return true;
+  }
+
+  /// Stream every pulse waiting in an ISR ring buffer through a decoder.
+  ///
+  /// Unlike drain(ring), partial frames live in the decoder rather than
+  /// the ring, so all pulses are consumed on every call.
+  /// @return Number of frames decoded
+  template <size_t Capacity, typename Decoder>
+  size_t drain(PulseRingBuffer<Capacity>& ring, Decoder& decoder) {
+    size_t count = 0;
+    const uint16_t* pulses = ring.read_window(count);
+    size_t frames = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+      if (process_pulse(decoder, pulses[i])) {
+        frames++;
+      }
+    }
+
+    ring.consume(count);
+    return frames;
+  }
+
+  /// Stream every pulse waiting in an ISR ring through a pre-filter and
+  /// then a decoder, so glitches and idle noise never reach the decoder.
+  /// @return Number of frames decoded
+  template <size_t Capacity, typename Decoder>
+  size_t drain(PulseRingBuffer<Capacity>& ring, PulseFilter& filter, Decoder& decoder) {
+    size_t count = 0;
+    const uint16_t* pulses = ring.read_window(count);
+    size_t frames = 0;
+    auto sink = [&](uint16_t duration_us) {
+      if (process_pulse(decoder, duration_us)) {
+        frames++;
+      }
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+      filter.feed(pulses[i], sink);
+    }
+
+    ring.consume(count);
+    return frames;
+  }
+
+  /// Release what drain(ring, filter, decoder) still holds once the line
+  /// has gone quiet: the filter's last edge, then a frame pending in the
+  /// decoder. Without it a burst's final frame waits for the next edge.
+  /// @return Number of frames decoded
+  template <typename Decoder>
+  size_t flush(PulseFilter& filter, Decoder& decoder) {
+    size_t frames = 0;
+    filter.flush([&](uint16_t duration_us) {
+      if (process_pulse(decoder, duration_us)) {
+        frames++;
+      }
+    });
+    DecodedMessage msg;
+    if (decoder.flush(msg)) {
+      process_message(msg);
+      frames++;
+    }
+    return frames;
   }
 
   /// Get the last decoded code
   uint32_t get_last_code() const { return last_code_; }
   bool has_valid_code() const { return last_valid_; }
 
+  /// Frames decoded for a protocol id, before repeat filtering
+  /// (ids past the table share slot 0)
+  uint32_t get_protocol_frame_count(uint8_t protocol) const {
+    return protocol_frames_[protocol < MAX_PROTOCOL_SLOTS ? protocol : 0];
+  }
+
   /// Register a code as a motion sensor code
   void register_motion_code(uint32_t code) { motion_code_ = code; }
 
+  /// Filter repeats before publishing (nullptr publishes every frame).
+  /// The caller owns the filter and keeps its clock updated.
+  void set_repeat_filter(RepeatFilter* filter) { repeat_filter_ = filter; }
+
+  /// Publish codes to per-device entities, in addition to the motion code
+  void set_router(const CodeRouter* router) { router_ = router; }
+
+  /// Also route every frame, repeats included, before repeat filtering.
+  /// Its publishers see activity rather than state changes.
+  void set_frame_router(const CodeRouter* router) { frame_router_ = router; }
+
+  /// Recognise single/double/long presses on the detector's codes.
+  /// Their frames bypass the repeat filter, router and motion code.
+  /// The caller owns the detector and keeps its clock updated.
+  void set_gesture_detector(GestureDetector* detector) { gesture_detector_ = detector; }
+
+  /// Decode frames of a sensor type into its field publishers. Decoders
+  /// are tried in the order added; a matching frame is not routed.
+  /// @return false if MAX_PAYLOAD_DECODERS are already registered
+  bool add_payload_decoder(IPayloadDecoder* decoder) {
+    if (payload_decoder_count_ >= MAX_PAYLOAD_DECODERS) {
+      return false;
+    }
+    payload_decoders_[payload_decoder_count_++] = decoder;
+    return true;
+  }
+
+  static constexpr size_t MAX_PAYLOAD_DECODERS = 8;
+
  private:
+  /// Pulses in a sync pair plus the longest code RF433Codec decodes (24 bits)
+  static constexpr size_t MAX_FRAME_PULSES = (1 + 24) * 2;
+  static constexpr size_t MAX_PROTOCOL_SLOTS = 8;
+
   bool is_motion_code(uint32_t code) const {
     return code == motion_code_;
   }
 
   IProtocolCodec* codec_;
   IBinaryPublisher* motion_publisher_;
+  RepeatFilter* repeat_filter_{nullptr};
+  const CodeRouter* router_{nullptr};
+  const CodeRouter* frame_router_{nullptr};
+  GestureDetector* gesture_detector_{nullptr};
+  IPayloadDecoder* payload_decoders_[MAX_PAYLOAD_DECODERS]{};
+  size_t payload_decoder_count_{0};
   uint32_t last_code_{0};
   uint32_t motion_code_{0};
+  uint32_t protocol_frames_[MAX_PROTOCOL_SLOTS]{};
   bool last_valid_{false};
 };
 
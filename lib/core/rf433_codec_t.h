@@ -0,0 +1,179 @@
+#pragma once
+
+// RF433CodecT - Compile-time specialized RF433 codec
+// Pure C++ with no ESPHome dependencies
+// Same wire format as RF433Codec with every tolerance window folded to constants
+
+#include "interfaces/i_protocol_codec.h"
+#include "pulse_span.h"
+#include "rf433_codec.h"
+#include "rf433_stream_decoder.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Compile-time counterpart of RF433Codec::TimingConfig.
+///
+/// Defaults match TimingConfig's defaults (PT2262 at 350us, 25%).
+template <uint16_t PulseLengthUs = 350, uint8_t TolerancePercent = 25,
+          uint8_t SyncHighPulses = 1, uint8_t SyncLowPulses = 31,
+          uint8_t ZeroHighPulses = 1, uint8_t ZeroLowPulses = 3,
+          uint8_t OneHighPulses = 3, uint8_t OneLowPulses = 1>
+struct RF433Timing {
+  static constexpr uint16_t PULSE_LENGTH_US = PulseLengthUs;
+  static constexpr uint8_t TOLERANCE_PERCENT = TolerancePercent;
+  static constexpr uint8_t SYNC_HIGH_PULSES = SyncHighPulses;
+  static constexpr uint8_t SYNC_LOW_PULSES = SyncLowPulses;
+  static constexpr uint8_t ZERO_HIGH_PULSES = ZeroHighPulses;
+  static constexpr uint8_t ZERO_LOW_PULSES = ZeroLowPulses;
+  static constexpr uint8_t ONE_HIGH_PULSES = OneHighPulses;
+  static constexpr uint8_t ONE_LOW_PULSES = OneLowPulses;
+};
+
+/// RF433 codec specialized on a timing known at compile time.
+///
+/// Every expected duration and tolerance window is a constant, so
+/// classifying a pulse is two compares against immediates: no multiply,
+/// no divide (which ESP8266 does in software) and no virtual dispatch.
+/// Decoding rules and output are identical to RF433Codec configured with
+/// timing_config().
+///
+/// @tparam Timing An RF433Timing<...> instantiation
+template <typename Timing = RF433Timing<>>
+class RF433CodecT {
+ public:
+  /// Streaming decoder using this codec's constant windows
+  using StreamDecoder = BasicRF433StreamDecoder<RF433CodecT>;
+
+  /// Equivalent runtime configuration (for RF433Codec or logging)
+  static RF433Codec::TimingConfig timing_config() {
+    RF433Codec::TimingConfig config;
+    config.pulse_length_us = Timing::PULSE_LENGTH_US;
+    config.sync_high_pulses = Timing::SYNC_HIGH_PULSES;
+    config.sync_low_pulses = Timing::SYNC_LOW_PULSES;
+    config.zero_high_pulses = Timing::ZERO_HIGH_PULSES;
+    config.zero_low_pulses = Timing::ZERO_LOW_PULSES;
+    config.one_high_pulses = Timing::ONE_HIGH_PULSES;
+    config.one_low_pulses = Timing::ONE_LOW_PULSES;
+    config.tolerance_percent = Timing::TOLERANCE_PERCENT;
+    return config;
+  }
+
+  /// Decode one sync-aligned frame of [high_us, low_us, ...] durations
+  /// @param pulses Pulse durations, sync pair first
+  /// @param count Number of durations (not pairs)
+  static bool decode(const uint16_t* pulses, size_t count, DecodedMessage& out) {
+    size_t num_pairs = count / 2;
+    if (count % 2 != 0 || num_pairs < 2 ||
+        !is_sync_pulse(pulses[0], pulses[1])) {
+      out.valid = false;
+      return false;
+    }
+
+    uint32_t code = 0;
+    uint16_t bits = 0;
+
+    for (size_t i = 1; i < num_pairs && bits < 24; ++i) {
+      int bit = decode_bit(pulses[i * 2], pulses[i * 2 + 1]);
+      if (bit < 0) {
+        break;
+      }
+      code = (code << 1) | static_cast<uint32_t>(bit);
+      bits++;
+    }
+
+    if (bits < 8) {
+      out.valid = false;
+      return false;
+    }
+
+    out.code = code;
+    out.protocol = RF433Codec::PROTOCOL_PT2262;
+    out.bit_length = bits;
+    out.valid = true;
+    return true;
+  }
+
+  /// decode() over a typed pulse view
+  static bool decode(PulseSpan pulses, DecodedMessage& out) {
+    return decode(pulses.data(), pulses.size(), out);
+  }
+
+  /// Encode a message as [high_us, low_us, ...] durations
+  /// @param count Input: capacity of out in durations, Output: durations written
+  static bool encode(const DecodedMessage& msg, uint16_t* out, size_t& count) {
+    size_t needed = (1 + static_cast<size_t>(msg.bit_length)) * 2;
+    if (count < needed) {
+      return false;
+    }
+
+    size_t idx = 0;
+    out[idx++] = SYNC_HIGH_US;
+    out[idx++] = SYNC_LOW_US;
+
+    for (int i = msg.bit_length - 1; i >= 0; --i) {
+      bool bit = (msg.code >> i) & 1;
+      out[idx++] = bit ? ONE_HIGH_US : ZERO_HIGH_US;
+      out[idx++] = bit ? ONE_LOW_US : ZERO_LOW_US;
+    }
+
+    count = idx;
+    return true;
+  }
+
+  /// encode() into a typed pulse view
+  /// @param count Output: durations written
+  static bool encode(const DecodedMessage& msg, MutablePulseSpan out, size_t& count) {
+    count = out.size();
+    return encode(msg, out.data(), count);
+  }
+
+  static bool is_sync_pulse(uint16_t high_us, uint16_t low_us) {
+    return in_window<SYNC_HIGH_US>(high_us) && in_window<SYNC_LOW_US>(low_us);
+  }
+
+  /// @return 1 or 0 for a data bit, -1 if the pair is neither
+  static int decode_bit(uint16_t high_us, uint16_t low_us) {
+    if (in_window<ONE_HIGH_US>(high_us) && in_window<ONE_LOW_US>(low_us)) {
+      return 1;
+    }
+    if (in_window<ZERO_HIGH_US>(high_us) && in_window<ZERO_LOW_US>(low_us)) {
+      return 0;
+    }
+    return -1;
+  }
+
+  static const char* get_protocol_name() { return "RF433/PT2262"; }
+
+ private:
+  // Expected durations, with the same uint16_t truncation as RF433Codec
+  static constexpr uint16_t SYNC_HIGH_US =
+      static_cast<uint16_t>(Timing::PULSE_LENGTH_US * Timing::SYNC_HIGH_PULSES);
+  static constexpr uint16_t SYNC_LOW_US =
+      static_cast<uint16_t>(Timing::PULSE_LENGTH_US * Timing::SYNC_LOW_PULSES);
+  static constexpr uint16_t ZERO_HIGH_US =
+      static_cast<uint16_t>(Timing::PULSE_LENGTH_US * Timing::ZERO_HIGH_PULSES);
+  static constexpr uint16_t ZERO_LOW_US =
+      static_cast<uint16_t>(Timing::PULSE_LENGTH_US * Timing::ZERO_LOW_PULSES);
+  static constexpr uint16_t ONE_HIGH_US =
+      static_cast<uint16_t>(Timing::PULSE_LENGTH_US * Timing::ONE_HIGH_PULSES);
+  static constexpr uint16_t ONE_LOW_US =
+      static_cast<uint16_t>(Timing::PULSE_LENGTH_US * Timing::ONE_LOW_PULSES);
+
+  static_assert(static_cast<uint32_t>(Timing::PULSE_LENGTH_US) *
+                        Timing::SYNC_LOW_PULSES * (100 + Timing::TOLERANCE_PERCENT) / 100 <=
+                    UINT16_MAX,
+                "RF433Timing sync window does not fit in uint16_t");
+
+  template <uint16_t Expected>
+  static bool in_window(uint16_t actual) {
+    constexpr uint16_t margin =
+        static_cast<uint16_t>(Expected * Timing::TOLERANCE_PERCENT / 100);
+    constexpr uint16_t lo = Expected - margin;
+    constexpr uint16_t hi = Expected + margin;
+    return actual >= lo && actual <= hi;
+  }
+};
+
+}  // namespace home_esp
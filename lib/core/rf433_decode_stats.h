@@ -0,0 +1,112 @@
+#pragma once
+
+// RF433DecodeStats - Frame acceptance and rejection counters
+// Pure C++ with no ESPHome dependencies
+// Plain counters, cheap enough to bump on every decode attempt
+
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Why a decode attempt did not produce a frame
+enum class RF433RejectReason : uint8_t {
+  LENGTH = 0,   // Pulses ran out: no room for a sync and a bit, or frame cut off
+  SYNC = 1,     // First pair outside the sync window
+  BITS = 2,     // Bit timing broke off before the minimum code length
+};
+
+/// Decode counters kept by RF433Codec and the stream decoders.
+///
+/// Counting is one increment per attempt. The timing error histogram is
+/// opt-in (RF433Codec::set_timing_stats(), the stream decoders'
+/// enable_timing_stats()) and filled only for accepted frames, off the
+/// rejection path. It holds one entry per frame: the mean error of the
+/// frame's pulses.
+struct RF433DecodeStats {
+  static constexpr size_t REJECT_REASONS = 3;
+  /// Histogram buckets of 5% each; the last one collects 35% and above
+  static constexpr size_t ERROR_BUCKETS = 8;
+  static constexpr uint8_t ERROR_BUCKET_PERCENT = 5;
+
+  uint32_t seen{0};        // Decode attempts (frames with a sync, for streams)
+  uint32_t accepted{0};    // Frames decoded
+  uint32_t rejected[REJECT_REASONS]{};
+  /// Accepted frames by mean |measured - nominal| / nominal of their pulses
+  uint32_t error_histogram[ERROR_BUCKETS]{};
+  uint32_t error_percent_sum{0};    // Of per-frame means, for mean_error_percent()
+
+  void reject(RF433RejectReason reason) {
+    rejected[static_cast<size_t>(reason)]++;
+  }
+
+  uint32_t rejected_count(RF433RejectReason reason) const {
+    return rejected[static_cast<size_t>(reason)];
+  }
+
+  uint32_t total_rejected() const {
+    uint32_t total = 0;
+    for (uint32_t count : rejected) {
+      total += count;
+    }
+    return total;
+  }
+
+  /// Fixed-point 100/nominal (rounded up, so whole percentages come out
+  /// exact), so error_percent() needs no division
+  static uint32_t error_scale(uint16_t nominal_us) {
+    return nominal_us > 0 ? ((100u << 16) + nominal_us - 1) / nominal_us : 0;
+  }
+
+  /// |measured - nominal| as a percentage of nominal, with
+  /// scale = error_scale(nominal_us)
+  static uint32_t error_percent(uint16_t measured_us, uint16_t nominal_us,
+                                uint32_t scale) {
+    uint32_t diff = measured_us > nominal_us ? measured_us - nominal_us
+                                             : nominal_us - measured_us;
+    return (diff * scale) >> 16;
+  }
+
+  /// Record an accepted frame whose pulses' error_percent() sum to
+  /// percent_sum. One histogram entry per frame keeps the per-pulse
+  /// work in registers.
+  void record_frame_error(uint32_t percent_sum, uint32_t pulses) {
+    if (pulses == 0) {
+      return;
+    }
+    uint32_t percent = percent_sum / pulses;
+    size_t bucket = percent / ERROR_BUCKET_PERCENT;
+    error_histogram[bucket < ERROR_BUCKETS ? bucket : ERROR_BUCKETS - 1]++;
+    error_percent_sum += percent;
+  }
+
+  uint32_t error_samples() const {
+    uint32_t total = 0;
+    for (uint32_t count : error_histogram) {
+      total += count;
+    }
+    return total;
+  }
+
+  /// Mean timing error of accepted frames, or 0 with no samples
+  float mean_error_percent() const {
+    uint32_t samples = error_samples();
+    return samples > 0 ? static_cast<float>(error_percent_sum) / samples : 0.0f;
+  }
+
+  /// Accumulate another source's counters (e.g. codec + stream decoder)
+  RF433DecodeStats& operator+=(const RF433DecodeStats& other) {
+    seen += other.seen;
+    accepted += other.accepted;
+    for (size_t i = 0; i < REJECT_REASONS; ++i) {
+      rejected[i] += other.rejected[i];
+    }
+    for (size_t i = 0; i < ERROR_BUCKETS; ++i) {
+      error_histogram[i] += other.error_histogram[i];
+    }
+    error_percent_sum += other.error_percent_sum;
+    return *this;
+  }
+};
+
+}  // namespace home_esp
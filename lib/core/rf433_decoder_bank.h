@@ -0,0 +1,170 @@
+#pragma once
+
+// RF433DecoderBank - Multi-protocol streaming RF433 decoder
+// Pure C++ with no ESPHome dependencies
+// Advances every candidate protocol in parallel from one pass over the pulses
+
+#include "interfaces/i_protocol_codec.h"
+#include "pulse_classifier.h"
+#include "rf433_protocols.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Streaming decoder for up to 8 RF433 protocols at once.
+///
+/// Each high/low pair is classified once into three bitmasks (bit p set
+/// when the pair is protocol p's sync, '0' or '1') by a PulseClassifier
+/// table lookup, and every protocol's state is then advanced with mask
+/// operations. Adding a protocol costs no extra classification work.
+///
+/// Has the same feed() contract as RF433StreamDecoder, so it can be
+/// passed to RF433Receiver::drain(ring, decoder). When several protocols
+/// complete on the same edge, the message reports the first one in the
+/// order the bank was built with; last_match_mask() has all of them.
+///
+/// @tparam N Number of protocols (1-8)
+template <size_t N>
+class RF433DecoderBank {
+  static_assert(N >= 1 && N <= 8, "RF433DecoderBank supports 1-8 protocols");
+
+ public:
+  /// Build from a descriptor table in priority order, e.g.
+  /// `RF433DecoderBank bank(RF433_PROTOCOLS);`
+  explicit RF433DecoderBank(const RF433Protocol (&protocols)[N])
+      : classifier_(protocols) {
+    for (size_t p = 0; p < N; ++p) {
+      ids_[p] = protocols[p].id;
+      min_bits_[p] = protocols[p].min_bits;
+      max_bits_[p] = protocols[p].max_bits;
+    }
+  }
+
+  /// Feed the next edge duration.
+  /// @return true if this edge completed a frame for any protocol
+  bool feed(uint16_t duration_us, DecodedMessage& out) {
+    if (!have_high_) {
+      pending_high_ = duration_us;
+      have_high_ = true;
+      return false;
+    }
+
+    uint16_t high_us = pending_high_;
+    uint16_t low_us = duration_us;
+    have_high_ = false;
+
+    auto mask = classifier_.classify(high_us, low_us);
+    return advance(low_us, static_cast<uint8_t>(Classifier::sync_bits(mask)),
+                   static_cast<uint8_t>(Classifier::zero_bits(mask)),
+                   static_cast<uint8_t>(Classifier::one_bits(mask)), out);
+  }
+
+  /// Emit the highest-priority pending frame, e.g. once RF goes quiet
+  /// @return true if any protocol had at least min_bits pending
+  bool flush(DecodedMessage& out) {
+    uint8_t completed = 0;
+    for (size_t p = 0; p < N; ++p) {
+      if ((active_ & (1u << p)) && bits_[p] >= min_bits_[p]) {
+        completed |= static_cast<uint8_t>(1u << p);
+      }
+    }
+    bool emitted = emit(completed, out);
+    reset();
+    return emitted;
+  }
+
+  /// Drop all partial frames and pulse alignment
+  void reset() {
+    active_ = 0;
+    have_high_ = false;
+  }
+
+  /// Protocols that completed on the edge that last returned true
+  uint8_t last_match_mask() const { return match_mask_; }
+
+  /// Protocols currently collecting bits
+  uint8_t active_mask() const { return active_; }
+
+  static constexpr size_t size() { return N; }
+
+ private:
+  using Classifier = PulseClassifier<N>;
+
+  bool advance(uint16_t low_us, uint8_t sync, uint8_t zero, uint8_t one,
+               DecodedMessage& out) {
+    uint8_t active = active_;
+    // A pair matching both symbols counts as '1', as in RF433Codec
+    uint8_t ones = active & one;
+    uint8_t zeros = active & zero & static_cast<uint8_t>(~ones);
+    uint8_t shifted = ones | zeros;
+    uint8_t ended = active & static_cast<uint8_t>(~shifted);
+    uint8_t completed = 0;
+
+    for (size_t p = 0; p < N; ++p) {
+      uint8_t bit = static_cast<uint8_t>(1u << p);
+      if (shifted & bit) {
+        code_[p] = (code_[p] << 1) | ((ones & bit) ? 1u : 0u);
+        if (++bits_[p] >= max_bits_[p]) {
+          completed |= bit;
+        }
+      } else if ((ended & bit) && bits_[p] >= min_bits_[p]) {
+        completed |= bit;
+      }
+    }
+
+    active_ = active & shifted & static_cast<uint8_t>(~completed);
+    // Before the starts below: the sync that ends a frame may restart it
+    bool emitted = emit(completed, out);
+
+    // Idle protocols (including ones that just ended) may start a frame
+    uint8_t starts = sync & static_cast<uint8_t>(~active_);
+    for (size_t p = 0; p < N; ++p) {
+      if (starts & (1u << p)) {
+        code_[p] = 0;
+        bits_[p] = 0;
+      }
+    }
+    active_ |= starts;
+
+    if ((shifted | starts) == 0) {
+      // Nobody used this pair; slide by one edge in case of misalignment
+      pending_high_ = low_us;
+      have_high_ = true;
+    }
+
+    return emitted;
+  }
+
+  bool emit(uint8_t completed, DecodedMessage& out) {
+    if (completed == 0) {
+      return false;
+    }
+
+    size_t p = 0;
+    while (!(completed & (1u << p))) {
+      p++;
+    }
+
+    out.code = code_[p];
+    out.protocol = ids_[p];
+    out.bit_length = bits_[p];
+    out.valid = true;
+    match_mask_ = completed;
+    return true;
+  }
+
+  Classifier classifier_;
+  uint8_t ids_[N];
+  uint8_t min_bits_[N];
+  uint8_t max_bits_[N];
+
+  uint32_t code_[N]{};
+  uint8_t bits_[N]{};
+  uint8_t active_{0};
+  uint8_t match_mask_{0};
+  uint16_t pending_high_{0};
+  bool have_high_{false};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,173 @@
+#pragma once
+
+// RF433ProfileDecoder - Stream decoder with learned timing profiles
+// Pure C++ with no ESPHome dependencies
+// Hands each frame to the one decoder whose sync window it matches
+
+#include "rf433_codec.h"
+#include "rf433_decode_stats.h"
+#include "rf433_stream_decoder.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Stream decoder for a configured timing plus up to MaxProfiles learned
+/// ones.
+///
+/// Frames are dispatched on their sync pair: a pair inside a learned
+/// profile's sync window starts a frame on that profile's decoder (the
+/// lowest slot wins), any other pair goes to the primary decoder. The
+/// rest of the frame is fed to that decoder alone, so a learned remote is
+/// decoded with its own windows instead of the primary's wider ones, and
+/// inside a frame an edge costs one feed() however many profiles there
+/// are. Between frames an edge costs the primary's feed() plus a sync
+/// check per profile.
+///
+/// Each frame is counted only by the decoder that took it, so stats()
+/// holds one outcome per frame. With no profiles set it decodes exactly
+/// like the primary.
+///
+/// @tparam Primary Decoder for the configured timing, a
+///         BasicRF433StreamDecoder such as RF433StreamDecoder
+/// @tparam MaxProfiles Learned profile slots
+template <typename Primary = RF433StreamDecoder, size_t MaxProfiles = 4>
+class RF433ProfileDecoder {
+ public:
+  explicit RF433ProfileDecoder(Primary primary = Primary()) : primary_(primary) {}
+
+  /// Decode remotes whose sync matches timing with their own windows.
+  /// Replaces the slot's previous profile, keeping its counts in stats().
+  /// @return false if slot is out of range or would leave a gap
+  bool set_profile(size_t slot, const RF433Codec::TimingConfig& timing) {
+    if (slot >= MaxProfiles || slot > count_) {
+      return false;
+    }
+    reset();
+    retired_stats_ += decoders_[slot].stats();
+    profiles_[slot] = timing;
+    windows_[slot] = RF433TimingWindows(timing);
+    decoders_[slot] = RF433StreamDecoder(timing);
+    if (timing_stats_) {
+      decoders_[slot].enable_timing_stats(timing);
+    }
+    count_ = slot < count_ ? count_ : slot + 1;
+    return true;
+  }
+
+  size_t profile_count() const { return count_; }
+  const RF433Codec::TimingConfig& profile(size_t slot) const { return profiles_[slot]; }
+
+  /// Feed the next edge duration.
+  /// @param duration_us Pulse width in microseconds
+  /// @param out Set to the decoded message when a frame completes
+  /// @return true if this edge completed a frame
+  bool feed(uint16_t duration_us, DecodedMessage& out) {
+    if (owner_ < count_) {
+      return feed_profile(duration_us, out);
+    }
+
+    // The primary pairs each edge with the one before it until it is in
+    // a frame; a learned sync on such a pair takes the frame instead
+    if (primary_.awaiting_low()) {
+      for (size_t i = 0; i < count_; ++i) {
+        if (windows_[i].is_sync_pulse(last_us_, duration_us)) {
+          // A sync pair is never a bit, so it would end the primary's frame
+          bool emitted = primary_.in_frame() && primary_.flush(out);
+          primary_.reset();
+          owner_ = i;
+          DecodedMessage unused;
+          decoders_[i].reset();
+          decoders_[i].feed(last_us_, unused);
+          decoders_[i].feed(duration_us, unused);
+          return emitted;
+        }
+      }
+    }
+    last_us_ = duration_us;
+    return primary_.feed(duration_us, out);
+  }
+
+  /// Emit a pending short frame, e.g. once the channel has gone quiet.
+  /// @return true if a frame with at least min_bits was pending
+  bool flush(DecodedMessage& out) {
+    bool emitted = owner_ < count_ ? decoders_[owner_].flush(out) : primary_.flush(out);
+    reset();
+    return emitted;
+  }
+
+  /// Drop any partial frame and pulse alignment
+  void reset() {
+    primary_.reset();
+    for (size_t i = 0; i < count_; ++i) {
+      decoders_[i].reset();
+    }
+    owner_ = NO_OWNER;
+  }
+
+  /// Whether a sync has been seen and bits are being collected
+  bool in_frame() const { return owner_ < count_ || primary_.in_frame(); }
+
+  /// Histogram timing error and count SYNC rejects, for the primary
+  /// against primary_timing and for each profile against its own
+  void enable_timing_stats(const RF433Codec::TimingConfig& primary_timing) {
+    primary_.enable_timing_stats(primary_timing);
+    for (size_t i = 0; i < count_; ++i) {
+      decoders_[i].enable_timing_stats(profiles_[i]);
+    }
+    timing_stats_ = true;
+  }
+
+  /// Counters of every decoder, each frame counted once
+  RF433DecodeStats stats() const {
+    RF433DecodeStats stats = primary_.stats();
+    stats += retired_stats_;
+    for (size_t i = 0; i < count_; ++i) {
+      stats += decoders_[i].stats();
+    }
+    return stats;
+  }
+
+  void reset_stats() {
+    primary_.reset_stats();
+    retired_stats_ = RF433DecodeStats();
+    for (size_t i = 0; i < count_; ++i) {
+      decoders_[i].reset_stats();
+    }
+  }
+
+  const Primary& primary() const { return primary_; }
+
+ private:
+  static constexpr size_t NO_OWNER = MaxProfiles;
+
+  bool feed_profile(uint16_t duration_us, DecodedMessage& out) {
+    RF433StreamDecoder& decoder = decoders_[owner_];
+    bool emitted = decoder.feed(duration_us, out);
+    if (decoder.in_frame()) {
+      return emitted;
+    }
+    // Frame over: back to the primary, aligned as the profile left off
+    owner_ = NO_OWNER;
+    primary_.reset();
+    if (decoder.awaiting_low()) {
+      DecodedMessage unused;
+      primary_.feed(duration_us, unused);
+      last_us_ = duration_us;
+    }
+    decoder.reset();
+    return emitted;
+  }
+
+  Primary primary_;
+  RF433Codec::TimingConfig profiles_[MaxProfiles];
+  RF433TimingWindows windows_[MaxProfiles];
+  RF433StreamDecoder decoders_[MaxProfiles];
+  RF433DecodeStats retired_stats_;
+  size_t count_{0};
+  size_t owner_{NO_OWNER};
+  uint16_t last_us_{0};
+  bool timing_stats_{false};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,94 @@
+#pragma once
+
+// RF433 protocol descriptors
+// Pure C++ with no ESPHome dependencies
+// Constexpr timing tables for the fixed-code remotes we decode
+
+#include "rf433_codec.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Timing description of one fixed-code RF433 protocol.
+///
+/// Symbol lengths are multiples of pulse_length_us, as in
+/// RF433Codec::TimingConfig. Frames start with a sync pair followed by
+/// min_bits..max_bits data bits, MSB first.
+struct RF433Protocol {
+  uint8_t id;                  // DecodedMessage::protocol value
+  const char* name;            // For logging
+  uint16_t pulse_length_us;    // Base pulse length in microseconds
+  uint8_t sync_high_pulses;    // Number of high pulses in sync
+  uint8_t sync_low_pulses;     // Number of low pulses in sync
+  uint8_t zero_high_pulses;    // High pulses for '0' bit
+  uint8_t zero_low_pulses;     // Low pulses for '0' bit
+  uint8_t one_high_pulses;     // High pulses for '1' bit
+  uint8_t one_low_pulses;      // Low pulses for '1' bit
+  uint8_t tolerance_percent;   // Timing tolerance
+  uint8_t min_bits;            // Shortest accepted code
+  uint8_t max_bits;            // Frame completes at this many bits
+
+  /// Timing in the form RF433Codec and RF433StreamDecoder take
+  RF433Codec::TimingConfig to_timing_config() const {
+    RF433Codec::TimingConfig config;
+    config.pulse_length_us = pulse_length_us;
+    config.sync_high_pulses = sync_high_pulses;
+    config.sync_low_pulses = sync_low_pulses;
+    config.zero_high_pulses = zero_high_pulses;
+    config.zero_low_pulses = zero_low_pulses;
+    config.one_high_pulses = one_high_pulses;
+    config.one_low_pulses = one_low_pulses;
+    config.tolerance_percent = tolerance_percent;
+    return config;
+  }
+};
+
+/// PT2262 and clones; same acceptance rules as RF433Codec's defaults
+inline constexpr RF433Protocol RF433_PROTOCOL_PT2262{
+    RF433Codec::PROTOCOL_PT2262, "PT2262", 350, 1, 31, 1, 3, 3, 1, 25, 8, 24};
+
+/// EV1527 learning-code encoders: PT2262 symbols, always 20+4 bits
+inline constexpr RF433Protocol RF433_PROTOCOL_EV1527{
+    RF433Codec::PROTOCOL_EV1527, "EV1527", 350, 1, 31, 1, 3, 3, 1, 25, 24, 24};
+
+/// rc-switch protocol 2
+inline constexpr RF433Protocol RF433_PROTOCOL_RCSWITCH_2{
+    RF433Codec::PROTOCOL_RCSWITCH_2, "RCSwitch-2", 650, 1, 10, 1, 2, 2, 1, 25, 8, 24};
+
+/// rc-switch protocol 3. Its sync is nearly identical to protocol 5's,
+/// so both use a tighter tolerance to keep their data symbols apart.
+inline constexpr RF433Protocol RF433_PROTOCOL_RCSWITCH_3{
+    RF433Codec::PROTOCOL_RCSWITCH_3, "RCSwitch-3", 100, 30, 71, 4, 11, 9, 6, 15, 8, 24};
+
+/// rc-switch protocol 4
+inline constexpr RF433Protocol RF433_PROTOCOL_RCSWITCH_4{
+    RF433Codec::PROTOCOL_RCSWITCH_4, "RCSwitch-4", 380, 1, 6, 1, 3, 3, 1, 25, 8, 24};
+
+/// rc-switch protocol 5
+inline constexpr RF433Protocol RF433_PROTOCOL_RCSWITCH_5{
+    RF433Codec::PROTOCOL_RCSWITCH_5, "RCSwitch-5", 500, 6, 14, 1, 2, 2, 1, 15, 8, 24};
+
+/// Every known protocol, in match priority order. Protocols whose
+/// symbols overlap (PT2262/EV1527) resolve to the earlier entry; build a
+/// bank from a reordered subset to prefer another.
+inline constexpr RF433Protocol RF433_PROTOCOLS[] = {
+    RF433_PROTOCOL_PT2262,     RF433_PROTOCOL_EV1527,     RF433_PROTOCOL_RCSWITCH_2,
+    RF433_PROTOCOL_RCSWITCH_3, RF433_PROTOCOL_RCSWITCH_4, RF433_PROTOCOL_RCSWITCH_5,
+};
+
+inline constexpr size_t RF433_PROTOCOL_COUNT =
+    sizeof(RF433_PROTOCOLS) / sizeof(RF433_PROTOCOLS[0]);
+
+/// Look up a descriptor by DecodedMessage::protocol id
+/// @return nullptr if the id is unknown
+inline const RF433Protocol* find_rf433_protocol(uint8_t id) {
+  for (const auto& protocol : RF433_PROTOCOLS) {
+    if (protocol.id == id) {
+      return &protocol;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace home_esp
@@ -0,0 +1,271 @@
+#pragma once
+
+// RF433StreamDecoder - Incremental pulse-by-pulse RF433 decoder
+// Pure C++ with no ESPHome dependencies
+// Decodes the same frames as RF433Codec, one edge duration at a time
+
+#include "rf433_codec.h"
+#include "rf433_decode_stats.h"
+#include <cstdint>
+
+namespace home_esp {
+
+/// Tolerance windows for one TimingConfig, computed once.
+///
+/// Classifies a high/low pair exactly like RF433Codec's private helpers,
+/// without redoing the multiply and divide for every pulse.
+class RF433TimingWindows {
+ public:
+  using TimingConfig = RF433Codec::TimingConfig;
+
+  // Implicit so RF433StreamDecoder can be constructed from a TimingConfig
+  RF433TimingWindows(TimingConfig config = TimingConfig())
+      : sync_high_(window(config, config.sync_high_pulses)),
+        sync_low_(window(config, config.sync_low_pulses)),
+        zero_high_(window(config, config.zero_high_pulses)),
+        zero_low_(window(config, config.zero_low_pulses)),
+        one_high_(window(config, config.one_high_pulses)),
+        one_low_(window(config, config.one_low_pulses)) {}
+
+  bool is_sync_pulse(uint16_t high_us, uint16_t low_us) const {
+    return sync_high_.contains(high_us) && sync_low_.contains(low_us);
+  }
+
+  /// @return 1 or 0 for a data bit, -1 if the pair is neither
+  int decode_bit(uint16_t high_us, uint16_t low_us) const {
+    if (one_high_.contains(high_us) && one_low_.contains(low_us)) {
+      return 1;
+    }
+    if (zero_high_.contains(high_us) && zero_low_.contains(low_us)) {
+      return 0;
+    }
+    return -1;
+  }
+
+ private:
+  /// Inclusive [min, max] acceptance range for one pulse
+  struct Window {
+    uint16_t min;
+    uint16_t max;
+
+    bool contains(uint16_t value) const {
+      return value >= min && value <= max;
+    }
+  };
+
+  static Window window(const TimingConfig& config, uint8_t pulses) {
+    // Same arithmetic as RF433Codec::is_within_tolerance()
+    uint16_t expected = config.pulse_length_us * pulses;
+    uint16_t margin = expected * config.tolerance_percent / 100;
+    return Window{static_cast<uint16_t>(expected - margin),
+                  static_cast<uint16_t>(expected + margin)};
+  }
+
+  Window sync_high_;
+  Window sync_low_;
+  Window zero_high_;
+  Window zero_low_;
+  Window one_high_;
+  Window one_low_;
+};
+
+/// Streaming counterpart to RF433Codec::decode().
+///
+/// Fed one edge duration per call (high, low, high, low, ...), it keeps
+/// only the current partial code, so no frame buffer is needed and a
+/// message is available from the same call that delivers the last edge.
+///
+/// Frames are accepted under the same rules as RF433Codec: a sync pair,
+/// then bits until an invalid pair or max_bits, with at least min_bits.
+///
+/// Frames are counted as they start and end; a frame that ends short is a
+/// BITS reject, or LENGTH if flush() cut it off. Symbols only classify
+/// pairs, so the timing error histogram and SYNC rejects (a sync-length
+/// gap outside the sync window) need the nominal widths: pass the timing
+/// the symbols were built from to enable_timing_stats(). Until then the
+/// per-pair cost is a not-taken branch.
+///
+/// @tparam Symbols Pair classifier providing is_sync_pulse(high, low) and
+///         decode_bit(high, low), e.g. RF433TimingWindows
+template <typename Symbols>
+class BasicRF433StreamDecoder {
+ public:
+  explicit BasicRF433StreamDecoder(Symbols symbols = Symbols(),
+                                   uint8_t max_bits = 24, uint8_t min_bits = 8)
+      : symbols_(symbols), max_bits_(max_bits), min_bits_(min_bits) {}
+
+  /// Feed the next edge duration.
+  /// @param duration_us Pulse width in microseconds
+  /// @param out Set to the decoded message when a frame completes
+  /// @return true if this edge completed a frame
+  bool feed(uint16_t duration_us, DecodedMessage& out) {
+    if (!have_high_) {
+      pending_high_ = duration_us;
+      have_high_ = true;
+      return false;
+    }
+
+    uint16_t high_us = pending_high_;
+    uint16_t low_us = duration_us;
+    have_high_ = false;
+
+    if (in_frame_) {
+      int bit = symbols_.decode_bit(high_us, low_us);
+      if (bit >= 0) {
+        if (timing_stats_) {
+          size_t symbol = bit ? NOMINAL_ONE_HIGH : NOMINAL_ZERO_HIGH;
+          error_sum_ += pulse_error(high_us, symbol) + pulse_error(low_us, symbol + 1);
+        }
+        return push_bit(static_cast<uint32_t>(bit), out);
+      }
+
+      // Frame ended on a non-bit pair; it may be the next frame's sync
+      bool emitted = finish_frame(out);
+      if (!try_start_frame(high_us, low_us)) {
+        pending_high_ = low_us;
+        have_high_ = true;
+      }
+      return emitted;
+    }
+
+    if (!try_start_frame(high_us, low_us)) {
+      // Not a sync; slide by one edge in case we are misaligned
+      pending_high_ = low_us;
+      have_high_ = true;
+    }
+    return false;
+  }
+
+  /// Emit a pending short frame, e.g. once the channel has gone quiet.
+  /// @return true if a frame with at least min_bits was pending
+  bool flush(DecodedMessage& out) {
+    bool emitted = false;
+    if (in_frame_ && bits_ < min_bits_) {
+      stats_.reject(RF433RejectReason::LENGTH);
+    } else if (in_frame_) {
+      emitted = finish_frame(out);
+    }
+    reset();
+    return emitted;
+  }
+
+  /// Drop any partial frame and pulse alignment
+  void reset() {
+    in_frame_ = false;
+    have_high_ = false;
+    code_ = 0;
+    bits_ = 0;
+  }
+
+  /// Whether a sync has been seen and bits are being collected
+  bool in_frame() const { return in_frame_; }
+
+  /// Whether the last edge is held as a high, so the next one completes
+  /// a pair with it
+  bool awaiting_low() const { return have_high_; }
+
+  /// Also histogram accepted frames' timing error and count SYNC rejects,
+  /// against the nominal widths of timing (the one the symbols decode)
+  void enable_timing_stats(const RF433Codec::TimingConfig& timing) {
+    uint8_t multiples[NOMINAL_COUNT] = {
+        timing.sync_high_pulses, timing.sync_low_pulses,
+        timing.zero_high_pulses, timing.zero_low_pulses,
+        timing.one_high_pulses,  timing.one_low_pulses,
+    };
+    for (size_t i = 0; i < NOMINAL_COUNT; ++i) {
+      nominal_us_[i] = static_cast<uint16_t>(timing.pulse_length_us * multiples[i]);
+      nominal_scale_[i] = RF433DecodeStats::error_scale(nominal_us_[i]);
+    }
+    // Half the sync low: far above any data low, well inside a weak sync
+    min_sync_gap_us_ = nominal_us_[NOMINAL_SYNC_HIGH + 1] / 2u;
+    timing_stats_ = true;
+  }
+
+  /// Frames started (seen), emitted (accepted) and ended short (BITS, or
+  /// LENGTH when flushed), plus SYNC rejects and timing error once
+  /// enable_timing_stats() is called
+  const RF433DecodeStats& stats() const { return stats_; }
+  void reset_stats() { stats_ = RF433DecodeStats(); }
+
+ private:
+  static constexpr size_t NOMINAL_SYNC_HIGH = 0;
+  static constexpr size_t NOMINAL_ZERO_HIGH = 2;
+  static constexpr size_t NOMINAL_ONE_HIGH = 4;
+  static constexpr size_t NOMINAL_COUNT = 6;
+
+  bool try_start_frame(uint16_t high_us, uint16_t low_us) {
+    if (!symbols_.is_sync_pulse(high_us, low_us)) {
+      if (low_us >= min_sync_gap_us_) {
+        // A sync gap with timing outside the window
+        stats_.seen++;
+        stats_.reject(RF433RejectReason::SYNC);
+      }
+      return false;
+    }
+    in_frame_ = true;
+    stats_.seen++;
+    code_ = 0;
+    bits_ = 0;
+    if (timing_stats_) {
+      error_sum_ = pulse_error(high_us, NOMINAL_SYNC_HIGH) +
+                   pulse_error(low_us, NOMINAL_SYNC_HIGH + 1);
+    }
+    return true;
+  }
+
+  uint32_t pulse_error(uint16_t measured_us, size_t nominal) const {
+    return RF433DecodeStats::error_percent(measured_us, nominal_us_[nominal],
+                                           nominal_scale_[nominal]);
+  }
+
+  bool push_bit(uint32_t bit, DecodedMessage& out) {
+    code_ = (code_ << 1) | bit;
+    bits_++;
+    if (bits_ < max_bits_) {
+      return false;
+    }
+    return finish_frame(out);
+  }
+
+  bool finish_frame(DecodedMessage& out) {
+    in_frame_ = false;
+    if (bits_ < min_bits_) {
+      stats_.reject(RF433RejectReason::BITS);
+      return false;
+    }
+    stats_.accepted++;
+    if (timing_stats_) {
+      stats_.record_frame_error(error_sum_, 2 + 2u * bits_);
+    }
+
+    out.code = code_;
+    out.protocol = RF433Codec::PROTOCOL_PT2262;
+    out.bit_length = bits_;
+    out.valid = true;
+    return true;
+  }
+
+  Symbols symbols_;
+  RF433DecodeStats stats_;
+  uint8_t max_bits_;
+  uint8_t min_bits_;
+
+  uint32_t code_{0};
+  uint16_t pending_high_{0};
+  uint8_t bits_{0};
+  bool have_high_{false};
+  bool in_frame_{false};
+
+  // Timing stats, off until enable_timing_stats(); the default gap is
+  // above any uint16_t, so no SYNC rejects are counted
+  bool timing_stats_{false};
+  uint32_t min_sync_gap_us_{UINT16_MAX + 1u};
+  uint32_t error_sum_{0};
+  uint16_t nominal_us_[NOMINAL_COUNT]{};
+  uint32_t nominal_scale_[NOMINAL_COUNT]{};
+};
+
+/// Stream decoder for a TimingConfig chosen at runtime
+using RF433StreamDecoder = BasicRF433StreamDecoder<RF433TimingWindows>;
+
+}  // namespace home_esp
@@ -0,0 +1,248 @@
+#pragma once
+
+// RmtWaveform - RF433 transmit waveforms in ESP32 RMT item layout
+// Pure C++ with no ESPHome dependencies
+// Builds rmt_item32_t-compatible buffers once and replays them from a cache
+
+#include "interfaces/i_protocol_codec.h"
+#include "rf433_codec.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// One RMT item: two (duration, level) halves packed as the ESP32 RMT
+/// peripheral reads them (rmt_item32_t / rmt_symbol_word_t):
+/// duration0:15, level0:1, duration1:15, level1:1, LSB first.
+///
+/// Plain uint32_t so buffers can be handed to the driver as-is on any
+/// compiler; bitfield order is implementation-defined.
+struct RmtItem {
+  uint32_t val{0};
+
+  static constexpr uint16_t MAX_DURATION = 0x7FFF;
+
+  static constexpr RmtItem make(uint16_t duration0, bool level0, uint16_t duration1,
+                                bool level1) {
+    return RmtItem{static_cast<uint32_t>(duration0 & MAX_DURATION) |
+                   (static_cast<uint32_t>(level0) << 15) |
+                   (static_cast<uint32_t>(duration1 & MAX_DURATION) << 16) |
+                   (static_cast<uint32_t>(level1) << 31)};
+  }
+
+  constexpr uint16_t duration0() const { return val & MAX_DURATION; }
+  constexpr bool level0() const { return (val >> 15) & 1; }
+  constexpr uint16_t duration1() const { return (val >> 16) & MAX_DURATION; }
+  constexpr bool level1() const { return val >> 31; }
+
+  constexpr bool operator==(const RmtItem& other) const { return val == other.val; }
+};
+
+static_assert(sizeof(RmtItem) == 4, "RmtItem must match rmt_item32_t");
+
+/// Encodes RF433Codec frames straight into RMT items.
+///
+/// Every high/low pair of the codec's wire format is exactly one item, so
+/// the three symbols (sync, '0', '1') are built once in the constructor
+/// and encoding is a copy per bit with no multiplication. The frame is
+/// written repeats times back to back, as remotes send it, followed by an
+/// optional zero end marker.
+class RmtWaveformEncoder {
+ public:
+  /// Configuration for the RMT channel
+  struct Config {
+    uint8_t ticks_per_us;   // RMT tick rate (80 MHz APB / clk_div 80 = 1)
+    bool end_marker;        // Append a zero item (legacy rmt_write_items)
+
+    Config()
+        : ticks_per_us(1),
+          end_marker(true) {}
+  };
+
+  explicit RmtWaveformEncoder(
+      const RF433Codec::TimingConfig& t = RF433Codec::TimingConfig(),
+      Config config = Config())
+      : config_(config) {
+    valid_ = build(t.sync_high_pulses, t.sync_low_pulses, t.pulse_length_us, sync_) &&
+             build(t.zero_high_pulses, t.zero_low_pulses, t.pulse_length_us, symbol_[0]) &&
+             build(t.one_high_pulses, t.one_low_pulses, t.pulse_length_us, symbol_[1]);
+  }
+
+  /// Items needed for a frame of bit_length bits sent repeats times
+  size_t items_needed(uint16_t bit_length, uint8_t repeats) const {
+    return (1 + static_cast<size_t>(bit_length)) * repeats + (config_.end_marker ? 1 : 0);
+  }
+
+  /// Encode msg repeats times into out.
+  /// @param out Caller-owned item buffer
+  /// @param capacity Size of out in items
+  /// @param count Output: items written, including the end marker
+  /// @return false if out is too small, repeats is 0 or a symbol does not
+  ///         fit the 15-bit RMT duration
+  bool encode(const DecodedMessage& msg, uint8_t repeats, RmtItem* out, size_t capacity,
+              size_t& count) const {
+    if (!valid_ || repeats == 0 || msg.bit_length == 0 || msg.bit_length > 32) {
+      return false;
+    }
+    size_t needed = items_needed(msg.bit_length, repeats);
+    if (capacity < needed) {
+      return false;
+    }
+
+    size_t frame = 1 + msg.bit_length;
+    out[0] = sync_;
+    for (int i = msg.bit_length - 1, idx = 1; i >= 0; --i, ++idx) {
+      out[idx] = symbol_[(msg.code >> i) & 1];
+    }
+    for (uint8_t r = 1; r < repeats; ++r) {
+      for (size_t i = 0; i < frame; ++i) {
+        out[r * frame + i] = out[i];
+      }
+    }
+    if (config_.end_marker) {
+      out[needed - 1] = RmtItem();
+    }
+    count = needed;
+    return true;
+  }
+
+  /// Whether the timing fits RMT items at this tick rate
+  bool is_valid() const { return valid_; }
+
+  const Config& get_config() const { return config_; }
+
+ private:
+  bool build(uint8_t high_pulses, uint8_t low_pulses, uint16_t pulse_us, RmtItem& item) const {
+    uint32_t high = uint32_t{pulse_us} * high_pulses * config_.ticks_per_us;
+    uint32_t low = uint32_t{pulse_us} * low_pulses * config_.ticks_per_us;
+    if (high == 0 || low == 0 || high > RmtItem::MAX_DURATION || low > RmtItem::MAX_DURATION) {
+      return false;
+    }
+    item = RmtItem::make(static_cast<uint16_t>(high), true, static_cast<uint16_t>(low), false);
+    return true;
+  }
+
+  Config config_;
+  RmtItem sync_;
+  RmtItem symbol_[2];  // Indexed by bit value
+  bool valid_{false};
+};
+
+/// Replays an RMT buffer as edge durations in microseconds, high first,
+/// through sink(uint16_t) - the same convention as PulseFilter and
+/// OokDemodulator, so the output can feed a decoder or be compared with
+/// RF433Codec::encode. Stops at the first zero duration (end marker).
+/// @return Durations emitted
+template <typename Sink>
+size_t replay_rmt_items(const RmtItem* items, size_t count, Sink&& sink,
+                        uint8_t ticks_per_us = 1) {
+  size_t emitted = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (items[i].duration0() == 0) {
+      break;
+    }
+    sink(static_cast<uint16_t>(items[i].duration0() / ticks_per_us));
+    emitted++;
+    if (items[i].duration1() == 0) {
+      break;
+    }
+    sink(static_cast<uint16_t>(items[i].duration1() / ticks_per_us));
+    emitted++;
+  }
+  return emitted;
+}
+
+/// Prebuilt waveforms for recently sent codes.
+///
+/// Holds SLOTS buffers of MAX_ITEMS items each, statically sized. A hit
+/// returns a pointer into the cache that can go to the RMT driver
+/// without copying or recomputing; a miss encodes into the least
+/// recently used slot. Slots are keyed on code, bit length, protocol and
+/// repeat count.
+///
+/// @tparam SLOTS Number of cached waveforms
+/// @tparam MAX_ITEMS Items per waveform (24 bits x 4 repeats + marker = 101)
+template <size_t SLOTS = 4, size_t MAX_ITEMS = 128>
+class RmtWaveformCache {
+ public:
+  explicit RmtWaveformCache(RmtWaveformEncoder encoder = RmtWaveformEncoder())
+      : encoder_(encoder) {}
+
+  /// Waveform for msg sent repeats times, built on first use
+  /// @param count Output: items in the waveform
+  /// @return Items to transmit, valid until this slot is evicted; nullptr
+  ///         if the waveform cannot be encoded or exceeds MAX_ITEMS
+  const RmtItem* get(const DecodedMessage& msg, uint8_t repeats, size_t& count) {
+    use_clock_++;
+    for (Slot& slot : slots_) {
+      if (slot.count != 0 && slot.code == msg.code && slot.bit_length == msg.bit_length &&
+          slot.protocol == msg.protocol && slot.repeats == repeats) {
+        slot.last_used = use_clock_;
+        hits_++;
+        count = slot.count;
+        return slot.items;
+      }
+    }
+
+    misses_++;
+    Slot& slot = victim();
+    slot.count = 0;
+    size_t written = 0;
+    if (!encoder_.encode(msg, repeats, slot.items, MAX_ITEMS, written)) {
+      return nullptr;
+    }
+    slot.code = msg.code;
+    slot.bit_length = msg.bit_length;
+    slot.protocol = msg.protocol;
+    slot.repeats = repeats;
+    slot.count = written;
+    slot.last_used = use_clock_;
+    count = written;
+    return slot.items;
+  }
+
+  /// Drop all cached waveforms (e.g. after a timing change)
+  void clear() {
+    for (Slot& slot : slots_) {
+      slot.count = 0;
+    }
+  }
+
+  uint32_t get_hit_count() const { return hits_; }
+  uint32_t get_miss_count() const { return misses_; }
+
+  const RmtWaveformEncoder& encoder() const { return encoder_; }
+
+ private:
+  struct Slot {
+    RmtItem items[MAX_ITEMS];
+    size_t count{0};           // 0 = empty
+    uint32_t code{0};
+    uint32_t last_used{0};
+    uint16_t bit_length{0};
+    uint8_t protocol{0};
+    uint8_t repeats{0};
+  };
+
+  /// First empty slot, else the least recently used
+  Slot& victim() {
+    Slot* oldest = &slots_[0];
+    for (Slot& slot : slots_) {
+      if (slot.count == 0) {
+        return slot;
+      }
+      if (use_clock_ - slot.last_used > use_clock_ - oldest->last_used) {
+        oldest = &slot;
+      }
+    }
+    return *oldest;
+  }
+
+  RmtWaveformEncoder encoder_;
+  Slot slots_[SLOTS];
+  uint32_t use_clock_{0};
+  uint32_t hits_{0};
+  uint32_t misses_{0};
+};
+
+}  // namespace home_esp
@@ -5,56 +5,126 @@
 // Converts raw ADC readings to temperature and publishes via interface
 
 #include "interfaces/i_sensor_publisher.h"
+#include "publish_policy.h"
+#include <cstddef>
 #include <cstdint>
 
 namespace home_esp {
 
-class TemperatureReader {
- public:
-  /// Configuration for temperature conversion
-  struct Config {
-    float min_valid_temp;       // Minimum valid temperature (Celsius)
-    float max_valid_temp;       // Maximum valid temperature (Celsius)
-    float adc_min_voltage;      // ADC voltage at min temp
-    float adc_max_voltage;      // ADC voltage at max temp
-    uint16_t adc_resolution;    // ADC max value (12-bit = 4095)
-    float offset;               // Calibration offset
-
-    Config()
-        : min_valid_temp(-40.0f),
-          max_valid_temp(85.0f),
-          adc_min_voltage(0.0f),
-          adc_max_voltage(3.3f),
-          adc_resolution(4095),
-          offset(0.0f) {}
-  };
+/// Value a batch of readings is reduced to before publishing
+enum class BatchStatistic : uint8_t {
+  MEAN,
+  MIN,
+  MAX,
+};
 
-  explicit TemperatureReader(ISensorPublisher* publisher, Config config = Config())
-      : publisher_(publisher), config_(config) {}
+/// Configuration for temperature conversion
+struct TemperatureConfig {
+  float min_valid_temp;       // Minimum valid temperature (Celsius)
+  float max_valid_temp;       // Maximum valid temperature (Celsius)
+  float adc_min_voltage;      // ADC voltage at min temp
+  float adc_max_voltage;      // ADC voltage at max temp
+  uint16_t adc_resolution;    // ADC max value (12-bit = 4095)
+  float offset;               // Calibration offset
+  BatchStatistic batch_statistic;  // Published by process_batch()
 
-  /// Process a raw ADC reading
-  void process_raw_reading(uint16_t raw_adc) {
-    float celsius = convert_to_celsius(raw_adc);
+  TemperatureConfig()
+      : min_valid_temp(-40.0f),
+        max_valid_temp(85.0f),
+        adc_min_voltage(0.0f),
+        adc_max_voltage(3.3f),
+        adc_resolution(4095),
+        offset(0.0f),
+        batch_statistic(BatchStatistic::MEAN) {}
+};
 
-    if (is_valid(celsius)) {
-      publisher_->publish(celsius + config_.offset);
-    } else {
-      publisher_->publish_unavailable();
+/// Sum and extremes of a run of raw ADC codes
+struct RawBatchSummary {
+  uint64_t sum;
+  uint16_t min;
+  uint16_t max;
+};
+
+/// Reduce raw codes in one pass.
+///
+/// The samples are taken in blocks of LANES, each lane keeping its own
+/// sum, min and max: a fixed-width inner loop of widening adds and
+/// compares that GCC vectorizes even at -O2. Lane sums are folded into
+/// 64 bits before they can overflow, then the lanes and the tail are
+/// combined.
+inline RawBatchSummary summarize_raw(const uint16_t* raw, size_t count) {
+  constexpr size_t LANES = 16;
+  constexpr size_t FOLD_BLOCKS = 65536;  // 65536 * 0xFFFF fits in 32 bits
+  uint32_t lane_sum[LANES] = {};
+  uint16_t lane_min[LANES];
+  uint16_t lane_max[LANES];
+  for (size_t lane = 0; lane < LANES; ++lane) {
+    lane_min[lane] = 0xFFFF;
+    lane_max[lane] = 0;
+  }
+
+  RawBatchSummary summary{0, 0xFFFF, 0};
+  size_t blocks = count / LANES;
+  for (size_t block = 0; block < blocks; ++block) {
+    const uint16_t* values = raw + block * LANES;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+      uint16_t value = values[lane];
+      lane_sum[lane] += value;
+      lane_min[lane] = value < lane_min[lane] ? value : lane_min[lane];
+      lane_max[lane] = value > lane_max[lane] ? value : lane_max[lane];
+    }
+    if ((block + 1) % FOLD_BLOCKS == 0) {
+      for (size_t lane = 0; lane < LANES; ++lane) {
+        summary.sum += lane_sum[lane];
+        lane_sum[lane] = 0;
+      }
     }
   }
 
-  /// Get the current configuration
-  const Config& get_config() const { return config_; }
+  for (size_t lane = 0; lane < LANES; ++lane) {
+    summary.sum += lane_sum[lane];
+    summary.min = lane_min[lane] < summary.min ? lane_min[lane] : summary.min;
+    summary.max = lane_max[lane] > summary.max ? lane_max[lane] : summary.max;
+  }
+  for (size_t i = blocks * LANES; i < count; ++i) {
+    summary.sum += raw[i];
+    summary.min = raw[i] < summary.min ? raw[i] : summary.min;
+    summary.max = raw[i] > summary.max ? raw[i] : summary.max;
+  }
+  return summary;
+}
 
-  /// Update calibration offset
-  void set_offset(float offset) { config_.offset = offset; }
+/// Conversion done in float on every sample (targets with an FPU)
+class FloatConversion {
+ public:
+  explicit FloatConversion(const TemperatureConfig& config) : config_(config) {}
+
+  /// Convert a raw ADC reading
+  /// @param celsius Receives the calibrated temperature if valid
+  /// @return false if the reading is outside the valid range
+  bool convert(uint16_t raw_adc, float& celsius) const {
+    return convert_code(static_cast<float>(raw_adc), celsius);
+  }
+
+  /// Convert the mean of count readings whose codes add up to sum
+  bool convert_average(uint64_t sum, size_t count, float& celsius) const {
+    return convert_code(static_cast<float>(sum) / static_cast<float>(count), celsius);
+  }
 
  private:
-  float convert_to_celsius(uint16_t raw_adc) const {
+  bool convert_code(float code, float& celsius) const {
+    float temp = convert_to_celsius(code);
+    if (!is_valid(temp)) {
+      return false;
+    }
+    celsius = temp + config_.offset;
+    return true;
+  }
+
+  float convert_to_celsius(float code) const {
     // Linear conversion from ADC to temperature
     // Assumes linear sensor like TMP36 or similar
-    float voltage = (static_cast<float>(raw_adc) / config_.adc_resolution)
-                    * config_.adc_max_voltage;
+    float voltage = (code / config_.adc_resolution) * config_.adc_max_voltage;
 
     // Map voltage range to temperature range
     float temp_range = config_.max_valid_temp - config_.min_valid_temp;
@@ -68,8 +138,220 @@ class TemperatureReader {
     return temp >= config_.min_valid_temp && temp <= config_.max_valid_temp;
   }
 
+  TemperatureConfig config_;
+};
+
+/// Integer conversion for targets without an FPU (ESP8266), where every
+/// float divide and multiply is a soft-float library call.
+///
+/// The linear map folds into a slope and an intercept, computed once from
+/// the config. Per sample that leaves one 32x32->64 bit multiply, an add,
+/// two integer range compares and the final int-to-float for publishing
+/// (the scale by 2^-16 is exact). Temperatures are Q16.16; the slope
+/// carries 32 fraction bits, so the result is within 2^-15 C of the float
+/// path, far below one ADC step.
+class FixedPointConversion {
+ public:
+  static constexpr int FRAC_BITS = 16;
+  static constexpr int SLOPE_FRAC_BITS = 32;
+
+  explicit FixedPointConversion(const TemperatureConfig& config) {
+    double temp_range = double(config.max_valid_temp) - config.min_valid_temp;
+    double voltage_range = double(config.adc_max_voltage) - config.adc_min_voltage;
+    if (config.adc_resolution == 0 || voltage_range == 0) {
+      degenerate_ = true;  // The float path yields inf/NaN: never valid
+      return;
+    }
+    // temp = min + (raw / res * vmax - vmin) * range / vrange
+    double slope = double(config.adc_max_voltage) / config.adc_resolution *
+                   temp_range / voltage_range;
+    double intercept =
+        config.min_valid_temp - double(config.adc_min_voltage) * temp_range / voltage_range;
+
+    slope_ = to_fixed(slope, SLOPE_FRAC_BITS);
+    intercept_ = static_cast<int32_t>(to_fixed(intercept, FRAC_BITS));
+    min_ = static_cast<int32_t>(to_fixed(config.min_valid_temp, FRAC_BITS));
+    max_ = static_cast<int32_t>(to_fixed(config.max_valid_temp, FRAC_BITS));
+    offset_ = static_cast<int32_t>(to_fixed(config.offset, FRAC_BITS));
+  }
+
+  bool convert(uint16_t raw_adc, float& celsius) const {
+    return finish(to_celsius_fixed(raw_adc), celsius);
+  }
+
+  /// Convert the mean of count readings whose codes add up to sum; the
+  /// divide happens once, on the whole and fractional code separately
+  bool convert_average(uint64_t sum, size_t count, float& celsius) const {
+    int64_t whole = static_cast<int64_t>(sum / count);
+    int64_t remainder = static_cast<int64_t>(sum % count);
+    int64_t scaled = whole * slope_ + remainder * slope_ / static_cast<int64_t>(count);
+    return finish(intercept_ + round_slope(scaled), celsius);
+  }
+
+  /// Uncalibrated temperature in Q16.16
+  int32_t to_celsius_fixed(uint16_t raw_adc) const {
+    return intercept_ + round_slope(static_cast<int64_t>(raw_adc) * slope_);
+  }
+
+ private:
+  /// Round to nearest when dropping the extra slope fraction bits
+  static int32_t round_slope(int64_t scaled) {
+    constexpr int SHIFT = SLOPE_FRAC_BITS - FRAC_BITS;
+    return static_cast<int32_t>((scaled + (int64_t{1} << (SHIFT - 1))) >> SHIFT);
+  }
+
+  bool finish(int32_t temp, float& celsius) const {
+    if (degenerate_ || temp < min_ || temp > max_) {
+      return false;
+    }
+    celsius = static_cast<float>(temp + offset_) * (1.0f / (1 << FRAC_BITS));
+    return true;
+  }
+
+  static int64_t to_fixed(double value, int frac_bits) {
+    double scaled = value * static_cast<double>(int64_t{1} << frac_bits);
+    return static_cast<int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+  }
+
+  int64_t slope_{0};
+  int32_t intercept_{0};
+  int32_t min_{0};
+  int32_t max_{0};
+  int32_t offset_{0};
+  bool degenerate_{false};
+};
+
+/// Converts raw ADC readings and publishes them.
+///
+/// process_batch() takes a whole frame of samples, e.g. from continuous
+/// DMA sampling, and publishes once. Statistics are taken over the raw
+/// codes and converted afterwards, so the per-sample work is integer
+/// adds and compares and the conversion runs three times per batch, not
+/// once per sample. The conversions are monotonic, so the extremes are
+/// exact; the linear ones make the mean exact too, and for a thermistor
+/// the mean of a narrow batch differs from the mean of its temperatures
+/// by far less than the sensor's accuracy.
+///
+/// @tparam Conversion FloatConversion or FixedPointConversion for linear
+///         sensors, picked per target by PlatformTemperatureConversion;
+///         NtcTableConversion (thermistor_table.h) for NTC thermistors.
+///         Provides convert() for one code and convert_average() for a
+///         batch mean.
+template <typename Conversion>
+class BasicTemperatureReader {
+ public:
+  using Config = TemperatureConfig;
+
+  explicit BasicTemperatureReader(ISensorPublisher* publisher, Config config = Config())
+      : publisher_(publisher), config_(config), conversion_(config) {}
+
+  /// Process a raw ADC reading
+  void process_raw_reading(uint16_t raw_adc) {
+    float celsius;
+    if (conversion_.convert(raw_adc, celsius)) {
+      publish(celsius);
+    } else {
+      publish_unavailable();
+    }
+  }
+
+  /// Statistics of the last batch, in Celsius
+  struct BatchStats {
+    float mean;
+    float min;
+    float max;
+    size_t count;
+    bool valid;
+  };
+
+  /// Process a batch of raw ADC readings, publishing the configured
+  /// statistic once. Like a single reading, the batch is unavailable if
+  /// any sample in it is out of range.
+  void process_batch(const uint16_t* raw_adc, size_t count) {
+    if (count == 0) {
+      return;
+    }
+    RawBatchSummary summary = summarize_raw(raw_adc, count);
+    BatchStats& stats = last_batch_;
+    stats.count = count;
+
+    float at_min_code = 0;
+    float at_max_code = 0;
+    stats.valid = conversion_.convert(summary.min, at_min_code) &&
+                  conversion_.convert(summary.max, at_max_code) &&
+                  conversion_.convert_average(summary.sum, count, stats.mean);
+    if (!stats.valid) {
+      publish_unavailable();
+      return;
+    }
+    // A falling curve (NTC to ground) puts the coldest reading at the
+    // highest code
+    bool rising = at_min_code <= at_max_code;
+    stats.min = rising ? at_min_code : at_max_code;
+    stats.max = rising ? at_max_code : at_min_code;
+
+    switch (config_.batch_statistic) {
+      case BatchStatistic::MIN:
+        publish(stats.min);
+        break;
+      case BatchStatistic::MAX:
+        publish(stats.max);
+        break;
+      default:
+        publish(stats.mean);
+        break;
+    }
+  }
+
+  const BatchStats& get_last_batch() const { return last_batch_; }
+
+  /// Only publish readings the policy lets through (nullptr: every one)
+  void set_publish_policy(PublishPolicy* policy) { publish_policy_ = policy; }
+
+  /// Get the current configuration
+  const Config& get_config() const { return config_; }
+
+  /// Update calibration offset
+  void set_offset(float offset) {
+    config_.offset = offset;
+    conversion_ = Conversion(config_);
+  }
+
+ private:
+  void publish(float celsius) {
+    if (publish_policy_ == nullptr || publish_policy_->accept(celsius)) {
+      publisher_->publish(celsius);
+    }
+  }
+
+  void publish_unavailable() {
+    if (publish_policy_ == nullptr || publish_policy_->accept_unavailable()) {
+      publisher_->publish_unavailable();
+    }
+  }
+
   ISensorPublisher* publisher_;
+  PublishPolicy* publish_policy_{nullptr};
   Config config_;
+  Conversion conversion_;
+  BatchStats last_batch_{0.0f, 0.0f, 0.0f, 0, false};
 };
 
+/// Float conversion, identical on every target
+using TemperatureReader = BasicTemperatureReader<FloatConversion>;
+
+/// Fixed point where floats are emulated in software (the toolchain
+/// defines __XTENSA_SOFT_FLOAT__ for the ESP8266, __SOFTFP__ on ARM, and
+/// leaves __riscv_flen undefined on RISC-V parts without an FPU such as
+/// the ESP32-C3/C6/H2), or when HOME_ESP_FIXED_POINT_TEMPERATURE is defined
+#if defined(HOME_ESP_FIXED_POINT_TEMPERATURE) || defined(__XTENSA_SOFT_FLOAT__) || \
+    defined(__SOFTFP__) || (defined(__riscv) && !defined(__riscv_flen))
+using PlatformTemperatureConversion = FixedPointConversion;
+#else
+using PlatformTemperatureConversion = FloatConversion;
+#endif
+
+/// The cheapest conversion for the target being built
+using PlatformTemperatureReader = BasicTemperatureReader<PlatformTemperatureConversion>;
+
 }  // namespace home_esp
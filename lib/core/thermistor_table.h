@@ -0,0 +1,245 @@
+#pragma once
+
+// ThermistorTable - NTC thermistor conversion through a compile-time table
+// Pure C++ with no ESPHome dependencies
+// Steinhart-Hart / B-parameter curves baked into ADC-code segments
+
+#include "temperature_reader.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Natural logarithm usable in constant expressions (std::log is not
+/// constexpr). Range-reduces to [1, 2), then sums the atanh series;
+/// accurate to double precision for x > 0.
+constexpr double constexpr_ln(double x) {
+  constexpr double LN2 = 0.693147180559945309417;
+  int exponent = 0;
+  while (x >= 2.0) {
+    x /= 2.0;
+    exponent++;
+  }
+  while (x < 1.0) {
+    x *= 2.0;
+    exponent--;
+  }
+  // ln(x) = 2 atanh(y), y = (x - 1) / (x + 1) <= 1/3
+  double y = (x - 1.0) / (x + 1.0);
+  double y2 = y * y;
+  double term = y;
+  double sum = 0.0;
+  for (int n = 1; n < 64; n += 2) {
+    sum += term / n;
+    term *= y2;
+  }
+  return 2.0 * sum + exponent * LN2;
+}
+
+/// A thermistor in a voltage divider, as seen by the ADC.
+///
+/// The curve is Steinhart-Hart, 1/T = a + b ln(R) + c ln(R)^3 (T in
+/// kelvin); beta() derives a and b from a datasheet B value, with c = 0.
+/// Declare models constexpr so NtcTableConversion can take them as
+/// template arguments:
+/// @code
+///   constexpr ThermistorModel PROBE = ThermistorModel::beta(10000, 3950, 10000);
+/// @endcode
+struct ThermistorModel {
+  double a;
+  double b;
+  double c;
+  double series_ohms;     // Fixed resistor of the divider
+  bool ntc_to_ground;     // true: NTC between ADC pin and ground
+  uint8_t adc_bits;       // ADC full scale is 2^adc_bits
+
+  /// B-parameter model, e.g. beta(10000, 3950, 10000) for a 10k/3950 NTC
+  /// with a 10k series resistor
+  static constexpr ThermistorModel beta(double r_nominal, double beta, double series_ohms,
+                                        double t_nominal_c = 25.0,
+                                        bool ntc_to_ground = true, uint8_t adc_bits = 12) {
+    double t0 = t_nominal_c + KELVIN;
+    return ThermistorModel{1.0 / t0 - constexpr_ln(r_nominal) / beta, 1.0 / beta, 0.0,
+                           series_ohms, ntc_to_ground, adc_bits};
+  }
+
+  /// Steinhart-Hart model from fitted a, b, c coefficients
+  static constexpr ThermistorModel steinhart_hart(double a, double b, double c,
+                                                  double series_ohms,
+                                                  bool ntc_to_ground = true,
+                                                  uint8_t adc_bits = 12) {
+    return ThermistorModel{a, b, c, series_ohms, ntc_to_ground, adc_bits};
+  }
+
+  /// Thermistor resistance for an ADC code (<= 0 at the rails)
+  constexpr double resistance(double code) const {
+    double ratio = code / static_cast<double>(uint32_t{1} << adc_bits);
+    if (ratio <= 0.0 || ratio >= 1.0) {
+      return ntc_to_ground == (ratio <= 0.0) ? 0.0 : -1.0;  // Short or open
+    }
+    return ntc_to_ground ? series_ohms * ratio / (1.0 - ratio)
+                         : series_ohms * (1.0 - ratio) / ratio;
+  }
+
+  constexpr double celsius_at_resistance(double ohms) const {
+    double ln_r = constexpr_ln(ohms);
+    return 1.0 / (a + b * ln_r + c * ln_r * ln_r * ln_r) - KELVIN;
+  }
+
+  static constexpr double KELVIN = 273.15;
+};
+
+/// One table segment: temperature at its first ADC code and the change
+/// over the segment, both in 1/128 C
+struct ThermistorSegment {
+  int16_t start;
+  int16_t delta;
+
+  static constexpr int FRAC_BITS = 7;  // Q8.7: 1/128 C over +/-256 C
+  static constexpr int16_t INVALID = INT16_MIN;
+
+  static constexpr int32_t to_fixed(double celsius) {
+    double scaled = celsius * (1 << FRAC_BITS);
+    return static_cast<int32_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+  }
+};
+
+/// Segments table for a model, evaluated at compile time by
+/// NtcTableConversion
+template <size_t Segments>
+struct ThermistorTable {
+  ThermistorSegment entries[Segments];
+
+  /// @param segment_bits log2 of the ADC codes per segment
+  static constexpr ThermistorTable build(const ThermistorModel& model, uint8_t segment_bits) {
+    constexpr double LIMIT = 250.0;  // Past this the probe is shorted or open
+    ThermistorTable table{};
+    for (size_t i = 0; i < Segments; ++i) {
+      double first = celsius_at_code(model, static_cast<double>(i << segment_bits));
+      double next = celsius_at_code(model, static_cast<double>((i + 1) << segment_bits));
+      if (!(first > -LIMIT && first < LIMIT && next > -LIMIT && next < LIMIT)) {
+        table.entries[i] = ThermistorSegment{ThermistorSegment::INVALID, 0};
+        continue;
+      }
+      int32_t start = ThermistorSegment::to_fixed(first);
+      table.entries[i] = ThermistorSegment{
+          static_cast<int16_t>(start),
+          static_cast<int16_t>(ThermistorSegment::to_fixed(next) - start)};
+    }
+    return table;
+  }
+
+ private:
+  /// Model temperature at a code; out of range at the rails
+  static constexpr double celsius_at_code(const ThermistorModel& model, double code) {
+    double ohms = model.resistance(code);
+    if (!(ohms > 0.0)) {
+      return 1e9;
+    }
+    return model.celsius_at_resistance(ohms);
+  }
+};
+
+constexpr uint8_t constexpr_log2(size_t value) {
+  uint8_t bits = 0;
+  while (value > 1) {
+    value >>= 1;
+    bits++;
+  }
+  return bits;
+}
+
+/// NTC conversion by table lookup: the ADC range is cut into Segments
+/// equal segments, each stored as a start temperature and its change,
+/// built at compile time from the model.
+///
+/// Per sample that is one 4-byte table read and one multiply-add: the
+/// segment is the code's top bits and the position within it the low
+/// bits, so no divide or log is left. Segments trades flash (4 bytes
+/// each) for accuracy; the interpolation error is largest where the
+/// curve bends most, at the cold and hot ends. Segments reaching past
+/// +/-250 C (a shorted or open probe) read as invalid.
+///
+/// The config's min/max_valid_temp and offset apply as usual;
+/// adc_resolution and the voltages are unused, the model describes the
+/// divider.
+///
+/// @tparam Model A constexpr ThermistorModel with static storage
+/// @tparam Segments Power of two, at most 2^adc_bits
+template <const ThermistorModel& Model, size_t Segments = 64>
+class NtcTableConversion {
+ public:
+  static_assert(Segments >= 2 && (Segments & (Segments - 1)) == 0,
+                "Segments must be a power of two");
+  static_assert(Model.adc_bits <= 16 && (size_t{1} << Model.adc_bits) >= Segments,
+                "More segments than ADC codes");
+
+  static constexpr uint8_t SEGMENT_BITS = Model.adc_bits - constexpr_log2(Segments);
+  static constexpr uint32_t ADC_MAX = (uint32_t{1} << Model.adc_bits) - 1;
+  static constexpr int FRAC_BITS = ThermistorSegment::FRAC_BITS;
+  static constexpr ThermistorTable<Segments> TABLE =
+      ThermistorTable<Segments>::build(Model, SEGMENT_BITS);
+
+  explicit NtcTableConversion(const TemperatureConfig& config)
+      : min_(ThermistorSegment::to_fixed(config.min_valid_temp)),
+        max_(ThermistorSegment::to_fixed(config.max_valid_temp)),
+        offset_(ThermistorSegment::to_fixed(config.offset)) {}
+
+  bool convert(uint16_t raw_adc, float& celsius) const {
+    if (raw_adc > ADC_MAX) {
+      return false;
+    }
+    int32_t temp = 0;
+    if (!table_fixed(raw_adc, temp)) {
+      return false;
+    }
+    return finish(temp, celsius);
+  }
+
+  /// Convert the mean of count readings whose codes add up to sum,
+  /// interpolating at 1/256 code
+  bool convert_average(uint64_t sum, size_t count, float& celsius) const {
+    constexpr int MEAN_FRAC_BITS = 8;
+    uint64_t mean = (sum << MEAN_FRAC_BITS) / count;
+    if ((mean >> MEAN_FRAC_BITS) > ADC_MAX) {
+      return false;
+    }
+    constexpr int BITS = SEGMENT_BITS + MEAN_FRAC_BITS;
+    const ThermistorSegment& segment = TABLE.entries[mean >> BITS];
+    if (segment.start == ThermistorSegment::INVALID) {
+      return false;
+    }
+    int64_t pos = static_cast<int64_t>(mean & ((uint64_t{1} << BITS) - 1));
+    return finish(segment.start + static_cast<int32_t>((segment.delta * pos) >> BITS),
+                  celsius);
+  }
+
+  /// Uncalibrated interpolated temperature in Q8.7
+  /// @return false in a segment marked invalid
+  static constexpr bool table_fixed(uint16_t raw_adc, int32_t& temp) {
+    const ThermistorSegment& segment = TABLE.entries[raw_adc >> SEGMENT_BITS];
+    if (segment.start == ThermistorSegment::INVALID) {
+      return false;
+    }
+    int32_t pos = raw_adc & ((uint32_t{1} << SEGMENT_BITS) - 1);
+    temp = segment.start + ((segment.delta * pos) >> SEGMENT_BITS);
+    return true;
+  }
+
+  static constexpr size_t table_bytes() { return sizeof(TABLE); }
+
+ private:
+  bool finish(int32_t temp, float& celsius) const {
+    if (temp < min_ || temp > max_) {
+      return false;
+    }
+    celsius = static_cast<float>(temp + offset_) * (1.0f / (1 << FRAC_BITS));
+    return true;
+  }
+
+  int32_t min_;
+  int32_t max_;
+  int32_t offset_;
+};
+
+}  // namespace home_esp
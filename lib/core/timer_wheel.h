@@ -0,0 +1,167 @@
+#pragma once
+
+// TimerWheel - Hashed timer wheel for many one-shot timeouts
+// Pure C++ with no ESPHome dependencies
+// O(1) arm/re-arm/cancel, one bucket walk per elapsed tick, no heap
+
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// One-shot timers identified by index, e.g. one per RF code sensor.
+///
+/// Time is quantised into ticks of tick_ms. A timer due at tick T sits in
+/// bucket T % Slots, on an intrusive doubly linked list threaded through
+/// index arrays, so arming, re-arming (e.g. on every repeat frame) and
+/// cancelling are constant time. update() walks only the buckets of the
+/// ticks that elapsed since the last call; timers more than one
+/// revolution away stay in their bucket until their own tick comes round.
+///
+/// Expired timers are handed to a callback with `void(uint16_t id)`,
+/// resolved at compile time like the decoders' sinks. The callback may
+/// re-arm its own timer, but must not arm or cancel others.
+///
+/// @tparam MaxTimers Timer ids are 0..MaxTimers-1
+/// @tparam Slots Buckets in the wheel, a power of two
+///
+/// @note Timing uses unsigned 32-bit arithmetic which correctly handles
+///       millis() overflow (~49.7 days).
+template <size_t MaxTimers, size_t Slots = 64>
+class TimerWheel {
+ public:
+  static_assert(MaxTimers > 0 && MaxTimers < 0xFFFF, "Timer ids must fit in uint16_t");
+  static_assert(Slots > 0 && (Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+
+  explicit TimerWheel(uint16_t tick_ms = 100) : tick_ms_(tick_ms > 0 ? tick_ms : 1) {
+    for (auto& head : buckets_) {
+      head = NONE;
+    }
+    for (auto& timer : timers_) {
+      timer = Timer{0, NONE, NONE, false};
+    }
+  }
+
+  /// Start or restart a timer; it expires delay_ms, rounded up to whole
+  /// ticks, after the last tick update() passed
+  /// @return false if id is out of range
+  bool arm(uint16_t id, uint32_t delay_ms) {
+    if (id >= MaxTimers) {
+      return false;
+    }
+    unlink(id);
+    uint32_t ticks = (delay_ms + tick_ms_ - 1) / tick_ms_;
+    Timer& timer = timers_[id];
+    timer.due_tick = current_tick_ + (ticks > 0 ? ticks : 1);
+    timer.armed = true;
+    link(id);
+    armed_count_++;
+    return true;
+  }
+
+  /// Stop a timer without firing it
+  void cancel(uint16_t id) {
+    if (id < MaxTimers) {
+      unlink(id);
+    }
+  }
+
+  bool is_armed(uint16_t id) const { return id < MaxTimers && timers_[id].armed; }
+
+  /// Advance to current_millis and fire every timer that came due
+  /// @return Number of timers fired
+  template <typename OnExpire>
+  size_t update(uint32_t current_millis, OnExpire&& on_expire) {
+    uint32_t ticks = (current_millis - last_tick_millis_) / tick_ms_;
+    if (ticks == 0) {
+      return 0;
+    }
+    last_tick_millis_ += ticks * tick_ms_;
+    uint32_t first = current_tick_ + 1;
+    current_tick_ += ticks;
+
+    // Past one revolution every bucket is due for a look exactly once
+    uint32_t walk = ticks < Slots ? ticks : Slots;
+    size_t fired = 0;
+    for (uint32_t i = 0; i < walk; ++i) {
+      fired += expire_bucket((first + i) & MASK, on_expire);
+    }
+    return fired;
+  }
+
+  /// Cancel every timer
+  void clear() {
+    for (uint16_t id = 0; id < MaxTimers; ++id) {
+      unlink(id);
+    }
+  }
+
+  /// Timers currently armed
+  size_t armed_count() const { return armed_count_; }
+
+  uint16_t get_tick_ms() const { return tick_ms_; }
+
+ private:
+  static constexpr uint16_t NONE = 0xFFFF;
+  static constexpr uint32_t MASK = Slots - 1;
+
+  struct Timer {
+    uint32_t due_tick;
+    uint16_t next;
+    uint16_t prev;
+    bool armed;
+  };
+
+  void link(uint16_t id) {
+    uint16_t& head = buckets_[timers_[id].due_tick & MASK];
+    timers_[id].prev = NONE;
+    timers_[id].next = head;
+    if (head != NONE) {
+      timers_[head].prev = id;
+    }
+    head = id;
+  }
+
+  void unlink(uint16_t id) {
+    Timer& timer = timers_[id];
+    if (!timer.armed) {
+      return;
+    }
+    if (timer.prev != NONE) {
+      timers_[timer.prev].next = timer.next;
+    } else {
+      buckets_[timer.due_tick & MASK] = timer.next;
+    }
+    if (timer.next != NONE) {
+      timers_[timer.next].prev = timer.prev;
+    }
+    timer.armed = false;
+    armed_count_--;
+  }
+
+  template <typename OnExpire>
+  size_t expire_bucket(uint32_t bucket, OnExpire& on_expire) {
+    size_t fired = 0;
+    uint16_t id = buckets_[bucket];
+    while (id != NONE) {
+      uint16_t next = timers_[id].next;
+      // Due now or earlier; later revolutions stay put
+      if (static_cast<int32_t>(current_tick_ - timers_[id].due_tick) >= 0) {
+        unlink(id);
+        fired++;
+        on_expire(id);  // May re-arm id into any bucket
+      }
+      id = next;
+    }
+    return fired;
+  }
+
+  uint16_t tick_ms_;
+  uint32_t current_tick_{0};
+  uint32_t last_tick_millis_{0};
+  size_t armed_count_{0};
+  uint16_t buckets_[Slots];
+  Timer timers_[MaxTimers];
+};
+
+}  // namespace home_esp
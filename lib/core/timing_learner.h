@@ -0,0 +1,312 @@
+#pragma once
+
+// TimingLearner - RF433 timing profiles learned from observed pulses
+// Pure C++ with no ESPHome dependencies
+// Clusters a pulse-width histogram into a tuned RF433Codec::TimingConfig
+
+#include "rf433_codec.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Learns a remote's timing from a few of its frames.
+///
+/// Fed edge durations (high first, like the decoders), it finds frames by
+/// their sync gap and, once a frame has ended with a plausible bit count,
+/// adds its pulses to a byte-sized histogram (16us bins up to 4ms; all
+/// bins are halved when one saturates, keeping the shape). Pulses from
+/// noise between bursts never reach the histogram.
+///
+/// result() splits the histogram into short and long pulses (Otsu's
+/// method), takes the long/short ratio, fits the base pulse to both
+/// clusters by least squares and measures how far the observed pulses
+/// stray from the resulting nominal widths. The tolerance it reports is
+/// that spread plus a margin, usually far tighter than the 25% a fixed
+/// profile needs to cover every remote.
+///
+/// Assumes the PT2262/rc-switch bit shape: each bit is one short and one
+/// long pulse, '1' starting with the long one.
+class TimingLearner {
+ public:
+  static constexpr uint16_t BIN_US = 16;
+  static constexpr size_t BINS = 256;    // Pulses up to 4096us
+  static constexpr uint8_t MIN_BITS = 8;
+  static constexpr uint8_t MAX_BITS = 32;
+
+  /// Configuration for learning
+  struct Config {
+    uint16_t sync_gap_us;        // Lows at least this long separate frames
+    uint8_t min_frames;          // Frames needed before result() succeeds
+    uint8_t tolerance_margin;    // Percent added to the observed spread
+
+    Config()
+        : sync_gap_us(4000),
+          min_frames(4),
+          tolerance_margin(5) {}
+  };
+
+  explicit TimingLearner(Config config = Config()) : config_(config) {}
+
+  /// Feed the next edge duration
+  void feed(uint16_t duration_us) {
+    if (!have_high_) {
+      if (duration_us >= config_.sync_gap_us) {
+        // A gap where a high belongs: realign so the next edge is a high
+        end_frame();
+        in_frame_ = false;
+        return;
+      }
+      pending_high_ = duration_us;
+      have_high_ = true;
+      return;
+    }
+    have_high_ = false;
+
+    if (duration_us >= config_.sync_gap_us) {
+      end_frame();
+      frame_sync_high_ = pending_high_;
+      frame_sync_low_ = duration_us;
+      in_frame_ = true;
+      bits_ = 0;
+      return;
+    }
+    if (!in_frame_) {
+      return;
+    }
+    if (bits_ >= MAX_BITS) {
+      in_frame_ = false;  // Too long for a code: noise
+      return;
+    }
+    frame_[bits_][0] = pending_high_;
+    frame_[bits_][1] = duration_us;
+    bits_++;
+  }
+
+  /// Derive a timing profile from the frames seen so far.
+  /// @param out Receives the learned profile on success
+  /// @return false until min_frames frames are in, or if the pulses do
+  ///         not form two clearly separated widths
+  bool result(RF433Codec::TimingConfig& out) const {
+    if (frames_ < config_.min_frames) {
+      return false;
+    }
+
+    size_t split = otsu_split();
+    Cluster short_pulses = cluster(0, split);
+    Cluster long_pulses = cluster(split, BINS);
+    if (short_pulses.count == 0 || long_pulses.count == 0) {
+      return false;
+    }
+
+    float ratio = long_pulses.mean() / short_pulses.mean();
+    if (ratio < 1.5f) {
+      return false;  // One width only: not a PWM code
+    }
+    uint8_t k = static_cast<uint8_t>(std::lround(ratio));
+
+    // Least-squares base pulse over both clusters: short = T, long = kT
+    float base = (short_pulses.sum + k * long_pulses.sum) /
+                 (short_pulses.count + float(k) * k * long_pulses.count);
+    uint16_t pulse = static_cast<uint16_t>(std::lround(base));
+    if (pulse == 0) {
+      return false;
+    }
+    long sync_high = std::lround(sync_high_sum_ / float(frames_) / pulse);
+    long sync_low = std::lround(sync_low_sum_ / float(frames_) / pulse);
+    if (sync_low <= k || sync_low > UINT8_MAX ||
+        uint32_t{pulse} * sync_low > UINT16_MAX) {
+      return false;
+    }
+    if (sync_high < 1) {
+      sync_high = 1;
+    }
+
+    // Worst relative deviation from the nominal widths, in percent
+    float spread = 0;
+    spread = std::fmax(spread, deviation(trimmed_low(0, split), pulse));
+    spread = std::fmax(spread, deviation(trimmed_high(0, split), pulse));
+    spread = std::fmax(spread, deviation(trimmed_low(split, BINS), pulse * k));
+    spread = std::fmax(spread, deviation(trimmed_high(split, BINS), pulse * k));
+    spread = std::fmax(spread, deviation(sync_high_min_, pulse * sync_high));
+    spread = std::fmax(spread, deviation(sync_high_max_, pulse * sync_high));
+    spread = std::fmax(spread, deviation(sync_low_min_, pulse * sync_low));
+    spread = std::fmax(spread, deviation(sync_low_max_, pulse * sync_low));
+
+    // Short and long windows must not overlap: T(1+t) < kT(1-t)
+    int max_tolerance = static_cast<int>(100.0f * (k - 1) / (k + 1)) - 1;
+    int tolerance = static_cast<int>(std::ceil(spread)) + config_.tolerance_margin;
+    tolerance = tolerance < 5 ? 5 : tolerance;
+    tolerance = tolerance > max_tolerance ? max_tolerance : tolerance;
+
+    out.pulse_length_us = pulse;
+    out.sync_high_pulses = static_cast<uint8_t>(sync_high);
+    out.sync_low_pulses = static_cast<uint8_t>(sync_low);
+    out.zero_high_pulses = 1;
+    out.zero_low_pulses = k;
+    out.one_high_pulses = k;
+    out.one_low_pulses = 1;
+    out.tolerance_percent = static_cast<uint8_t>(tolerance);
+    return true;
+  }
+
+  /// Discard everything learned so far
+  void reset() {
+    for (auto& bin : histogram_) {
+      bin = 0;
+    }
+    frames_ = 0;
+    samples_ = 0;
+    sync_high_sum_ = sync_low_sum_ = 0;
+    sync_high_min_ = sync_low_min_ = UINT16_MAX;
+    sync_high_max_ = sync_low_max_ = 0;
+    have_high_ = false;
+    in_frame_ = false;
+  }
+
+  /// Drop the frame in progress and pulse alignment, keeping what was
+  /// learned (e.g. when the receiver is muted mid-frame)
+  void reset_frame() {
+    have_high_ = false;
+    in_frame_ = false;
+  }
+
+  /// Frames whose pulses went into the histogram
+  uint32_t get_frame_count() const { return frames_; }
+
+  /// Pulses added to the histogram
+  uint32_t get_sample_count() const { return samples_; }
+
+  const Config& get_config() const { return config_; }
+
+ private:
+  struct Cluster {
+    float sum{0};     // Sum of bin centres, weighted by count (us)
+    float count{0};
+
+    float mean() const { return sum / count; }
+  };
+
+  static float bin_centre(size_t bin) { return (bin + 0.5f) * BIN_US; }
+
+  /// Commit the frame in progress if it had a plausible bit count
+  void end_frame() {
+    if (!in_frame_ || bits_ < MIN_BITS) {
+      return;
+    }
+    for (uint8_t i = 0; i < bits_; ++i) {
+      add(frame_[i][0]);
+      add(frame_[i][1]);
+    }
+    sync_high_sum_ += frame_sync_high_;
+    sync_low_sum_ += frame_sync_low_;
+    track(frame_sync_high_, sync_high_min_, sync_high_max_);
+    track(frame_sync_low_, sync_low_min_, sync_low_max_);
+    frames_++;
+    in_frame_ = false;
+  }
+
+  void add(uint16_t duration_us) {
+    size_t bin = duration_us / BIN_US;
+    bin = bin < BINS ? bin : BINS - 1;
+    if (histogram_[bin] == UINT8_MAX) {
+      for (auto& b : histogram_) {
+        b /= 2;
+      }
+    }
+    histogram_[bin]++;
+    samples_++;
+  }
+
+  static void track(uint16_t value, uint16_t& min, uint16_t& max) {
+    min = value < min ? value : min;
+    max = value > max ? value : max;
+  }
+
+  /// First bin of the long class, maximising between-class variance
+  size_t otsu_split() const {
+    float total = 0, total_sum = 0;
+    for (size_t b = 0; b < BINS; ++b) {
+      total += histogram_[b];
+      total_sum += b * float(histogram_[b]);
+    }
+    float weight = 0, sum = 0, best = -1;
+    size_t split = 1;
+    for (size_t b = 0; b + 1 < BINS; ++b) {
+      weight += histogram_[b];
+      sum += b * float(histogram_[b]);
+      float rest = total - weight;
+      if (weight == 0 || rest == 0) {
+        continue;
+      }
+      float diff = sum / weight - (total_sum - sum) / rest;
+      float between = weight * rest * diff * diff;
+      if (between > best) {
+        best = between;
+        split = b + 1;
+      }
+    }
+    return split;
+  }
+
+  Cluster cluster(size_t begin, size_t end) const {
+    Cluster c;
+    for (size_t b = begin; b < end; ++b) {
+      c.sum += bin_centre(b) * histogram_[b];
+      c.count += histogram_[b];
+    }
+    return c;
+  }
+
+  /// Lowest/highest populated width of a class, ignoring the outer 1%
+  uint16_t trimmed_low(size_t begin, size_t end) const {
+    float skip = cluster(begin, end).count / 100, seen = 0;
+    for (size_t b = begin; b < end; ++b) {
+      seen += histogram_[b];
+      if (seen > skip) {
+        return static_cast<uint16_t>(bin_centre(b));
+      }
+    }
+    return 0;
+  }
+
+  uint16_t trimmed_high(size_t begin, size_t end) const {
+    float skip = cluster(begin, end).count / 100, seen = 0;
+    for (size_t b = end; b-- > begin;) {
+      seen += histogram_[b];
+      if (seen > skip) {
+        return static_cast<uint16_t>(bin_centre(b));
+      }
+    }
+    return 0;
+  }
+
+  static float deviation(uint16_t measured_us, uint32_t nominal_us) {
+    float diff = static_cast<float>(measured_us) - static_cast<float>(nominal_us);
+    return std::fabs(diff) * 100.0f / nominal_us;
+  }
+
+  Config config_;
+
+  uint8_t histogram_[BINS]{};
+  uint32_t frames_{0};
+  uint32_t samples_{0};
+  uint32_t sync_high_sum_{0};
+  uint32_t sync_low_sum_{0};
+  uint16_t sync_high_min_{UINT16_MAX};
+  uint16_t sync_high_max_{0};
+  uint16_t sync_low_min_{UINT16_MAX};
+  uint16_t sync_low_max_{0};
+
+  // Frame in progress: held until its bit count is known
+  uint16_t frame_[MAX_BITS][2]{};
+  uint16_t frame_sync_high_{0};
+  uint16_t frame_sync_low_{0};
+  uint8_t bits_{0};
+  uint16_t pending_high_{0};
+  bool have_high_{false};
+  bool in_frame_{false};
+};
+
+}  // namespace home_esp
@@ -0,0 +1,196 @@
+#pragma once
+
+// TransmitQueue - Non-blocking RF command scheduling
+// Pure C++ with no ESPHome dependencies
+// Queues encoded frames, interleaves their repeats and gates the receiver
+
+#include "interfaces/i_protocol_codec.h"
+#include "interfaces/i_pulse_transmitter.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace home_esp {
+
+/// Fixed-capacity queue of RF commands driven from loop().
+///
+/// Commands are encoded once on enqueue() through IProtocolCodec::encode
+/// and sent by update() in turns of at most burst_repeats frames. Turns
+/// rotate round-robin over the queued commands, so a burst of commands
+/// (e.g. "close all blinds") gets every device its first frames quickly
+/// instead of waiting behind each other's full repeat count. update()
+/// never waits: it starts a turn only when the transmitter is idle and
+/// gap_ms has passed since the previous one.
+///
+/// While a turn is on air, and for receive_guard_ms afterwards, the
+/// receiver should discard what it hears (our own frames and the
+/// receiver's AGC recovering); see is_receive_paused().
+///
+/// @tparam Capacity Commands held at once
+/// @tparam MaxFrameEdges Edges per encoded frame (sync + 32 bits = 66)
+/// @note Timing uses unsigned 32-bit arithmetic which correctly handles
+///       millis() overflow (~49.7 days).
+template <size_t Capacity = 8, size_t MaxFrameEdges = 66>
+class TransmitQueue {
+ public:
+  static constexpr size_t CAPACITY = Capacity;
+
+  /// Configuration for transmit scheduling
+  struct Config {
+    uint8_t burst_repeats;       // Frames per turn before the next command
+    uint16_t gap_ms;             // Silence between turns
+    uint16_t receive_guard_ms;   // Receiver stays paused after a turn
+
+    Config()
+        : burst_repeats(2),
+          gap_ms(10),
+          receive_guard_ms(20) {}
+  };
+
+  TransmitQueue(IProtocolCodec* codec, IPulseTransmitter* transmitter,
+                Config config = Config())
+      : codec_(codec), transmitter_(transmitter), config_(config) {
+    if (config_.burst_repeats == 0) {
+      config_.burst_repeats = 1;
+    }
+  }
+
+  /// Queue msg to be sent repeats times in total
+  /// @return false if the queue is full or msg cannot be encoded
+  bool enqueue(const DecodedMessage& msg, uint8_t repeats) {
+    if (count_ >= Capacity || repeats == 0) {
+      dropped_count_++;
+      return false;
+    }
+
+    Entry& entry = entries_[count_];
+    size_t edges = 0;
+    if (!codec_->encode(msg, MutablePulseSpan(entry.pulses, MaxFrameEdges), edges)) {
+      dropped_count_++;
+      return false;
+    }
+    entry.msg = msg;
+    entry.edge_count = static_cast<uint16_t>(edges);
+    entry.remaining = repeats;
+    entry.enqueued_millis = current_millis_;
+    entry.started = false;
+    count_++;
+    return true;
+  }
+
+  /// Advance the schedule (call this from loop() with current millis)
+  void update(uint32_t current_millis) {
+    current_millis_ = current_millis;
+
+    if (transmitting_) {
+      if (transmitter_->is_busy()) {
+        return;
+      }
+      transmitting_ = false;
+      last_end_millis_ = current_millis;
+    }
+
+    if (count_ == 0) {
+      return;
+    }
+    if (has_sent_ && current_millis - last_end_millis_ < config_.gap_ms) {
+      return;
+    }
+
+    Entry& entry = entries_[cursor_];
+    uint8_t repeats = entry.remaining < config_.burst_repeats ? entry.remaining
+                                                              : config_.burst_repeats;
+    if (!transmitter_->transmit(entry.msg, PulseSpan(entry.pulses, entry.edge_count),
+                                repeats)) {
+      return;  // Radio not ready; try again next pass
+    }
+
+    if (!entry.started) {
+      entry.started = true;
+      uint32_t latency = current_millis - entry.enqueued_millis;
+      if (latency > max_latency_ms_) {
+        max_latency_ms_ = latency;
+      }
+    }
+    transmitting_ = true;
+    has_sent_ = true;
+    frames_sent_ += repeats;
+    entry.remaining -= repeats;
+
+    if (entry.remaining == 0) {
+      remove(cursor_);
+      completed_count_++;
+    } else {
+      cursor_++;
+    }
+    if (cursor_ >= count_) {
+      cursor_ = 0;
+    }
+  }
+
+  /// True while our own transmission may be on air or echoing in the
+  /// receiver; received edges should be discarded
+  bool is_receive_paused() const {
+    if (transmitting_) {
+      return true;
+    }
+    return has_sent_ && current_millis_ - last_end_millis_ < config_.receive_guard_ms;
+  }
+
+  /// Commands waiting or partly sent
+  size_t pending() const { return count_; }
+
+  /// Nothing queued and nothing on air
+  bool is_idle() const { return count_ == 0 && !transmitting_; }
+
+  /// Commands sent with all their repeats
+  uint32_t get_completed_count() const { return completed_count_; }
+
+  /// Frames handed to the transmitter, counting each repeat
+  uint32_t get_frames_sent() const { return frames_sent_; }
+
+  /// Commands refused because the queue was full or encoding failed
+  uint32_t get_dropped_count() const { return dropped_count_; }
+
+  /// Longest wait from enqueue() to a command's first frame
+  uint32_t get_max_latency_ms() const { return max_latency_ms_; }
+
+  const Config& get_config() const { return config_; }
+
+ private:
+  struct Entry {
+    uint16_t pulses[MaxFrameEdges];
+    DecodedMessage msg;
+    uint32_t enqueued_millis;
+    uint16_t edge_count;
+    uint8_t remaining;
+    bool started;
+  };
+
+  /// Close the gap left by a finished command, keeping queue order
+  void remove(size_t index) {
+    for (size_t i = index + 1; i < count_; ++i) {
+      entries_[i - 1] = entries_[i];
+    }
+    count_--;
+  }
+
+  IProtocolCodec* codec_;
+  IPulseTransmitter* transmitter_;
+  Config config_;
+
+  Entry entries_[Capacity];
+  size_t count_{0};
+  size_t cursor_{0};                // Command to send next
+
+  uint32_t current_millis_{0};
+  uint32_t last_end_millis_{0};     // When the last turn was seen to finish
+  bool transmitting_{false};
+  bool has_sent_{false};
+
+  uint32_t completed_count_{0};
+  uint32_t frames_sent_{0};
+  uint32_t dropped_count_{0};
+  uint32_t max_latency_ms_{0};
+};
+
+}  // namespace home_esp
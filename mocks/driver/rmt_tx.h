@@ -0,0 +1,164 @@
+#pragma once
+
+// ESP-IDF RMT TX Driver Mock
+// Stub of the ESP-IDF 5 driver/rmt_tx.h API for unit testing; transmissions
+// are recorded and stay in flight until the test completes them
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_TIMEOUT 0x107
+
+typedef int gpio_num_t;
+
+typedef enum { RMT_CLK_SRC_DEFAULT = 0 } rmt_clock_source_t;
+
+/// One RMT symbol: duration0:15, level0:1, duration1:15, level1:1
+typedef union {
+  struct {
+    uint16_t duration0 : 15;
+    uint16_t level0 : 1;
+    uint16_t duration1 : 15;
+    uint16_t level1 : 1;
+  };
+  uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct {
+  gpio_num_t gpio_num;
+  rmt_clock_source_t clk_src;
+  uint32_t resolution_hz;
+  size_t mem_block_symbols;
+  size_t trans_queue_depth;
+  int intr_priority;
+  struct {
+    uint32_t invert_out : 1;
+    uint32_t with_dma : 1;
+    uint32_t io_loop_back : 1;
+    uint32_t io_od_mode : 1;
+  } flags;
+} rmt_tx_channel_config_t;
+
+typedef struct {
+} rmt_copy_encoder_config_t;
+
+typedef struct {
+  int loop_count;
+  struct {
+    uint32_t eot_level : 1;
+    uint32_t queue_nonblocking : 1;
+  } flags;
+} rmt_transmit_config_t;
+
+/// Channel state; a real handle is opaque
+struct rmt_channel_t {
+  rmt_tx_channel_config_t config;
+  bool enabled{false};
+  size_t in_flight{0};
+
+  // ========== Test Helpers ==========
+
+  /// Symbols of every accepted rmt_transmit(), in order
+  std::vector<std::vector<uint32_t>> sent;
+  /// Buffer of each accepted rmt_transmit(), to check what was copied
+  std::vector<const void*> buffers;
+};
+
+struct rmt_encoder_t {};
+
+typedef rmt_channel_t* rmt_channel_handle_t;
+typedef rmt_encoder_t* rmt_encoder_handle_t;
+
+/// Last channel created, for tests to inspect and complete transmissions
+inline rmt_channel_handle_t& rmt_test_last_channel() {
+  static rmt_channel_handle_t channel = nullptr;
+  return channel;
+}
+
+/// Make the next rmt_new_tx_channel() fail, as with no free channel
+inline bool& rmt_test_fail_new_channel() {
+  static bool fail = false;
+  return fail;
+}
+
+/// Finish every transmission in flight on channel
+inline void rmt_test_complete(rmt_channel_handle_t channel) { channel->in_flight = 0; }
+
+inline esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t* config,
+                                    rmt_channel_handle_t* ret_chan) {
+  if (config == nullptr || ret_chan == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (rmt_test_fail_new_channel()) {
+    rmt_test_fail_new_channel() = false;
+    return ESP_FAIL;
+  }
+  *ret_chan = new rmt_channel_t();
+  (*ret_chan)->config = *config;
+  rmt_test_last_channel() = *ret_chan;
+  return ESP_OK;
+}
+
+inline esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t* /*config*/,
+                                      rmt_encoder_handle_t* ret_encoder) {
+  *ret_encoder = new rmt_encoder_t();
+  return ESP_OK;
+}
+
+inline esp_err_t rmt_enable(rmt_channel_handle_t channel) {
+  channel->enabled = true;
+  return ESP_OK;
+}
+
+inline esp_err_t rmt_disable(rmt_channel_handle_t channel) {
+  channel->enabled = false;
+  channel->in_flight = 0;
+  return ESP_OK;
+}
+
+/// Queues the buffer and returns at once; with a full queue the real
+/// driver blocks, which the mock reports as ESP_ERR_INVALID_STATE
+inline esp_err_t rmt_transmit(rmt_channel_handle_t channel, rmt_encoder_handle_t encoder,
+                              const void* payload, size_t payload_bytes,
+                              const rmt_transmit_config_t* config) {
+  if (channel == nullptr || encoder == nullptr || payload == nullptr || config == nullptr ||
+      payload_bytes == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!channel->enabled || channel->in_flight >= channel->config.trans_queue_depth) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  const uint32_t* symbols = static_cast<const uint32_t*>(payload);
+  channel->sent.emplace_back(symbols, symbols + payload_bytes / sizeof(uint32_t));
+  channel->buffers.push_back(payload);
+  channel->in_flight++;
+  return ESP_OK;
+}
+
+/// @param timeout_ms 0 polls, -1 waits forever (completes in the mock)
+inline esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t channel, int timeout_ms) {
+  if (channel->in_flight != 0 && timeout_ms >= 0) {
+    return ESP_ERR_TIMEOUT;
+  }
+  channel->in_flight = 0;
+  return ESP_OK;
+}
+
+inline esp_err_t rmt_del_channel(rmt_channel_handle_t channel) {
+  if (rmt_test_last_channel() == channel) {
+    rmt_test_last_channel() = nullptr;
+  }
+  delete channel;
+  return ESP_OK;
+}
+
+inline esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder) {
+  delete encoder;
+  return ESP_OK;
+}
@@ -4,6 +4,8 @@
 // Include this single header to get all ESPHome mocks for testing
 
 #include "esphome/core/component.h"
+#include "esphome/core/hal.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/switch/switch.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/remote_transmitter/remote_transmitter.h"
@@ -0,0 +1,82 @@
+#pragma once
+
+// ESPHome Remote Transmitter API Mock
+// Lightweight stub for unit testing RF/IR transmit paths
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace remote_base {
+
+/// Mark/space durations of one transmission (positive = mark)
+class RemoteTransmitData {
+ public:
+  void mark(uint32_t length) { data_.push_back(static_cast<int32_t>(length)); }
+  void space(uint32_t length) { data_.push_back(-static_cast<int32_t>(length)); }
+  void item(uint32_t mark_length, uint32_t space_length) {
+    mark(mark_length);
+    space(space_length);
+  }
+  void reserve(uint32_t len) { data_.reserve(len); }
+  void reset() { data_.clear(); }
+
+  const std::vector<int32_t>& get_data() const { return data_; }
+
+ private:
+  std::vector<int32_t> data_;
+};
+
+class RemoteTransmitterBase;
+
+/// Builder returned by transmit(); perform() sends and blocks until done
+class TransmitCall {
+ public:
+  explicit TransmitCall(RemoteTransmitterBase* parent) : parent_(parent) {}
+
+  RemoteTransmitData* get_data() { return &data_; }
+  void set_send_times(uint32_t send_times) { send_times_ = send_times; }
+  void set_send_wait(uint32_t send_wait) { send_wait_ = send_wait; }
+  inline void perform();
+
+ private:
+  RemoteTransmitterBase* parent_;
+  RemoteTransmitData data_;
+  uint32_t send_times_{1};
+  uint32_t send_wait_{0};
+};
+
+class RemoteTransmitterBase {
+ public:
+  virtual ~RemoteTransmitterBase() = default;
+
+  TransmitCall transmit() { return TransmitCall(this); }
+
+  // ========== Test Helpers ==========
+
+  struct Sent {
+    std::vector<int32_t> data;
+    uint32_t send_times;
+    uint32_t send_wait;
+  };
+
+  /// Every perform()ed call, in order
+  const std::vector<Sent>& test_get_sent() const { return sent_; }
+
+ protected:
+  friend class TransmitCall;
+  std::vector<Sent> sent_;
+};
+
+inline void TransmitCall::perform() {
+  parent_->sent_.push_back({data_.get_data(), send_times_, send_wait_});
+}
+
+}  // namespace remote_base
+
+namespace remote_transmitter {
+
+class RemoteTransmitterComponent : public remote_base::RemoteTransmitterBase {};
+
+}  // namespace remote_transmitter
+}  // namespace esphome
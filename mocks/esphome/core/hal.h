@@ -0,0 +1,15 @@
+#pragma once
+
+// ESPHome HAL Mocks
+// Timing stubs; delays return immediately in tests
+
+#include <cstdint>
+
+namespace esphome {
+
+inline uint32_t millis() { return 0; }
+inline uint32_t micros() { return 0; }
+inline void delay(uint32_t /*ms*/) {}
+inline void delayMicroseconds(uint32_t /*us*/) {}
+
+}  // namespace esphome
@@ -0,0 +1,34 @@
+#pragma once
+
+// Native micro-benchmark helpers
+// Timings are printed for comparison only; tests never assert on speed
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace home_esp::testing {
+
+/// Keep the compiler from discarding a computed value
+template <typename T>
+inline void do_not_optimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// Run fn once and return the elapsed time divided by ops, in nanoseconds
+template <typename Fn>
+double measure_ns_per_op(size_t ops, Fn&& fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(ops);
+}
+
+/// Print one result line, aligned with GoogleTest's output
+inline void report_benchmark(const char* name, double ns_per_op,
+                             const char* unit = "op") {
+  std::printf("[  BENCH   ] %-44s %10.2f ns/%s\n", name, ns_per_op, unit);
+}
+
+}  // namespace home_esp::testing
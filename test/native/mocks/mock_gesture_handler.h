@@ -0,0 +1,45 @@
+#pragma once
+
+// MockGestureHandler - Test double for IGestureHandler
+
+#include "core/interfaces/i_gesture_handler.h"
+#include <vector>
+
+namespace home_esp::testing {
+
+class MockGestureHandler : public IGestureHandler {
+ public:
+  struct Event {
+    uint32_t code;
+    Gesture gesture;
+    uint32_t at_ms;
+  };
+
+  void on_gesture(uint32_t code, Gesture gesture) override {
+    events_.push_back(Event{code, gesture, now_ms_});
+  }
+
+  /// Timestamp recorded with subsequent events
+  void set_now(uint32_t now_ms) { now_ms_ = now_ms; }
+
+  // Test assertions
+  const std::vector<Event>& get_events() const { return events_; }
+
+  size_t get_event_count() const { return events_.size(); }
+
+  size_t count(Gesture gesture) const {
+    size_t n = 0;
+    for (const Event& e : events_) {
+      if (e.gesture == gesture) n++;
+    }
+    return n;
+  }
+
+  void reset() { events_.clear(); }
+
+ private:
+  std::vector<Event> events_;
+  uint32_t now_ms_{0};
+};
+
+}  // namespace home_esp::testing
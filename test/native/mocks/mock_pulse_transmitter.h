@@ -0,0 +1,64 @@
+#pragma once
+
+// MockPulseTransmitter - Test double for IPulseTransmitter
+// Stands in for the radio: records each transmission with its simulated
+// start and end time so tests can check ordering, spacing and latency
+
+#include "core/interfaces/i_pulse_transmitter.h"
+#include <vector>
+
+namespace home_esp::testing {
+
+class MockPulseTransmitter : public IPulseTransmitter {
+ public:
+  struct Transmission {
+    uint32_t start_ms;
+    uint32_t end_ms;
+    std::vector<uint16_t> frame;
+    uint8_t repeats;
+    uint32_t code;     // Of the message handed over with the frame
+  };
+
+  bool transmit(const DecodedMessage& msg, PulseSpan frame, uint8_t repeats) override {
+    if (is_busy()) {
+      overlap_count_++;
+      return false;
+    }
+    if (!accepting_) {
+      return false;
+    }
+    uint64_t us = 0;
+    for (uint16_t d : frame) {
+      us += d;
+    }
+    us *= repeats;
+    uint32_t ms = static_cast<uint32_t>((us + 999) / 1000);
+    transmissions_.push_back({now_, now_ + ms, std::vector<uint16_t>(frame.begin(), frame.end()),
+                              repeats, msg.code});
+    return true;
+  }
+
+  bool is_busy() const override {
+    return !transmissions_.empty() && now_ < transmissions_.back().end_ms;
+  }
+
+  /// Simulated clock shared with the code under test
+  void set_now(uint32_t ms) { now_ = ms; }
+
+  /// Refuse transmit() calls, as a radio still starting up would
+  void set_accepting(bool accepting) { accepting_ = accepting; }
+
+  // Test assertions
+  const std::vector<Transmission>& get_transmissions() const { return transmissions_; }
+
+  /// transmit() calls made while the previous transmission was on air
+  size_t get_overlap_count() const { return overlap_count_; }
+
+ private:
+  uint32_t now_{0};
+  bool accepting_{true};
+  std::vector<Transmission> transmissions_;
+  size_t overlap_count_{0};
+};
+
+}  // namespace home_esp::testing
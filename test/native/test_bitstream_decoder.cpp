@@ -0,0 +1,188 @@
+// Unit tests for BitstreamDecoder
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+
+#include "core/bitstream_decoder.h"
+#include "core/pulse_classifier.h"
+#include "core/rf433_codec.h"
+#include "benchmark.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class BitstreamDecoderTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t RATE = 50000;
+
+  std::vector<uint16_t> encode(uint32_t code) {
+    RF433Codec codec;
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = 24;
+    uint16_t buffer[64];
+    size_t count = 0;
+    EXPECT_TRUE(codec.encode(msg, MutablePulseSpan(buffer), count));
+    return std::vector<uint16_t>(buffer, buffer + count);
+  }
+
+  /// Samples a remote's transmission as a timer would: idle low, then the
+  /// frame repeated, then a short high closing the last low
+  std::vector<bool> sample(const std::vector<uint16_t>& frame, int repeats,
+                           size_t lead_samples = 100) {
+    std::vector<bool> bits(lead_samples, false);
+    for (int r = 0; r < repeats; ++r) {
+      for (size_t i = 0; i < frame.size(); ++i) {
+        size_t n = (static_cast<size_t>(frame[i]) * RATE + 500000) / 1000000;
+        bits.insert(bits.end(), n, i % 2 == 0);
+      }
+    }
+    bits.insert(bits.end(), 20, true);
+    bits.insert(bits.end(), 200, false);
+    return bits;
+  }
+
+  /// Pack samples MSB first, padding the last word with its final level
+  static std::vector<uint32_t> pack(const std::vector<bool>& bits, bool invert = false) {
+    std::vector<uint32_t> words((bits.size() + 31) / 32, 0);
+    for (size_t i = 0; i < words.size() * 32; ++i) {
+      bool b = i < bits.size() ? bits[i] : bits.back();
+      if (b != invert) {
+        words[i / 32] |= 0x80000000u >> (i % 32);
+      }
+    }
+    return words;
+  }
+
+  template <typename D>
+  std::vector<DecodedMessage> decode(D& decoder, const std::vector<uint32_t>& words) {
+    std::vector<DecodedMessage> frames;
+    decoder.feed(words.data(), words.size(),
+                 [&](const DecodedMessage& msg) { frames.push_back(msg); });
+    return frames;
+  }
+};
+
+TEST_F(BitstreamDecoderTest, DecodesSampledFrames) {
+  auto words = pack(sample(encode(0xABCDEF), 3));
+
+  BitstreamDecoder<> decoder;
+  auto frames = decode(decoder, words);
+
+  ASSERT_EQ(frames.size(), 3u);
+  for (const auto& msg : frames) {
+    EXPECT_EQ(msg.code, 0xABCDEFu);
+    EXPECT_EQ(msg.bit_length, 24);
+  }
+}
+
+TEST_F(BitstreamDecoderTest, AnyWordAlignment) {
+  auto frame = encode(0x5A5A5A);
+  for (size_t lead = 0; lead < 32; ++lead) {
+    BitstreamDecoder<> decoder;
+    auto frames = decode(decoder, pack(sample(frame, 2, lead + 40)));
+    ASSERT_EQ(frames.size(), 2u) << "lead " << lead;
+    EXPECT_EQ(frames[1].code, 0x5A5A5Au);
+  }
+}
+
+TEST_F(BitstreamDecoderTest, InvertedReceiverOutput) {
+  auto words = pack(sample(encode(0x123456), 2), true);
+
+  BitstreamDecoder<>::Config config;
+  config.idle_high = true;
+  BitstreamDecoder<> decoder(config);
+  auto frames = decode(decoder, words);
+
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0].code, 0x123456u);
+}
+
+TEST_F(BitstreamDecoderTest, DecodesWordByWord) {
+  // One word per call, as a DMA/timer ISR would hand them over
+  auto words = pack(sample(encode(0x0F0F0F), 2));
+  BitstreamDecoder<> decoder;
+  size_t frames = 0;
+  for (uint32_t w : words) {
+    frames += decoder.feed(&w, 1, [](const DecodedMessage&) {});
+  }
+  EXPECT_EQ(frames, 2u);
+}
+
+TEST_F(BitstreamDecoderTest, IgnoresNoisyWords) {
+  auto bits = sample(encode(0xC0FFEE), 2, 320);
+  // Receiver chatter in the idle lead and in two whole words inside the
+  // first sync low (samples 327-869)
+  std::srand(9);
+  for (size_t i = 0; i < 256; ++i) {
+    bits[i] = std::rand() & 1;
+  }
+  for (size_t i = 448; i < 512; ++i) {
+    bits[i] = std::rand() & 1;
+  }
+  auto words = pack(bits);
+
+  BitstreamDecoder<> decoder;
+  auto frames = decode(decoder, words);
+
+  EXPECT_GE(decoder.get_noise_word_count(), 8u);
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0].code, 0xC0FFEEu);
+}
+
+TEST_F(BitstreamDecoderTest, WorksWithLookupClassifier) {
+  auto words = pack(sample(encode(0xA5A5A5), 2));
+
+  BitstreamDecoder<RF433LutStreamDecoder> decoder;
+  auto frames = decode(decoder, words);
+
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0].code, 0xA5A5A5u);
+}
+
+TEST_F(BitstreamDecoderTest, FeedsReceiver) {
+  RF433Codec codec;
+  MockBinaryPublisher publisher;
+  RF433Receiver receiver(&codec, &publisher);
+  receiver.register_motion_code(0xABCDEF);
+
+  BitstreamDecoder<> decoder;
+  auto words = pack(sample(encode(0xABCDEF), 1));
+  decoder.feed(words.data(), words.size(),
+               [&](const DecodedMessage& msg) { receiver.process_message(msg); });
+
+  EXPECT_EQ(receiver.get_last_code(), 0xABCDEFu);
+  EXPECT_EQ(publisher.get_publish_count(), 1u);
+}
+
+// ============================================
+// Benchmark: cost per 32-sample word
+// ============================================
+
+TEST_F(BitstreamDecoderTest, BenchmarkDecodeWords) {
+  // ~1 s at 50 kHz: bursts of 4 frames separated by idle
+  std::vector<bool> bits;
+  while (bits.size() < RATE) {
+    auto burst = sample(encode(0xABCDEF), 4, 5000);
+    bits.insert(bits.end(), burst.begin(), burst.end());
+  }
+  auto words = pack(bits);
+  const int rounds = 200;
+  BitstreamDecoder<> decoder;
+  size_t frames = 0;
+
+  double ns = measure_ns_per_op(words.size() * rounds, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      frames += decoder.feed(words.data(), words.size(), [](const DecodedMessage&) {});
+    }
+  });
+
+  EXPECT_GT(frames, 0u);
+  report_benchmark("BitstreamDecoder, 50 kHz bursts", ns, "word");
+  // 50 kHz is 1563 words/s
+  std::printf("[  BENCH   ] %-44s %10.4f %% of one core\n", "  at 50 kHz",
+              ns * RATE / 32 / 1e9 * 100);
+}
+
+}  // namespace home_esp::testing
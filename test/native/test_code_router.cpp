@@ -0,0 +1,170 @@
+// Unit tests for CodeRouter
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/code_router.h"
+#include "core/rf433_codec.h"
+#include "benchmark.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class CodeRouterTest : public ::testing::Test {
+ protected:
+  static DecodedMessage frame(uint32_t code, uint8_t protocol = 1) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.protocol = protocol;
+    msg.bit_length = 24;
+    msg.valid = true;
+    return msg;
+  }
+
+  MockBinaryPublisher door_;
+  MockBinaryPublisher pir_;
+};
+
+TEST_F(CodeRouterTest, TableSizeKeepsLoadAtMostHalf) {
+  EXPECT_EQ(FixedCodeRouter<1>::TABLE_SIZE, 2u);
+  EXPECT_EQ(FixedCodeRouter<300>::TABLE_SIZE, 1024u);
+  EXPECT_EQ(FixedCodeRouter<256>::TABLE_SIZE, 512u);
+}
+
+TEST_F(CodeRouterTest, RoutesByCodeAndProtocol) {
+  FixedCodeRouter<4> router;
+  ASSERT_TRUE(router.add(0xABCDEF, 1, &door_));
+  ASSERT_TRUE(router.add(0xABCDEF, 3, &pir_));
+
+  EXPECT_EQ(router.find(0xABCDEF, 1), &door_);
+  EXPECT_EQ(router.find(0xABCDEF, 3), &pir_);
+  EXPECT_EQ(router.find(0xABCDEF, 2), nullptr);
+  EXPECT_EQ(router.find(0x123456, 1), nullptr);
+}
+
+TEST_F(CodeRouterTest, AnyProtocolRouteIsFallback) {
+  FixedCodeRouter<4> router;
+  router.add(0x111111, CodeRouter::ANY_PROTOCOL, &door_);
+  router.add(0x111111, 4, &pir_);
+
+  EXPECT_EQ(router.find(0x111111, 1), &door_);
+  EXPECT_EQ(router.find(0x111111, 6), &door_);
+  EXPECT_EQ(router.find(0x111111, 4), &pir_);  // Exact route wins
+}
+
+TEST_F(CodeRouterTest, AddReplacesExistingRoute) {
+  FixedCodeRouter<2> router;
+  router.add(0x42, 1, &door_);
+  router.add(0x42, 1, &pir_);
+
+  EXPECT_EQ(router.size(), 1u);
+  EXPECT_EQ(router.find(0x42, 1), &pir_);
+}
+
+TEST_F(CodeRouterTest, AddFailsWhenFull) {
+  FixedCodeRouter<3> router;
+  EXPECT_TRUE(router.add(1, 1, &door_));
+  EXPECT_TRUE(router.add(2, 1, &door_));
+  EXPECT_TRUE(router.add(3, 1, &door_));
+  EXPECT_FALSE(router.add(4, 1, &door_));
+  EXPECT_EQ(router.find(4, 1), nullptr);
+}
+
+TEST_F(CodeRouterTest, HandlesCollidingLowBits) {
+  // EV1527 remotes share button bits and differ in the 20-bit device id
+  FixedCodeRouter<300> router;
+  std::vector<MockBinaryPublisher> publishers(300);
+  for (uint32_t i = 0; i < 300; ++i) {
+    ASSERT_TRUE(router.add((i << 4) | 0x8, 2, &publishers[i]));
+  }
+
+  for (uint32_t i = 0; i < 300; ++i) {
+    ASSERT_EQ(router.find((i << 4) | 0x8, 2), &publishers[i]) << i;
+    ASSERT_EQ(router.find((i << 4) | 0x4, 2), nullptr) << i;
+  }
+}
+
+TEST_F(CodeRouterTest, ClearRemovesRoutes) {
+  FixedCodeRouter<2> router;
+  router.add(0x42, CodeRouter::ANY_PROTOCOL, &door_);
+  router.clear();
+
+  EXPECT_EQ(router.size(), 0u);
+  EXPECT_EQ(router.find(0x42, 1), nullptr);
+}
+
+TEST_F(CodeRouterTest, ReceiverPublishesToRoutedEntity) {
+  RF433Codec codec;
+  RF433Receiver receiver(&codec, nullptr);
+  FixedCodeRouter<2> router;
+  router.add(0x0D0012, RF433Codec::PROTOCOL_PT2262, &door_);
+  router.add(0x0F0034, RF433Codec::PROTOCOL_PT2262, &pir_);
+  receiver.set_router(&router);
+
+  receiver.process_message(frame(0x0F0034));
+  receiver.process_message(frame(0x999999));
+
+  EXPECT_EQ(door_.get_publish_count(), 0u);
+  EXPECT_EQ(pir_.get_publish_count(), 1u);
+  EXPECT_TRUE(pir_.get_state());
+  EXPECT_EQ(receiver.get_last_code(), 0x999999u);
+}
+
+// ============================================
+// Benchmark: lookup cost with 1k routes
+// ============================================
+
+TEST_F(CodeRouterTest, BenchmarkLookupWith1kEntries) {
+  constexpr size_t ROUTES = 1000;
+  FixedCodeRouter<ROUTES> router;
+  std::vector<uint32_t> codes;
+
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < ROUTES; ++i) {
+    x = x * 1664525u + 1013904223u;  // LCG: arbitrary 24-bit codes
+    codes.push_back(x >> 8);
+    ASSERT_TRUE(router.add(codes.back(), 1, &door_));
+  }
+
+  const int rounds = 200;
+  const size_t ops = codes.size() * rounds;
+  size_t hits = 0;
+
+  double hit_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint32_t code : codes) {
+        hits += router.find(code, 1) != nullptr ? 1 : 0;
+      }
+    }
+  });
+
+  double miss_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint32_t code : codes) {
+        hits += router.find(code ^ 0x800000, 1) != nullptr ? 1 : 0;
+      }
+    }
+  });
+
+  // Linear scan of the same codes, for comparison
+  double scan_ns = measure_ns_per_op(codes.size() * 2, [&]() {
+    for (int r = 0; r < 2; ++r) {
+      for (uint32_t code : codes) {
+        for (uint32_t candidate : codes) {
+          if (candidate == code) {
+            hits++;
+            break;
+          }
+        }
+      }
+    }
+  });
+
+  do_not_optimize(hits);
+  EXPECT_GE(hits, ops);
+  report_benchmark("CodeRouter::find hit (1k routes)", hit_ns, "lookup");
+  report_benchmark("CodeRouter::find miss (1k routes)", miss_ns, "lookup");
+  report_benchmark("linear scan (1k routes)", scan_ns, "lookup");
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,216 @@
+// Unit tests for GestureDetector
+
+#include <gtest/gtest.h>
+
+#include "core/gesture_detector.h"
+#include "core/rf433_codec.h"
+#include "mocks/mock_binary_publisher.h"
+#include "mocks/mock_gesture_handler.h"
+
+namespace home_esp::testing {
+
+// Frames of a held PT2262 button arrive about every 40 ms
+constexpr uint32_t FRAME_INTERVAL_MS = 40;
+constexpr uint32_t BUTTON_A = 0xABC001;
+constexpr uint32_t BUTTON_B = 0xABC002;
+
+static_assert(sizeof(GestureDetector::Slot) <= 24, "per-code state stays small");
+
+class GestureDetectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    detector_.add(BUTTON_A, RF433Codec::PROTOCOL_PT2262, &handler_);
+    detector_.add(BUTTON_B, GestureDetector::ANY_PROTOCOL, &handler_);
+  }
+
+  static DecodedMessage frame(uint32_t code) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = 24;
+    msg.protocol = RF433Codec::PROTOCOL_PT2262;
+    return msg;
+  }
+
+  /// Advance the simulated clock one millisecond at a time
+  void idle(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; ++i) {
+      tick();
+    }
+  }
+
+  /// Hold a button for duration_ms, sending a frame every interval_ms
+  void press(uint32_t code, uint32_t duration_ms, uint32_t interval_ms = FRAME_INTERVAL_MS) {
+    for (uint32_t t = 0; t < duration_ms; ++t) {
+      if (t % interval_ms == 0) {
+        EXPECT_TRUE(detector_.feed(frame(code)));
+      }
+      tick();
+    }
+  }
+
+  void tick() {
+    now_++;
+    handler_.set_now(now_);
+    detector_.update(now_);
+  }
+
+  uint32_t now_{0};
+  MockGestureHandler handler_;
+  FixedGestureDetector<4> detector_;
+};
+
+TEST_F(GestureDetectorTest, ShortPressIsSingle) {
+  press(BUTTON_A, 100);  // Three frames: one press, not three
+  idle(1000);
+
+  ASSERT_EQ(handler_.get_event_count(), 1u);
+  EXPECT_EQ(handler_.get_events()[0].code, BUTTON_A);
+  EXPECT_EQ(handler_.get_events()[0].gesture, Gesture::SINGLE);
+  EXPECT_EQ(detector_.get_repeat_count(), 2u);
+
+  // Fires once the double-click window after release has passed
+  uint32_t last_frame = 80;
+  EXPECT_EQ(handler_.get_events()[0].at_ms, last_frame + 150 + 400);
+}
+
+TEST_F(GestureDetectorTest, TwoQuickPressesAreDouble) {
+  press(BUTTON_A, 100);
+  idle(250);
+  uint32_t second_press = now_;
+  press(BUTTON_A, 100);
+  idle(1000);
+
+  ASSERT_EQ(handler_.get_event_count(), 1u);
+  EXPECT_EQ(handler_.get_events()[0].gesture, Gesture::DOUBLE);
+  EXPECT_EQ(handler_.get_events()[0].at_ms, second_press);  // No wait for release
+}
+
+TEST_F(GestureDetectorTest, HeldButtonIsLongWhileHeld) {
+  press(BUTTON_A, 2000);
+  EXPECT_EQ(handler_.count(Gesture::LONG), 1u);
+  EXPECT_EQ(handler_.get_events()[0].at_ms, 800u);
+
+  idle(1000);
+  EXPECT_EQ(handler_.get_event_count(), 1u);  // Release adds nothing
+}
+
+TEST_F(GestureDetectorTest, SlowPressesAreSeparateSingles) {
+  press(BUTTON_A, 100);
+  idle(700);
+  press(BUTTON_A, 100);
+  idle(700);
+
+  EXPECT_EQ(handler_.count(Gesture::SINGLE), 2u);
+  EXPECT_EQ(handler_.get_event_count(), 2u);
+}
+
+TEST_F(GestureDetectorTest, LostFrameDoesNotSplitPress) {
+  // Every other frame lost to interference: 80 ms gaps are still repeats
+  press(BUTTON_A, 1200, 2 * FRAME_INTERVAL_MS);
+  idle(1000);
+
+  ASSERT_EQ(handler_.get_event_count(), 1u);
+  EXPECT_EQ(handler_.get_events()[0].gesture, Gesture::LONG);
+}
+
+TEST_F(GestureDetectorTest, DoublesCanBeDisabled) {
+  GestureDetector::Config config;
+  config.double_click_ms = 0;
+  detector_.set_config(config);
+
+  press(BUTTON_A, 100);
+  idle(1000);
+
+  ASSERT_EQ(handler_.get_event_count(), 1u);
+  EXPECT_EQ(handler_.get_events()[0].gesture, Gesture::SINGLE);
+  EXPECT_EQ(handler_.get_events()[0].at_ms, 80u + 151u);  // Right on release
+}
+
+TEST_F(GestureDetectorTest, SparseUpdatesStillFireOnce) {
+  // loop() only ran when frames arrived, then stalled for seconds
+  for (uint32_t t = 0; t <= 1000; t += FRAME_INTERVAL_MS) {
+    handler_.set_now(t);
+    detector_.update(t);
+    detector_.feed(frame(BUTTON_A));
+  }
+  detector_.update(6000);
+  detector_.feed(frame(BUTTON_B));
+  detector_.update(12000);
+
+  ASSERT_EQ(handler_.get_event_count(), 2u);
+  EXPECT_EQ(handler_.get_events()[0].gesture, Gesture::LONG);
+  EXPECT_EQ(handler_.get_events()[0].at_ms, 800u);
+  EXPECT_EQ(handler_.get_events()[1].gesture, Gesture::SINGLE);
+}
+
+TEST_F(GestureDetectorTest, ButtonsAreIndependent) {
+  for (uint32_t t = 0; t < 100; ++t) {
+    if (t % FRAME_INTERVAL_MS == 0) {
+      detector_.feed(frame(BUTTON_A));
+      detector_.feed(frame(BUTTON_B));
+    }
+    tick();
+  }
+  idle(250);
+  press(BUTTON_B, 100);
+  idle(1000);
+
+  ASSERT_EQ(handler_.get_event_count(), 2u);
+  EXPECT_EQ(handler_.get_events()[0].code, BUTTON_B);
+  EXPECT_EQ(handler_.get_events()[0].gesture, Gesture::DOUBLE);
+  EXPECT_EQ(handler_.get_events()[1].code, BUTTON_A);
+  EXPECT_EQ(handler_.get_events()[1].gesture, Gesture::SINGLE);
+}
+
+TEST_F(GestureDetectorTest, IgnoresUntrackedCodes) {
+  EXPECT_FALSE(detector_.feed(frame(0x123456)));
+
+  DecodedMessage other_protocol = frame(BUTTON_A);
+  other_protocol.protocol = RF433Codec::PROTOCOL_EV1527;
+  EXPECT_FALSE(detector_.feed(other_protocol));
+
+  other_protocol.code = BUTTON_B;  // Registered for any protocol
+  EXPECT_TRUE(detector_.feed(other_protocol));
+}
+
+TEST_F(GestureDetectorTest, CapacityIsFixed) {
+  EXPECT_TRUE(detector_.add(0x1, 0, &handler_));
+  EXPECT_TRUE(detector_.add(0x2, 0, &handler_));
+  EXPECT_FALSE(detector_.add(0x3, 0, &handler_));
+  EXPECT_EQ(detector_.size(), 4u);
+}
+
+TEST_F(GestureDetectorTest, ResetDropsPendingGestures) {
+  press(BUTTON_A, 100);
+  detector_.reset();
+  idle(1000);
+  EXPECT_EQ(handler_.get_event_count(), 0u);
+}
+
+TEST_F(GestureDetectorTest, ReceiverBypassesRepeatFilterForGestures) {
+  RF433Codec codec;
+  MockBinaryPublisher motion;
+  RF433Receiver receiver(&codec, &motion);
+  receiver.register_motion_code(0x123456);
+  RepeatFilter filter;
+  receiver.set_repeat_filter(&filter);
+  receiver.set_gesture_detector(&detector_);
+
+  for (uint32_t t = 0; t < 1200; ++t) {
+    if (t % FRAME_INTERVAL_MS == 0) {
+      receiver.process_message(frame(BUTTON_A));
+      receiver.process_message(frame(0x123456));
+    }
+    filter.update(t);
+    tick();
+  }
+  idle(1000);
+
+  // The filter would have let one frame of the held button through
+  ASSERT_EQ(handler_.get_event_count(), 1u);
+  EXPECT_EQ(handler_.get_events()[0].gesture, Gesture::LONG);
+  EXPECT_EQ(motion.get_publish_count(), 1u);  // Other codes are still filtered
+  EXPECT_EQ(receiver.get_last_code(), BUTTON_A);  // Filtered repeats do not count
+}
+
+}  // namespace home_esp::testing
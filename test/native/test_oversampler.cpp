@@ -0,0 +1,170 @@
+// Unit tests for Oversampler
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "core/oversampler.h"
+#include "core/temperature_reader.h"
+#include "mocks/mock_sensor_publisher.h"
+
+namespace home_esp::testing {
+
+using Sampler = Oversampler<64>;
+
+Sampler::Config sampler_config(uint16_t samples, uint16_t decimation = 0,
+                               uint8_t mains_hz = 0) {
+  Sampler::Config config;
+  config.samples = samples;
+  config.decimation = decimation;
+  config.mains_hz = mains_hz;
+  return config;
+}
+
+TEST(OversamplerTest, SingleSampleIsPassthrough) {
+  Sampler sampler(sampler_config(1));
+  EXPECT_EQ(sampler.extra_bits(), 0u);
+  for (uint16_t raw : {0, 1234, 4095}) {
+    ASSERT_TRUE(sampler.add(raw));
+    EXPECT_EQ(sampler.value(), raw);
+  }
+}
+
+TEST(OversamplerTest, OutputsOncePerFullWindow) {
+  Sampler sampler(sampler_config(16));
+  for (int i = 0; i < 15; ++i) {
+    EXPECT_FALSE(sampler.add(1000));
+  }
+  ASSERT_TRUE(sampler.add(1000));
+  EXPECT_EQ(sampler.extra_bits(), 2u);
+  EXPECT_EQ(sampler.value(), 4000u);  // 1000 with two extra bits
+  EXPECT_EQ(sampler.output_resolution(4095), 16380u);
+
+  for (int i = 0; i < 15; ++i) {
+    EXPECT_FALSE(sampler.add(1000));
+  }
+  EXPECT_TRUE(sampler.add(1000));
+  EXPECT_EQ(sampler.get_output_count(), 2u);
+}
+
+TEST(OversamplerTest, AveragingRecoversSubLsbLevel) {
+  // An input sitting between two codes toggles between them
+  Sampler sampler(sampler_config(16));
+  for (int i = 0; i < 16; ++i) {
+    sampler.add(i % 4 == 0 ? 101 : 100);
+  }
+  EXPECT_EQ(sampler.value(), 401u);  // 100.25 in quarter codes
+}
+
+TEST(OversamplerTest, DecimationSlidesTheWindow) {
+  Sampler sampler(sampler_config(8, 2));
+  std::vector<uint16_t> outputs;
+  for (uint16_t i = 0; i < 12; ++i) {
+    if (sampler.add(i * 8)) {
+      outputs.push_back(sampler.value());
+    }
+  }
+  // First output once the window is full, then every 2 samples; mean of
+  // the last 8 inputs, with one extra bit
+  ASSERT_EQ(outputs.size(), 3u);
+  EXPECT_EQ(outputs[0], 56u);   // mean(0..56) = 28
+  EXPECT_EQ(outputs[1], 88u);   // mean(16..72) = 44
+  EXPECT_EQ(outputs[2], 120u);  // mean(32..88) = 60
+}
+
+TEST(OversamplerTest, BatchMatchesSampleBySample) {
+  std::vector<uint16_t> samples;
+  std::srand(7);
+  for (int i = 0; i < 1000; ++i) {
+    samples.push_back(static_cast<uint16_t>(2000 + std::rand() % 64));
+  }
+
+  Sampler one(sampler_config(32, 4)), batch(sampler_config(32, 4));
+  std::vector<uint16_t> expected, actual;
+  for (uint16_t raw : samples) {
+    if (one.add(raw)) {
+      expected.push_back(one.value());
+    }
+  }
+  // Frames that do not line up with the decimation
+  size_t offset = 0;
+  for (size_t frame : {7u, 300u, 1u, 692u}) {
+    size_t outputs = batch.add_batch(&samples[offset], frame,
+                                     [&](uint16_t value) { actual.push_back(value); });
+    EXPECT_LE(outputs, frame / 4 + 1);
+    offset += frame;
+  }
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(OversamplerTest, RejectsInvalidConfig) {
+  Sampler sampler(sampler_config(16));
+  EXPECT_FALSE(sampler.set_config(sampler_config(0)));
+  EXPECT_FALSE(sampler.set_config(sampler_config(12)));
+  EXPECT_FALSE(sampler.set_config(sampler_config(128)));
+  EXPECT_EQ(sampler.get_config().samples, 16u);
+
+  Sampler fallback(sampler_config(3));
+  EXPECT_EQ(fallback.get_config().samples, 64u);
+}
+
+TEST(OversamplerTest, SampleIntervalSpansOneMainsCycle) {
+  EXPECT_EQ(Sampler(sampler_config(16)).sample_interval_us(), 0u);
+  EXPECT_EQ(Sampler(sampler_config(16, 0, 50)).sample_interval_us(), 1250u);
+  EXPECT_EQ(Sampler(sampler_config(16, 0, 60)).sample_interval_us(), 1042u);
+}
+
+TEST(OversamplerTest, SynchronousBurstCancelsMainsHum) {
+  // 40 codes of 50 Hz hum plus its third harmonic on a 2000 code level
+  auto reading = [](double t_us, double phase) {
+    double w = 2 * M_PI * 50.0 * t_us * 1e-6 + phase;
+    return static_cast<uint16_t>(std::lround(2000 + 40 * std::sin(w) + 10 * std::sin(3 * w)));
+  };
+  auto worst_error = [&](uint32_t interval_us) {
+    Sampler sampler(sampler_config(16));
+    double worst = 0;
+    for (int p = 0; p < 32; ++p) {
+      double phase = 2 * M_PI * p / 32;
+      for (int i = 0; i < 16; ++i) {
+        sampler.add(reading(i * double(interval_us), phase));
+      }
+      worst = std::fmax(worst, std::fabs(sampler.value() / 4.0 - 2000));
+    }
+    return worst;
+  };
+
+  uint32_t synced = Sampler(sampler_config(16, 0, 50)).sample_interval_us();
+  EXPECT_LT(worst_error(synced), 0.5);  // Down to rounding
+  EXPECT_GT(worst_error(700), 5.0);     // 11.2 ms burst, not a whole cycle
+}
+
+TEST(OversamplerTest, FeedsTemperatureReaderAtHigherResolution) {
+  MockSensorPublisher publisher;
+  Sampler sampler(sampler_config(16));
+  TemperatureReader::Config config;
+  config.adc_resolution = static_cast<uint16_t>(sampler.output_resolution(config.adc_resolution));
+  TemperatureReader reader(&publisher, config);
+  TemperatureReader reference(&publisher);
+
+  // +/-2 codes of noise around 2048
+  std::srand(3);
+  for (int burst = 0; burst < 20; ++burst) {
+    for (int i = 0; i < 16; ++i) {
+      if (sampler.add(static_cast<uint16_t>(2046 + std::rand() % 5))) {
+        reader.process_raw_reading(sampler.value());
+      }
+    }
+  }
+  ASSERT_EQ(publisher.get_publish_count(), 20u);
+  std::vector<float> oversampled = publisher.get_published_values();
+
+  publisher.reset();
+  reference.process_raw_reading(2048);
+  float expected = publisher.get_last_value();
+  for (float celsius : oversampled) {
+    EXPECT_NEAR(celsius, expected, 0.05f);  // One raw code is 0.03 C
+  }
+}
+
+}  // namespace home_esp::testing
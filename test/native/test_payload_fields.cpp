@@ -0,0 +1,160 @@
+// Unit tests for PayloadLayout and PayloadDecoder
+
+#include <gtest/gtest.h>
+
+#include "core/payload_fields.h"
+#include "core/rf433_codec.h"
+#include "mocks/mock_binary_publisher.h"
+#include "mocks/mock_sensor_publisher.h"
+
+namespace home_esp::testing {
+
+// A 24-bit thermo-hygrometer: 4-bit type 0101, 12-bit signed temperature
+// in 0.1 C, a battery-low flag and 7-bit humidity
+constexpr PayloadLayout<3> THERMO_HYGRO = {
+    24, 0xF00000, 0x500000,
+    {{8, 12, true, 0.1f, 0.0f},
+     {7, 1, false, 1.0f, 0.0f},
+     {0, 7, false, 1.0f, 0.0f}}};
+
+// A rain gauge using the same frame length: type 1010, 20-bit tip count
+// of 0.25 mm
+constexpr PayloadLayout<1> RAIN = {24, 0xF00000, 0xA00000, {{0, 20, false, 0.25f, 0.0f}}};
+
+constexpr size_t TEMPERATURE = 0, BATTERY_LOW = 1, HUMIDITY = 2;
+
+class PayloadFieldsTest : public ::testing::Test {
+ protected:
+  static uint32_t thermo_code(int temp_tenths, bool battery_low, uint8_t humidity) {
+    return 0x500000u | ((static_cast<uint32_t>(temp_tenths) & 0xFFF) << 8) |
+           (battery_low ? 0x80u : 0u) | humidity;
+  }
+
+  static DecodedMessage frame(uint32_t code, uint16_t bits = 24) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    msg.protocol = RF433Codec::PROTOCOL_PT2262;
+    return msg;
+  }
+};
+
+// Extraction is usable in constant expressions
+static_assert(FieldSpec{4, 4, false, 1.0f, 0.0f}.raw(0xABCD) == 0xC, "unsigned field");
+static_assert(FieldSpec{0, 4, true, 1.0f, 0.0f}.raw(0xF) == -1, "sign extension");
+static_assert(FieldSpec{0, 8, false, 0.5f, -40.0f}.value(100) == 10.0f, "scale and bias");
+static_assert(THERMO_HYGRO.is_valid(), "example layout");
+
+TEST_F(PayloadFieldsTest, RejectsBadLayouts) {
+  constexpr PayloadLayout<2> overlapping = {
+      24, 0, 0, {{0, 8, false, 1.0f, 0.0f}, {4, 8, false, 1.0f, 0.0f}}};
+  constexpr PayloadLayout<1> over_id = {24, 0xF00000, 0x500000, {{16, 8, false, 1.0f, 0.0f}}};
+  constexpr PayloadLayout<1> past_frame = {12, 0, 0, {{8, 8, false, 1.0f, 0.0f}}};
+  constexpr PayloadLayout<1> id_outside_mask = {24, 0xF0, 0x1, {{0, 4, false, 1.0f, 0.0f}}};
+
+  EXPECT_FALSE(overlapping.is_valid());
+  EXPECT_FALSE(over_id.is_valid());
+  EXPECT_FALSE(past_frame.is_valid());
+  EXPECT_FALSE(id_outside_mask.is_valid());
+}
+
+TEST_F(PayloadFieldsTest, DecodesFieldsToPublishers) {
+  PayloadDecoder<THERMO_HYGRO> decoder;
+  MockSensorPublisher temperature, battery, humidity;
+  decoder.set_publisher(TEMPERATURE, &temperature);
+  decoder.set_publisher(BATTERY_LOW, &battery);
+  decoder.set_publisher(HUMIDITY, &humidity);
+
+  EXPECT_TRUE(decoder.process(frame(thermo_code(-123, true, 55))));
+
+  EXPECT_NEAR(temperature.get_last_value(), -12.3f, 0.001f);
+  EXPECT_FLOAT_EQ(battery.get_last_value(), 1.0f);
+  EXPECT_FLOAT_EQ(humidity.get_last_value(), 55.0f);
+
+  EXPECT_TRUE(decoder.process(frame(thermo_code(215, false, 40))));
+  EXPECT_NEAR(temperature.get_last_value(), 21.5f, 0.001f);
+  EXPECT_FLOAT_EQ(battery.get_last_value(), 0.0f);
+  EXPECT_EQ(decoder.get_matched_count(), 2u);
+}
+
+TEST_F(PayloadFieldsTest, IgnoresOtherFrames) {
+  PayloadDecoder<THERMO_HYGRO> decoder;
+  MockSensorPublisher temperature;
+  decoder.set_publisher(TEMPERATURE, &temperature);
+
+  EXPECT_FALSE(decoder.process(frame(0xA00010)));                         // Rain gauge
+  EXPECT_FALSE(decoder.process(frame(thermo_code(200, false, 50), 20)));  // Wrong length
+  EXPECT_EQ(temperature.get_publish_count(), 0u);
+}
+
+TEST_F(PayloadFieldsTest, UnsetPublishersAreSkipped) {
+  PayloadDecoder<THERMO_HYGRO> decoder;
+  MockSensorPublisher humidity;
+  decoder.set_publisher(HUMIDITY, &humidity);
+  decoder.set_publisher(7, &humidity);  // Out of range: ignored
+
+  EXPECT_TRUE(decoder.process(frame(thermo_code(0, false, 99))));
+  EXPECT_EQ(humidity.get_publish_count(), 1u);
+  EXPECT_FLOAT_EQ(humidity.get_last_value(), 99.0f);
+}
+
+TEST_F(PayloadFieldsTest, DecodeWithoutPublishing) {
+  float values[3];
+  PayloadDecoder<THERMO_HYGRO>::decode(thermo_code(-400, false, 12), values);
+  EXPECT_NEAR(values[TEMPERATURE], -40.0f, 0.001f);
+  EXPECT_FLOAT_EQ(values[HUMIDITY], 12.0f);
+}
+
+TEST_F(PayloadFieldsTest, ReceiverPublishesSensorFrames) {
+  RF433Codec codec;
+  MockBinaryPublisher motion;
+  RF433Receiver receiver(&codec, &motion);
+  receiver.register_motion_code(0x123456);
+
+  PayloadDecoder<THERMO_HYGRO> thermo;
+  PayloadDecoder<RAIN> rain;
+  MockSensorPublisher temperature, rainfall;
+  thermo.set_publisher(TEMPERATURE, &temperature);
+  rain.set_publisher(0, &rainfall);
+  ASSERT_TRUE(receiver.add_payload_decoder(&thermo));
+  ASSERT_TRUE(receiver.add_payload_decoder(&rain));
+
+  // Encoded and decoded over the air like any other frame
+  DecodedMessage sent = frame(thermo_code(187, false, 61));
+  uint16_t pulses[64];
+  size_t count = 0;
+  ASSERT_TRUE(codec.encode(sent, MutablePulseSpan(pulses), count));
+  DecodedMessage received;
+  ASSERT_TRUE(codec.decode(PulseSpan(pulses, count), received));
+  receiver.process_message(received);
+
+  receiver.process_message(frame(0xA00029));  // 41 tips
+  receiver.process_message(frame(0x123456));  // Motion code still works
+
+  EXPECT_NEAR(temperature.get_last_value(), 18.7f, 0.001f);
+  EXPECT_FLOAT_EQ(rainfall.get_last_value(), 10.25f);
+  EXPECT_EQ(motion.get_publish_count(), 1u);
+}
+
+TEST_F(PayloadFieldsTest, RepeatFilterSuppressesRepeatedReadings) {
+  RF433Codec codec;
+  RF433Receiver receiver(&codec, nullptr);
+  RepeatFilter filter;
+  receiver.set_repeat_filter(&filter);
+  PayloadDecoder<THERMO_HYGRO> thermo;
+  MockSensorPublisher temperature;
+  thermo.set_publisher(TEMPERATURE, &temperature);
+  receiver.add_payload_decoder(&thermo);
+
+  // A sensor sends each reading several times per transmission
+  filter.update(1000);
+  for (int i = 0; i < 4; ++i) {
+    receiver.process_message(frame(thermo_code(200, false, 50)));
+  }
+  filter.update(61000);
+  receiver.process_message(frame(thermo_code(201, false, 50)));
+
+  EXPECT_EQ(temperature.get_publish_count(), 2u);
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,160 @@
+// Unit tests for PublishPolicy
+
+#include <gtest/gtest.h>
+
+#include "core/publish_policy.h"
+#include "core/temperature_reader.h"
+#include "mocks/mock_sensor_publisher.h"
+
+namespace home_esp::testing {
+
+PublishPolicy::Config policy_config(int8_t decimals, float deadband = 0.0f,
+                                    uint32_t heartbeat_ms = 0) {
+  PublishPolicy::Config config;
+  config.accuracy_decimals = decimals;
+  config.deadband = deadband;
+  config.heartbeat_ms = heartbeat_ms;
+  return config;
+}
+
+TEST(PublishPolicyTest, FirstReadingAlwaysPublishes) {
+  PublishPolicy policy;
+  EXPECT_TRUE(policy.accept(21.0f));
+  EXPECT_EQ(policy.get_suppressed_count(), 0u);
+}
+
+TEST(PublishPolicyTest, ComparesAtReportedDecimals) {
+  PublishPolicy policy(policy_config(1));
+  EXPECT_TRUE(policy.accept(21.04f));
+  EXPECT_FALSE(policy.accept(20.96f));  // Both report 21.0
+  EXPECT_FALSE(policy.accept(21.0f));
+  EXPECT_TRUE(policy.accept(21.06f));   // 21.1
+  EXPECT_EQ(policy.get_suppressed_count(), 2u);
+
+  PublishPolicy whole(policy_config(0));
+  EXPECT_TRUE(whole.accept(21.4f));
+  EXPECT_FALSE(whole.accept(20.6f));
+
+  PublishPolicy tens(policy_config(-1));
+  EXPECT_TRUE(tens.accept(1200.0f));
+  EXPECT_FALSE(tens.accept(1204.0f));
+  EXPECT_TRUE(tens.accept(1206.0f));
+}
+
+TEST(PublishPolicyTest, DeadbandHoldsAgainstLastPublished) {
+  PublishPolicy policy(policy_config(1, 0.3f));
+  EXPECT_TRUE(policy.accept(20.0f));
+  // Noise and a slow drift, each step under the deadband
+  EXPECT_FALSE(policy.accept(20.1f));
+  EXPECT_FALSE(policy.accept(19.9f));
+  EXPECT_FALSE(policy.accept(20.2f));
+  EXPECT_TRUE(policy.accept(20.3f));   // 0.3 from the last published 20.0
+  EXPECT_FALSE(policy.accept(20.1f));
+  EXPECT_TRUE(policy.accept(19.9f));
+  EXPECT_EQ(policy.get_suppressed_count(), 4u);
+}
+
+TEST(PublishPolicyTest, HeartbeatBoundsSilence) {
+  PublishPolicy policy(policy_config(1, 0.0f, 60000));
+  policy.update(1000);
+  EXPECT_TRUE(policy.accept(20.0f));
+
+  policy.update(60999);
+  EXPECT_FALSE(policy.accept(20.0f));
+  policy.update(61000);
+  EXPECT_TRUE(policy.accept(20.0f));  // Unchanged, but due
+
+  // The heartbeat restarts on every publish, forced or not
+  policy.update(100000);
+  EXPECT_TRUE(policy.accept(20.5f));
+  policy.update(150000);
+  EXPECT_FALSE(policy.accept(20.5f));
+}
+
+TEST(PublishPolicyTest, AvailabilityChangesAlwaysPublish) {
+  PublishPolicy policy(policy_config(1, 5.0f, 60000));
+  EXPECT_TRUE(policy.accept(20.0f));
+  EXPECT_TRUE(policy.accept_unavailable());
+  EXPECT_FALSE(policy.accept_unavailable());
+  EXPECT_TRUE(policy.accept(20.0f));  // Back, even inside the deadband
+
+  policy.accept_unavailable();
+  policy.update(60000);
+  EXPECT_TRUE(policy.accept_unavailable());  // Heartbeat repeats it
+}
+
+TEST(PublishPolicyTest, SurvivesMillisWraparound) {
+  PublishPolicy policy(policy_config(1, 0.0f, 1000));
+  policy.update(0xFFFFFE00u);
+  EXPECT_TRUE(policy.accept(20.0f));
+  policy.update(0x100u);  // 512 ms later
+  EXPECT_FALSE(policy.accept(20.0f));
+  policy.update(0x200u);
+  EXPECT_TRUE(policy.accept(20.0f));
+}
+
+TEST(PublishPolicyTest, ResetAndConfigPublishNextReading) {
+  PublishPolicy policy;
+  policy.accept(20.0f);
+  policy.reset();
+  EXPECT_TRUE(policy.accept(20.0f));
+  policy.set_config(policy_config(2));
+  EXPECT_TRUE(policy.accept(20.0f));
+  EXPECT_FALSE(policy.accept(20.004f));
+  EXPECT_TRUE(policy.accept(20.006f));
+
+  policy.reset_stats();
+  EXPECT_EQ(policy.get_suppressed_count(), 0u);
+}
+
+TEST(PublishPolicyTest, SnapshotCarriesOverRestart) {
+  PublishPolicy before(policy_config(1, 0.3f, 3600000));
+  before.update(5000);
+  EXPECT_TRUE(before.accept(20.0f));
+  PublishPolicy::Snapshot saved = before.snapshot();
+
+  // A fresh boot would publish anything; restored, it holds the deadband
+  PublishPolicy after(policy_config(1, 0.3f, 3600000));
+  after.restore(saved);
+  after.update(305000);
+  EXPECT_FALSE(after.accept(20.1f));
+  EXPECT_TRUE(after.accept(20.3f));
+  after.update(305000 + 3600000);
+  EXPECT_TRUE(after.accept(20.3f));  // Heartbeat on the carried-over clock
+
+  saved.state = 7;  // Garbage publishes next, as after a cold boot
+  after.restore(saved);
+  EXPECT_TRUE(after.accept(20.3f));
+}
+
+TEST(PublishPolicyTest, ReaderPublishesThroughPolicy) {
+  MockSensorPublisher publisher;
+  PublishPolicy policy(policy_config(1, 0.2f));
+  TemperatureReader::Config config;
+  config.adc_resolution = 3000;  // 4095 reads 130 C: out of range
+  TemperatureReader reader(&publisher, config);
+  reader.set_publish_policy(&policy);
+
+  // One ADC step is about 0.04 C: a few codes of noise stay quiet
+  for (uint16_t raw : {2048, 2049, 2047, 2050, 2048, 2046}) {
+    reader.process_raw_reading(raw);
+  }
+  EXPECT_EQ(publisher.get_publish_count(), 1u);
+  EXPECT_EQ(policy.get_suppressed_count(), 5u);
+
+  reader.process_raw_reading(2100);  // +2.2 C
+  const uint16_t frame[] = {2101, 2099, 2100};
+  reader.process_batch(frame, 3);     // Same again, batched
+  reader.process_raw_reading(4095);
+  reader.process_raw_reading(4095);
+  EXPECT_EQ(publisher.get_publish_count(), 2u);
+  EXPECT_EQ(publisher.get_unavailable_count(), 1);
+  EXPECT_EQ(policy.get_suppressed_count(), 7u);
+
+  reader.set_publish_policy(nullptr);
+  reader.process_raw_reading(2100);
+  reader.process_raw_reading(2100);
+  EXPECT_EQ(publisher.get_publish_count(), 4u);
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,185 @@
+// Unit tests for PulseClassifier
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+
+#include "core/pulse_classifier.h"
+#include "core/rf433_stream_decoder.h"
+#include "benchmark.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class PulseClassifierTest : public ::testing::Test {
+ protected:
+  std::vector<uint16_t> encode(uint32_t code, uint16_t bits,
+                               const RF433Codec::TimingConfig& config = {}) {
+    RF433Codec codec(config);
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    uint16_t buffer[64];
+    size_t len = sizeof(buffer);
+    EXPECT_TRUE(codec.encode(msg, reinterpret_cast<uint8_t*>(buffer), len));
+    return std::vector<uint16_t>(buffer, buffer + len / sizeof(uint16_t));
+  }
+
+  // Junk edges like an idle superregenerative receiver, 30us-3ms
+  std::vector<uint16_t> noise(size_t count, unsigned seed) {
+    std::srand(seed);
+    std::vector<uint16_t> pulses(count);
+    for (auto& p : pulses) {
+      p = static_cast<uint16_t>(30 + std::rand() % 3000);
+    }
+    return pulses;
+  }
+
+  // Expect identical answers from both Symbols implementations
+  template <typename A, typename B>
+  void expect_same(const A& a, const B& b, uint16_t high, uint16_t low) {
+    ASSERT_EQ(a.is_sync_pulse(high, low), b.is_sync_pulse(high, low))
+        << high << "/" << low;
+    ASSERT_EQ(a.decode_bit(high, low), b.decode_bit(high, low))
+        << high << "/" << low;
+  }
+};
+
+TEST_F(PulseClassifierTest, QuantizesFineThenCoarse) {
+  using C = PulseClassifier<1>;
+  EXPECT_EQ(C::quantize(0), 0u);
+  EXPECT_EQ(C::quantize(15), 0u);
+  EXPECT_EQ(C::quantize(16), 1u);
+  EXPECT_EQ(C::quantize(2047), 127u);
+  EXPECT_EQ(C::quantize(2048), 128u);
+  EXPECT_EQ(C::quantize(2303), 128u);
+  EXPECT_EQ(C::quantize(2304), 129u);
+  EXPECT_EQ(C::quantize(UINT16_MAX), C::BUCKETS - 1);
+}
+
+TEST_F(PulseClassifierTest, ClassifiesNominalSymbols) {
+  PulseClassifier<1> classifier;
+
+  EXPECT_TRUE(classifier.is_sync_pulse(350, 10850));
+  EXPECT_EQ(classifier.decode_bit(1050, 350), 1);
+  EXPECT_EQ(classifier.decode_bit(350, 1050), 0);
+  EXPECT_EQ(classifier.decode_bit(60, 60), -1);
+  EXPECT_FALSE(classifier.is_sync_pulse(350, 1050));
+}
+
+TEST_F(PulseClassifierTest, MatchesTimingWindowsForEveryDuration) {
+  for (uint8_t tolerance : {15, 25, 40}) {
+    RF433Codec::TimingConfig config;
+    config.tolerance_percent = tolerance;
+    PulseClassifier<1> lut(config);
+    RF433TimingWindows windows(config);
+
+    // Sweep each half of every symbol against the other half's nominal
+    const uint16_t lows[] = {10850, 1050, 350};
+    for (uint32_t d = 0; d <= UINT16_MAX; ++d) {
+      uint16_t duration = static_cast<uint16_t>(d);
+      for (uint16_t low : lows) {
+        expect_same(lut, windows, duration, low);
+      }
+      expect_same(lut, windows, 350, duration);
+      expect_same(lut, windows, 1050, duration);
+    }
+  }
+}
+
+TEST_F(PulseClassifierTest, ProtocolTableMatchesPerProtocolWindows) {
+  PulseClassifier<RF433_PROTOCOL_COUNT> lut(RF433_PROTOCOLS);
+  using C = PulseClassifier<RF433_PROTOCOL_COUNT>;
+
+  std::srand(42);
+  for (int i = 0; i < 200000; ++i) {
+    uint16_t high = static_cast<uint16_t>(std::rand() % 20000);
+    uint16_t low = static_cast<uint16_t>(std::rand() % 20000);
+    auto mask = lut.classify(high, low);
+
+    for (size_t p = 0; p < RF433_PROTOCOL_COUNT; ++p) {
+      RF433TimingWindows windows(RF433_PROTOCOLS[p].to_timing_config());
+      bool one = windows.decode_bit(high, low) == 1;
+      ASSERT_EQ((C::sync_bits(mask) >> p) & 1, windows.is_sync_pulse(high, low) ? 1 : 0);
+      ASSERT_EQ((C::one_bits(mask) >> p) & 1, one ? 1 : 0);
+    }
+  }
+}
+
+TEST_F(PulseClassifierTest, LutStreamDecoderMatchesWindowDecoder) {
+  RF433LutStreamDecoder lut;
+  RF433StreamDecoder reference;
+
+  std::vector<uint16_t> pulses = noise(500, 7);
+  for (uint32_t code = 1; code < 0x1000000; code += 0x0A5A5A) {
+    auto frame = encode(code, 24);
+    pulses.insert(pulses.end(), frame.begin(), frame.end());
+    auto junk = noise(40, code);
+    pulses.insert(pulses.end(), junk.begin(), junk.end());
+  }
+
+  size_t frames = 0;
+  for (uint16_t p : pulses) {
+    DecodedMessage a, b;
+    bool got_a = lut.feed(p, a);
+    ASSERT_EQ(got_a, reference.feed(p, b));
+    if (got_a) {
+      EXPECT_EQ(a.code, b.code);
+      frames++;
+    }
+  }
+  EXPECT_GT(frames, 20u);
+}
+
+// ============================================
+// Benchmark: window compares vs table lookup on a noisy channel
+// ============================================
+
+TEST_F(PulseClassifierTest, BenchmarkNoiseWindowsVsLookupTable) {
+  std::vector<uint16_t> pulses = noise(20000, 99);
+  auto frame = encode(0xABCDEF, 24);
+  pulses.insert(pulses.end(), frame.begin(), frame.end());
+
+  RF433Codec::TimingConfig config;
+  const int rounds = 20;
+  const size_t ops = pulses.size() * rounds;
+  uint32_t sink = 0;
+
+  auto run = [&](auto& decoder) {
+    return measure_ns_per_op(ops, [&]() {
+      for (int r = 0; r < rounds; ++r) {
+        for (uint16_t p : pulses) {
+          DecodedMessage msg;
+          sink += decoder.feed(p, msg) ? msg.code : 0;
+        }
+      }
+    });
+  };
+
+  // Baseline: RF433Codec window decode, which multiplies and divides
+  // for every tolerance test
+  RF433Codec codec(config);
+  MockBinaryPublisher publisher;
+  RF433Receiver receiver(&codec, &publisher);
+  static PulseRingBuffer<32768> ring;
+  double codec_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint16_t p : pulses) {
+        ring.push(p);
+      }
+      sink += static_cast<uint32_t>(receiver.drain(ring, true));
+    }
+  });
+
+  RF433StreamDecoder windows(config);
+  RF433LutStreamDecoder lut(config);
+  double windows_ns = run(windows);
+  double lut_ns = run(lut);
+
+  do_not_optimize(sink);
+  report_benchmark("RF433Receiver::drain (RF433Codec)", codec_ns, "pulse");
+  report_benchmark("RF433StreamDecoder (windows)", windows_ns, "pulse");
+  report_benchmark("RF433LutStreamDecoder", lut_ns, "pulse");
+}
+
+}  // namespace home_esp::testing
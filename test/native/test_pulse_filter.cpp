@@ -0,0 +1,316 @@
+// Unit tests for PulseFilter
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "core/pulse_filter.h"
+#include "core/rf433_codec.h"
+#include "core/rf433_decoder_bank.h"
+#include "core/rf433_stream_decoder.h"
+#include "benchmark.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class PulseFilterTest : public ::testing::Test {
+ protected:
+  std::vector<uint16_t> encode(uint32_t code, uint16_t bits) {
+    RF433Codec codec;
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    uint16_t buffer[64];
+    size_t count = 0;
+    EXPECT_TRUE(codec.encode(msg, MutablePulseSpan(buffer), count));
+    return std::vector<uint16_t>(buffer, buffer + count);
+  }
+
+  // Idle superregenerative receiver output: short random edges
+  std::vector<uint16_t> noise(size_t count, unsigned seed) {
+    std::srand(seed);
+    std::vector<uint16_t> pulses(count);
+    for (auto& p : pulses) {
+      p = static_cast<uint16_t>(20 + std::rand() % 1500);
+    }
+    return pulses;
+  }
+
+  std::vector<uint16_t> run(PulseFilter& filter, const std::vector<uint16_t>& in) {
+    std::vector<uint16_t> out;
+    auto sink = [&](uint16_t d) { out.push_back(d); };
+    for (uint16_t p : in) {
+      filter.feed(p, sink);
+    }
+    filter.flush(sink);
+    return out;
+  }
+
+  void append(std::vector<uint16_t>& dst, const std::vector<uint16_t>& src) {
+    dst.insert(dst.end(), src.begin(), src.end());
+  }
+};
+
+TEST_F(PulseFilterTest, PassesCleanFrameUnchanged) {
+  PulseFilter filter;
+  auto frame = encode(0xABCDEF, 24);
+
+  EXPECT_EQ(run(filter, frame), frame);
+  EXPECT_EQ(filter.get_removed_count(), 0u);
+  EXPECT_EQ(filter.get_passed_count(), frame.size());
+}
+
+TEST_F(PulseFilterTest, MergesGlitchIntoSplitPulse) {
+  PulseFilter::Config config;
+  config.min_sync_gap_us = 0;  // Glitch stage only
+  PulseFilter filter(config);
+
+  // A 1050us high split by a 30us low spike
+  auto out = run(filter, {350, 10850, 500, 30, 520, 350});
+
+  std::vector<uint16_t> expected = {350, 10850, 1050, 350};
+  EXPECT_EQ(out, expected);
+  EXPECT_EQ(filter.get_merged_count(), 2u);
+}
+
+TEST_F(PulseFilterTest, GlitchedFrameStillDecodes) {
+  PulseFilter filter;
+  auto frame = encode(0x123456, 24);
+  // Split the fourth bit's '1' high (1050us) with a 20us spike
+  const size_t split = 2 + 3 * 2;
+  ASSERT_EQ(frame[split], 1050);
+  std::vector<uint16_t> glitched(frame.begin(), frame.begin() + split);
+  glitched.push_back(600);
+  glitched.push_back(20);
+  glitched.push_back(430);
+  glitched.insert(glitched.end(), frame.begin() + split + 1, frame.end());
+  glitched.push_back(350);  // Next edge releases the last low
+
+  RF433StreamDecoder plain;
+  DecodedMessage msg;
+  bool plain_ok = false;
+  for (uint16_t p : glitched) {
+    plain_ok = plain.feed(p, msg) || plain_ok;
+  }
+  EXPECT_FALSE(plain_ok);
+
+  RF433StreamDecoder decoder;
+  bool ok = false;
+  for (uint16_t p : run(filter, glitched)) {
+    ok = decoder.feed(p, msg) || ok;
+  }
+  ASSERT_TRUE(ok);
+  EXPECT_EQ(msg.code, 0x123456u);
+}
+
+TEST_F(PulseFilterTest, GateDropsNoiseAndKeepsSync) {
+  PulseFilter filter;
+  std::vector<uint16_t> in = noise(1000, 3);
+  auto frame = encode(0x0F0F0F, 24);
+  append(in, frame);
+  append(in, noise(1000, 4));
+
+  auto out = run(filter, in);
+
+  // The frame survives intact; nearly all noise is gone
+  auto it = std::search(out.begin(), out.end(), frame.begin(), frame.end());
+  EXPECT_NE(it, out.end());
+  EXPECT_LT(out.size(), frame.size() + 60);
+  EXPECT_GT(filter.get_dropped_count(), 1500u);
+  EXPECT_EQ(filter.get_passed_count(), out.size());
+}
+
+TEST_F(PulseFilterTest, RepeatsKeepGateOpen) {
+  PulseFilter filter;
+  std::vector<uint16_t> in;
+  for (int i = 0; i < 5; ++i) {
+    append(in, encode(0xA5A5A5, 24));
+  }
+
+  EXPECT_EQ(run(filter, in), in);
+}
+
+/// Decode the filtered stream, collecting every frame
+std::vector<DecodedMessage> decode_filtered(
+    PulseFilter& filter, const std::vector<uint16_t>& in,
+    const RF433Codec::TimingConfig& timing = RF433Codec::TimingConfig()) {
+  RF433StreamDecoder decoder(timing);
+  std::vector<DecodedMessage> frames;
+  auto sink = [&](uint16_t d) {
+    DecodedMessage msg;
+    if (decoder.feed(d, msg)) {
+      frames.push_back(msg);
+    }
+  };
+  for (uint16_t p : in) {
+    filter.feed(p, sink);
+  }
+  filter.flush(sink);
+  return frames;
+}
+
+TEST_F(PulseFilterTest, GlitchAfterFinalLowKeepsLastBit) {
+  PulseFilter filter;
+  std::vector<uint16_t> in = encode(0xABCDEF, 24);
+  in.push_back(40);  // Receiver noise starting with a spike
+  in.push_back(900);
+  append(in, noise(50, 21));
+
+  auto frames = decode_filtered(filter, in);
+  // Folding the final low into the noise used to give 0x55E6F7/23
+  ASSERT_EQ(frames.size(), 1u);
+  EXPECT_EQ(frames[0].code, 0xABCDEFu);
+  EXPECT_EQ(frames[0].bit_length, 24u);
+}
+
+TEST_F(PulseFilterTest, GlitchBeforeSyncKeepsFrame) {
+  PulseFilter filter;
+  std::vector<uint16_t> in = noise(51, 22);  // Ends on a high
+  in.push_back(40);  // Spike just before the sync high
+  append(in, encode(0xABCDEF, 24));
+
+  auto frames = decode_filtered(filter, in);
+  ASSERT_EQ(frames.size(), 1u);
+  EXPECT_EQ(frames[0].code, 0xABCDEFu);
+}
+
+TEST_F(PulseFilterTest, NeverMergesAcrossSyncGap) {
+  PulseFilter filter;
+  auto frame = encode(0x123456, 24);
+  std::vector<uint16_t> in(frame.begin(), frame.begin() + 10);
+  in.push_back(60);    // Spike right before a gap
+  in.push_back(9000);  // The gap survives whole
+  in.push_back(60);    // And a spike just after it is not folded in
+  in.push_back(900);
+
+  auto out = run(filter, in);
+  auto gap = std::find(out.begin(), out.end(), 9000);
+  ASSERT_NE(gap, out.end());
+  ASSERT_NE(gap + 1, out.end());
+  EXPECT_EQ(gap[-1], 60u);
+  EXPECT_EQ(gap[1], 60u);
+}
+
+TEST_F(PulseFilterTest, AdmitFitsShortPulseLength) {
+  RF433Codec::TimingConfig timing;
+  timing.pulse_length_us = 100;  // Sync low 3100us, short pulses 100us
+  RF433Codec codec(timing);
+  DecodedMessage msg;
+  msg.code = 0xABCDEF;
+  msg.bit_length = 24;
+  uint16_t buffer[64];
+  size_t count = 0;
+  ASSERT_TRUE(codec.encode(msg, MutablePulseSpan(buffer), count));
+  std::vector<uint16_t> in = noise(40, 23);
+  in.insert(in.end(), buffer, buffer + count);
+
+  PulseFilter defaults;
+  EXPECT_TRUE(decode_filtered(defaults, in, timing).empty());
+
+  PulseFilter::Config config;
+  ASSERT_TRUE(config.admit(timing.min_width_us(1), timing.min_width_us(31)));
+  EXPECT_EQ(config.glitch_us, 37u);
+  EXPECT_EQ(config.min_sync_gap_us, 2325u);
+  EXPECT_FALSE(config.admit(timing.min_width_us(1), timing.min_width_us(31)));
+
+  PulseFilter fitted;
+  fitted.set_config(config);
+  auto frames = decode_filtered(fitted, in, timing);
+  ASSERT_EQ(frames.size(), 1u);
+  EXPECT_EQ(frames[0].code, 0xABCDEFu);
+}
+
+TEST_F(PulseFilterTest, ReceiverDrainsThroughFilter) {
+  RF433Codec codec;
+  MockBinaryPublisher publisher;
+  RF433Receiver receiver(&codec, &publisher);
+  receiver.register_motion_code(0xABCDEF);
+  PulseFilter filter;
+  RF433StreamDecoder decoder;
+  PulseRingBuffer<1024> ring;
+
+  std::vector<uint16_t> in = noise(300, 11);
+  append(in, encode(0xABCDEF, 24));
+  append(in, noise(300, 12));
+  for (uint16_t p : in) {
+    ring.push(p);
+  }
+
+  EXPECT_EQ(receiver.drain(ring, filter, decoder), 1u);
+  EXPECT_EQ(publisher.get_publish_count(), 1u);
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(PulseFilterTest, ReceiverFlushReleasesFinalFrame) {
+  RF433Codec codec;
+  MockBinaryPublisher publisher;
+  RF433Receiver receiver(&codec, &publisher);
+  receiver.register_motion_code(0xABC);
+  PulseFilter filter;
+  RF433StreamDecoder decoder;
+  PulseRingBuffer<1024> ring;
+
+  // A 12-bit frame and then silence: its last low is held by the
+  // filter, and the decoder waits for a pair that would end the frame
+  std::vector<uint16_t> in = noise(100, 13);
+  append(in, encode(0xABC, 12));
+  for (uint16_t p : in) {
+    ring.push(p);
+  }
+
+  EXPECT_EQ(receiver.drain(ring, filter, decoder), 0u);
+  EXPECT_EQ(receiver.flush(filter, decoder), 1u);
+  EXPECT_EQ(publisher.get_publish_count(), 1u);
+  EXPECT_EQ(receiver.flush(filter, decoder), 0u);
+}
+
+// ============================================
+// Benchmark: decoder cost on idle noise with and without the filter.
+// The gate's saving is for the decoder bank; a lone stream decoder costs
+// about what the filter does, so there it comes out roughly even.
+// ============================================
+
+TEST_F(PulseFilterTest, BenchmarkIdleNoiseWithAndWithoutFilter) {
+  std::vector<uint16_t> pulses = noise(20000, 5);
+  const int rounds = 20;
+  const size_t ops = pulses.size() * rounds;
+  uint32_t sink = 0;
+
+  auto direct = [&](auto& decoder) {
+    return measure_ns_per_op(ops, [&]() {
+      for (int r = 0; r < rounds; ++r) {
+        for (uint16_t p : pulses) {
+          DecodedMessage msg;
+          sink += decoder.feed(p, msg) ? 1 : 0;
+        }
+      }
+    });
+  };
+
+  auto filtered = [&](auto& decoder) {
+    PulseFilter filter;
+    auto forward = [&](uint16_t d) {
+      DecodedMessage msg;
+      sink += decoder.feed(d, msg) ? 1 : 0;
+    };
+    return measure_ns_per_op(ops, [&]() {
+      for (int r = 0; r < rounds; ++r) {
+        for (uint16_t p : pulses) {
+          filter.feed(p, forward);
+        }
+      }
+    });
+  };
+
+  RF433StreamDecoder stream_a, stream_b;
+  RF433DecoderBank bank_a(RF433_PROTOCOLS), bank_b(RF433_PROTOCOLS);
+
+  report_benchmark("RF433StreamDecoder, raw noise", direct(stream_a), "pulse");
+  report_benchmark("PulseFilter + RF433StreamDecoder", filtered(stream_b), "pulse");
+  report_benchmark("RF433DecoderBank<6>, raw noise", direct(bank_a), "pulse");
+  report_benchmark("PulseFilter + RF433DecoderBank<6>", filtered(bank_b), "pulse");
+  do_not_optimize(sink);
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,161 @@
+// Unit tests for PulseRingBuffer
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "core/pulse_ring_buffer.h"
+
+namespace home_esp::testing {
+
+TEST(PulseRingBufferTest, StartsEmpty) {
+  PulseRingBuffer<16> ring;
+  size_t count = 99;
+
+  ring.read_window(count);
+
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(count, 0u);
+  EXPECT_EQ(ring.overflow_count(), 0u);
+  EXPECT_EQ(ring.high_water_mark(), 0u);
+}
+
+TEST(PulseRingBufferTest, PushThenReadInOrder) {
+  PulseRingBuffer<16> ring;
+
+  ring.push(350);
+  ring.push(10850);
+  ring.push(1050);
+
+  size_t count = 0;
+  const uint16_t* pulses = ring.read_window(count);
+
+  ASSERT_EQ(count, 3u);
+  EXPECT_EQ(pulses[0], 350);
+  EXPECT_EQ(pulses[1], 10850);
+  EXPECT_EQ(pulses[2], 1050);
+}
+
+TEST(PulseRingBufferTest, ConsumeReleasesPulses) {
+  PulseRingBuffer<16> ring;
+  ring.push(1);
+  ring.push(2);
+  ring.push(3);
+
+  ring.consume(2);
+
+  size_t count = 0;
+  const uint16_t* pulses = ring.read_window(count);
+  ASSERT_EQ(count, 1u);
+  EXPECT_EQ(pulses[0], 3);
+}
+
+TEST(PulseRingBufferTest, WindowStaysContiguousAcrossWrap) {
+  PulseRingBuffer<8> ring;
+
+  // Move the read index close to the end of the storage
+  for (uint16_t i = 0; i < 6; ++i) ring.push(i);
+  ring.consume(6);
+
+  for (uint16_t i = 100; i < 106; ++i) ring.push(i);
+
+  size_t count = 0;
+  const uint16_t* pulses = ring.read_window(count);
+  ASSERT_EQ(count, 6u);
+  for (uint16_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(pulses[i], 100 + i);
+  }
+}
+
+TEST(PulseRingBufferTest, CountsOverflowWhenFull) {
+  PulseRingBuffer<4> ring;
+
+  for (uint16_t i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.push(i));
+  }
+  EXPECT_FALSE(ring.push(99));
+  EXPECT_FALSE(ring.push(99));
+
+  EXPECT_EQ(ring.overflow_count(), 2u);
+  EXPECT_EQ(ring.available(), 4u);
+}
+
+TEST(PulseRingBufferTest, TracksHighWaterMark) {
+  PulseRingBuffer<16> ring;
+
+  for (uint16_t i = 0; i < 5; ++i) ring.push(i);
+  ring.consume(5);
+  ring.push(1);
+
+  EXPECT_EQ(ring.high_water_mark(), 5u);
+
+  ring.reset_stats();
+  EXPECT_EQ(ring.high_water_mark(), 0u);
+}
+
+TEST(PulseRingBufferTest, ProducerThreadDeliversEveryPulseInOrder) {
+  // ~3 kHz edges is a busy PT2262 channel; push much faster than that
+  // with bursts so the consumer regularly sees wrapped windows.
+  constexpr uint32_t TOTAL = 50000;
+  PulseRingBuffer<256> ring;
+  std::atomic<bool> done{false};
+
+  std::thread producer([&]() {
+    uint32_t sent = 0;
+    while (sent < TOTAL) {
+      if (ring.push(static_cast<uint16_t>(sent))) {
+        sent++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    done.store(true);
+  });
+
+  uint32_t expected = 0;
+  bool in_order = true;
+  while (expected < TOTAL) {
+    size_t count = 0;
+    const uint16_t* pulses = ring.read_window(count);
+    if (count == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (pulses[i] != static_cast<uint16_t>(expected + i)) {
+        in_order = false;
+      }
+    }
+    ring.consume(count);
+    expected += count;
+  }
+
+  producer.join();
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(expected, TOTAL);
+  EXPECT_TRUE(done.load());
+  EXPECT_LE(ring.high_water_mark(), 256u);
+}
+
+TEST(PulseRingBufferTest, SlowConsumerSeesOverflowNotCorruption) {
+  PulseRingBuffer<64> ring;
+
+  std::thread producer([&]() {
+    for (uint32_t i = 0; i < 10000; ++i) {
+      ring.push(static_cast<uint16_t>(i));
+    }
+  });
+  producer.join();
+
+  size_t count = 0;
+  const uint16_t* pulses = ring.read_window(count);
+
+  // First 64 pulses were kept; the rest were counted as overflow
+  ASSERT_EQ(count, 64u);
+  EXPECT_EQ(pulses[0], 0);
+  EXPECT_EQ(pulses[63], 63);
+  EXPECT_EQ(ring.overflow_count(), 10000u - 64u);
+  EXPECT_EQ(ring.high_water_mark(), 64u);
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,161 @@
+// Unit tests for PulseSpan and the typed IProtocolCodec API
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/pulse_span.h"
+#include "core/rf433_codec.h"
+#include "core/rf433_codec_t.h"
+
+namespace home_esp::testing {
+
+class PulseSpanTest : public ::testing::Test {
+ protected:
+  std::vector<uint16_t> encode(uint32_t code, uint16_t bits) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    std::vector<uint16_t> pulses(64);
+    size_t count = 0;
+    EXPECT_TRUE(codec_.encode(msg, MutablePulseSpan(pulses.data(), pulses.size()), count));
+    pulses.resize(count);
+    return pulses;
+  }
+
+  RF433Codec codec_;
+};
+
+TEST_F(PulseSpanTest, ViewsWithoutCopying) {
+  uint16_t pulses[] = {350, 10850, 1050, 350};
+  PulseSpan span(pulses);
+
+  EXPECT_EQ(span.size(), 4u);
+  EXPECT_EQ(span.data(), pulses);
+  EXPECT_EQ(span[2], 1050);
+
+  PulseSpan tail = span.subspan(2);
+  EXPECT_EQ(tail.data(), pulses + 2);
+  EXPECT_EQ(tail.size(), 2u);
+  EXPECT_TRUE(span.subspan(9).empty());
+  EXPECT_EQ(span.subspan(1, 2).size(), 2u);
+}
+
+TEST_F(PulseSpanTest, WideDurationsSaturate) {
+  uint32_t pulses[] = {350, 70000, 65535};
+  PulseSpan32 span(pulses);
+
+  EXPECT_EQ(span.duration_us(0), 350);
+  EXPECT_EQ(span.duration_us(1), UINT16_MAX);
+  EXPECT_EQ(span.duration_us(2), UINT16_MAX);
+  EXPECT_EQ(span[1], 70000u);
+}
+
+TEST_F(PulseSpanTest, EncodeAndDecodeTypedSpans) {
+  auto pulses = encode(0xABCDEF, 24);
+  ASSERT_EQ(pulses.size(), 50u);
+
+  DecodedMessage msg;
+  ASSERT_TRUE(codec_.decode(PulseSpan(pulses.data(), pulses.size()), msg));
+  EXPECT_EQ(msg.code, 0xABCDEFu);
+  EXPECT_EQ(msg.bit_length, 24);
+}
+
+TEST_F(PulseSpanTest, Decodes32BitDurations) {
+  auto pulses = encode(0x123456, 24);
+  std::vector<uint32_t> wide(pulses.begin(), pulses.end());
+
+  DecodedMessage msg;
+  ASSERT_TRUE(codec_.decode(PulseSpan32(wide.data(), wide.size()), msg));
+  EXPECT_EQ(msg.code, 0x123456u);
+
+  // A 100ms sync gap is out of range, not wrapped into a valid one
+  wide[1] = 100000 + 10850;
+  EXPECT_FALSE(codec_.decode(PulseSpan32(wide.data(), wide.size()), msg));
+}
+
+TEST_F(PulseSpanTest, Encodes32BitDurations) {
+  DecodedMessage msg;
+  msg.code = 0x123456;
+  msg.bit_length = 24;
+  uint32_t wide[64];
+  size_t count = 0;
+  ASSERT_TRUE(codec_.encode(msg, MutablePulseSpan32(wide), count));
+
+  auto narrow = encode(0x123456, 24);
+  ASSERT_EQ(count, narrow.size());
+  EXPECT_TRUE(std::equal(narrow.begin(), narrow.end(), wide));
+  DecodedMessage decoded;
+  ASSERT_TRUE(codec_.decode(MutablePulseSpan32(wide).first(count), decoded));
+  EXPECT_EQ(decoded.code, 0x123456u);
+
+  // A 77.5ms sync gap fits a 32-bit span
+  RF433Codec::TimingConfig slow;
+  slow.pulse_length_us = 2500;
+  RF433Codec slow_codec(slow);
+  ASSERT_TRUE(slow_codec.encode(msg, MutablePulseSpan32(wide), count));
+  EXPECT_EQ(wide[1], 77500u);
+}
+
+TEST_F(PulseSpanTest, ByteApiIsLittleEndianAtAnyAlignment) {
+  auto pulses = encode(0x5A5A5A, 24);
+
+  // Byte-pack at an odd offset, as a capture file or packet might
+  std::vector<uint8_t> bytes(1 + pulses.size() * 2);
+  for (size_t i = 0; i < pulses.size(); ++i) {
+    bytes[1 + i * 2] = pulses[i] & 0xFF;
+    bytes[1 + i * 2 + 1] = pulses[i] >> 8;
+  }
+
+  DecodedMessage msg;
+  ASSERT_TRUE(codec_.decode(bytes.data() + 1, bytes.size() - 1, msg));
+  EXPECT_EQ(msg.code, 0x5A5A5Au);
+
+  std::vector<uint8_t> encoded(1 + 64 * 2);
+  size_t len = encoded.size() - 1;
+  ASSERT_TRUE(codec_.encode(msg, encoded.data() + 1, len));
+  EXPECT_TRUE(std::equal(encoded.begin() + 1, encoded.begin() + 1 + len,
+                         bytes.begin() + 1));
+}
+
+TEST_F(PulseSpanTest, EncodeFailsWhenSpanTooSmall) {
+  DecodedMessage msg;
+  msg.code = 0xFF;
+  msg.bit_length = 8;
+  uint16_t buffer[17];
+  size_t count = 0;
+
+  EXPECT_FALSE(codec_.encode(msg, MutablePulseSpan(buffer), count));
+  EXPECT_FALSE(RF433CodecT<>::encode(msg, MutablePulseSpan(buffer), count));
+}
+
+TEST_F(PulseSpanTest, DecodeAllOverRingSegment) {
+  PulseRingBuffer<256> ring;
+  for (uint16_t p : {90, 4000}) {
+    ring.push(p);
+  }
+  for (int i = 0; i < 3; ++i) {
+    for (uint16_t p : encode(0x0F0F0F, 24)) {
+      ring.push(p);
+    }
+  }
+
+  DecodedMessage frames[4];
+  size_t found = 0;
+  PulseSpan window = ring.read_span();
+  size_t consumed = codec_.decode_all(window, frames, 4, found);
+
+  EXPECT_EQ(window.size(), 152u);
+  EXPECT_EQ(found, 3u);
+  EXPECT_EQ(consumed, window.size());
+  EXPECT_EQ(frames[2].code, 0x0F0F0Fu);
+}
+
+TEST_F(PulseSpanTest, CompileTimeCodecAcceptsSpans) {
+  auto pulses = encode(0xC0FFEE, 24);
+  DecodedMessage msg;
+
+  ASSERT_TRUE(RF433CodecT<>::decode(PulseSpan(pulses.data(), pulses.size()), msg));
+  EXPECT_EQ(msg.code, 0xC0FFEEu);
+}
+
+}  // namespace home_esp::testing
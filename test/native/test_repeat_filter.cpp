@@ -0,0 +1,181 @@
+// Unit tests for RepeatFilter
+
+#include <gtest/gtest.h>
+
+#include "core/repeat_filter.h"
+#include "core/rf433_codec.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class RepeatFilterTest : public ::testing::Test {
+ protected:
+  static DecodedMessage frame(uint32_t code, uint8_t protocol = 1) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.protocol = protocol;
+    msg.bit_length = 24;
+    msg.valid = true;
+    return msg;
+  }
+
+  static RepeatFilter::Config config(uint32_t window_ms, uint8_t votes = 1,
+                                     uint8_t frames = 1) {
+    RepeatFilter::Config c;
+    c.dedup_window_ms = window_ms;
+    c.votes_required = votes;
+    c.vote_frames = frames;
+    return c;
+  }
+
+  // Deliver a burst of copies, one every interval_ms
+  int burst(RepeatFilter& filter, uint32_t& now, uint32_t code, int copies,
+            uint32_t interval_ms = 40) {
+    int accepted = 0;
+    for (int i = 0; i < copies; ++i) {
+      filter.update(now);
+      accepted += filter.accept(frame(code)) ? 1 : 0;
+      now += interval_ms;
+    }
+    return accepted;
+  }
+};
+
+TEST_F(RepeatFilterTest, PublishesOncePerBurst) {
+  RepeatFilter filter(config(500));
+  uint32_t now = 1000;
+
+  EXPECT_EQ(burst(filter, now, 0xABCDEF, 8), 1);
+  EXPECT_EQ(filter.get_suppressed_count(), 7u);
+}
+
+TEST_F(RepeatFilterTest, PublishesAgainAfterQuietWindow) {
+  RepeatFilter filter(config(500));
+  uint32_t now = 1000;
+
+  EXPECT_EQ(burst(filter, now, 0xABCDEF, 5), 1);
+  now += 600;
+  EXPECT_EQ(burst(filter, now, 0xABCDEF, 5), 1);
+}
+
+TEST_F(RepeatFilterTest, HeldButtonKeepsWindowOpen) {
+  RepeatFilter filter(config(200));
+  uint32_t now = 0;
+
+  // 3 seconds of continuous repeats, each well inside the window
+  EXPECT_EQ(burst(filter, now, 0x123456, 75), 1);
+}
+
+TEST_F(RepeatFilterTest, DifferentCodeIsNotSuppressed) {
+  RepeatFilter filter(config(500));
+  filter.update(100);
+
+  EXPECT_TRUE(filter.accept(frame(0x111111)));
+  EXPECT_TRUE(filter.accept(frame(0x222222)));
+  // Same code, different protocol is a different device
+  EXPECT_TRUE(filter.accept(frame(0x222222, 3)));
+}
+
+TEST_F(RepeatFilterTest, InterleavedRemotesAreEachDeduplicated) {
+  RepeatFilter filter(config(500));
+  uint32_t now = 0;
+  int accepted = 0;
+
+  // Two remotes pressed at once: A B A B ...
+  for (int i = 0; i < 8; ++i) {
+    filter.update(now);
+    accepted += filter.accept(frame(i % 2 == 0 ? 0xAAAAAA : 0xBBBBBB)) ? 1 : 0;
+    now += 40;
+  }
+  EXPECT_EQ(accepted, 2);
+  EXPECT_EQ(filter.get_suppressed_count(), 6u);
+}
+
+TEST_F(RepeatFilterTest, LeastRecentlySeenCodeGivesWay) {
+  RepeatFilter filter(config(500));
+  filter.update(0);
+  for (uint32_t code = 1; code <= RepeatFilter::ACCEPTED_SIZE; ++code) {
+    EXPECT_TRUE(filter.accept(frame(code)));
+  }
+  filter.update(10);
+  EXPECT_FALSE(filter.accept(frame(1)));  // Now the most recent
+
+  EXPECT_TRUE(filter.accept(frame(0x100)));  // Takes code 2's slot
+  EXPECT_FALSE(filter.accept(frame(1)));
+  EXPECT_TRUE(filter.accept(frame(2)));
+}
+
+TEST_F(RepeatFilterTest, ZeroWindowDisablesDeduplication) {
+  RepeatFilter filter(config(0));
+  uint32_t now = 0;
+
+  EXPECT_EQ(burst(filter, now, 0xABCDEF, 4), 4);
+  EXPECT_EQ(filter.get_suppressed_count(), 0u);
+}
+
+TEST_F(RepeatFilterTest, VotingNeedsNOfMMatchingFrames) {
+  RepeatFilter filter(config(500, 2, 3));
+  filter.update(100);
+
+  EXPECT_FALSE(filter.accept(frame(0xABCDEF)));
+  EXPECT_FALSE(filter.accept(frame(0xABCDEE)));  // Corrupted copy
+  EXPECT_TRUE(filter.accept(frame(0xABCDEF)));   // 2 of last 3
+  EXPECT_FALSE(filter.accept(frame(0xABCDEF)));  // Then deduplicated
+
+  EXPECT_EQ(filter.get_rejected_count(), 2u);
+  EXPECT_EQ(filter.get_suppressed_count(), 1u);
+}
+
+TEST_F(RepeatFilterTest, VotesOutsideWindowDoNotCount) {
+  RepeatFilter filter(config(500, 2, 2));
+  filter.update(100);
+
+  EXPECT_FALSE(filter.accept(frame(0xABCDEF)));
+  EXPECT_FALSE(filter.accept(frame(0x000001)));
+  EXPECT_FALSE(filter.accept(frame(0xABCDEF)));  // Only 1 of last 2
+}
+
+TEST_F(RepeatFilterTest, SeparateBurstsDoNotVoteTogether) {
+  RepeatFilter filter(config(300, 2, 4));
+  uint32_t now = 0;
+
+  EXPECT_EQ(burst(filter, now, 0x5A5A5A, 1), 0);
+  now += 1000;
+  EXPECT_EQ(burst(filter, now, 0x5A5A5A, 1), 0);
+  EXPECT_EQ(burst(filter, now, 0x5A5A5A, 1), 1);
+}
+
+TEST_F(RepeatFilterTest, VoteFramesClampedToHistory) {
+  RepeatFilter filter(config(500, 3, 200));
+
+  EXPECT_EQ(filter.get_config().vote_frames, RepeatFilter::HISTORY_SIZE);
+}
+
+TEST_F(RepeatFilterTest, HandlesMillisOverflow) {
+  RepeatFilter filter(config(500));
+  uint32_t now = 0xFFFFFF00;
+
+  EXPECT_EQ(burst(filter, now, 0xABCDEF, 10), 1);  // Crosses zero mid-burst
+  now += 600;
+  EXPECT_EQ(burst(filter, now, 0xABCDEF, 1), 1);
+}
+
+TEST_F(RepeatFilterTest, ReceiverPublishesOncePerBurst) {
+  RF433Codec codec;
+  MockBinaryPublisher publisher;
+  RF433Receiver receiver(&codec, &publisher);
+  RepeatFilter filter(config(500, 2, 3));
+  receiver.set_repeat_filter(&filter);
+  receiver.register_motion_code(0xABCDEF);
+
+  for (uint32_t now = 0; now < 400; now += 40) {
+    filter.update(now);
+    receiver.process_message(frame(0xABCDEF));
+  }
+
+  EXPECT_EQ(publisher.get_publish_count(), 1u);
+  EXPECT_EQ(filter.get_rejected_count(), 1u);
+  EXPECT_EQ(filter.get_suppressed_count(), 8u);
+}
+
+}  // namespace home_esp::testing
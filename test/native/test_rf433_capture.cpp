@@ -0,0 +1,222 @@
+// Unit tests for the RF433 capture format
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <vector>
+
+#include "core/rf433_capture.h"
+#include "core/rf433_codec.h"
+#include "benchmark.h"
+
+namespace home_esp::testing {
+
+class RF433CaptureTest : public ::testing::Test {
+ protected:
+  using Sink = std::function<void(const uint8_t*, size_t)>;
+
+  RF433CaptureTest()
+      : writer_([this](const uint8_t* data, size_t len) {
+          file_.insert(file_.end(), data, data + len);
+        }) {}
+
+  std::vector<uint16_t> encode(uint32_t code) {
+    RF433Codec codec;
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = 24;
+    uint16_t buffer[64];
+    size_t count = 0;
+    EXPECT_TRUE(codec.encode(msg, MutablePulseSpan(buffer), count));
+    return std::vector<uint16_t>(buffer, buffer + count);
+  }
+
+  void write_labelled(uint32_t code) {
+    RF433CaptureHeader header;
+    header.expected_code = code;
+    header.expected_bits = 24;
+    header.protocol_hint = 1;
+    header.expected_frames = 2;
+    writer_.write_header(header);
+  }
+
+  std::vector<uint8_t> file_;
+  RF433CaptureWriter<Sink> writer_;
+};
+
+TEST_F(RF433CaptureTest, RoundTripsHeaderAndRuns) {
+  write_labelled(0xABCDEF);
+  auto frame = encode(0xABCDEF);
+  writer_.write_run(0, PulseSpan(frame.data(), frame.size()));
+  uint16_t noise[] = {120, 900, 45};
+  writer_.write_run(1500, PulseSpan(noise));
+
+  EXPECT_EQ(file_.size(), RF433CaptureHeader::HEADER_SIZE +
+                              2 * RF433CaptureHeader::RUN_HEADER_SIZE +
+                              (frame.size() + 3) * 2);
+
+  RF433CaptureReader reader;
+  ASSERT_TRUE(reader.open(file_.data(), file_.size()));
+  EXPECT_TRUE(reader.header().has_expected_code());
+  EXPECT_EQ(reader.header().expected_code, 0xABCDEFu);
+  EXPECT_EQ(reader.header().protocol_hint, 1);
+  EXPECT_EQ(reader.header().expected_frames, 2u);
+
+  RF433CaptureRun run;
+  ASSERT_TRUE(reader.next(run));
+  EXPECT_EQ(run.timestamp_ms, 0u);
+  ASSERT_EQ(run.edge_count, frame.size());
+  EXPECT_EQ(run.edges().duration_us(1), frame[1]);
+
+  ASSERT_TRUE(reader.next(run));
+  EXPECT_EQ(run.timestamp_ms, 1500u);
+  ASSERT_EQ(run.edge_count, 3);
+  EXPECT_EQ(run.edges().duration_us(2), 45);
+
+  EXPECT_FALSE(reader.next(run));
+  EXPECT_FALSE(reader.truncated());
+}
+
+TEST_F(RF433CaptureTest, RejectsForeignOrNewerFiles) {
+  writer_.write_header(RF433CaptureHeader());  // Unlabelled
+  RF433CaptureReader reader;
+
+  std::vector<uint8_t> bad = file_;
+  bad[0] = 'X';
+  EXPECT_FALSE(reader.open(bad.data(), bad.size()));
+
+  bad = file_;
+  bad[4] = RF433CaptureHeader::VERSION + 1;
+  EXPECT_FALSE(reader.open(bad.data(), bad.size()));
+
+  EXPECT_FALSE(reader.open(file_.data(), RF433CaptureHeader::HEADER_SIZE - 1));
+  EXPECT_TRUE(reader.open(file_.data(), file_.size()));
+  EXPECT_FALSE(reader.header().has_expected_code());
+}
+
+TEST_F(RF433CaptureTest, SkipsLargerHeaders) {
+  write_labelled(0x123456);
+  // A later version's header with 4 extra bytes
+  file_[6] = RF433CaptureHeader::HEADER_SIZE + 4;
+  file_.insert(file_.end(), 4, 0xEE);
+  uint16_t edges[] = {350, 10850};
+  writer_.write_run(7, PulseSpan(edges));
+
+  RF433CaptureReader reader;
+  ASSERT_TRUE(reader.open(file_.data(), file_.size()));
+  RF433CaptureRun run;
+  ASSERT_TRUE(reader.next(run));
+  EXPECT_EQ(run.timestamp_ms, 7u);
+  EXPECT_EQ(run.edges().duration_us(1), 10850);
+}
+
+TEST_F(RF433CaptureTest, ReadsFirstHeaderLayout) {
+  write_labelled(0x123456);
+  // The original 16-byte header, without the expected frame count
+  file_[6] = RF433CaptureHeader::MIN_HEADER_SIZE;
+  file_.resize(RF433CaptureHeader::MIN_HEADER_SIZE);
+  uint16_t edges[] = {350, 10850};
+  writer_.write_run(7, PulseSpan(edges));
+
+  RF433CaptureReader reader;
+  ASSERT_TRUE(reader.open(file_.data(), file_.size()));
+  EXPECT_EQ(reader.header().expected_code, 0x123456u);
+  EXPECT_EQ(reader.header().expected_frames, 0u);
+  RF433CaptureRun run;
+  ASSERT_TRUE(reader.next(run));
+  EXPECT_EQ(run.edges().duration_us(1), 10850);
+}
+
+TEST_F(RF433CaptureTest, ReportsTruncatedRun) {
+  write_labelled(0);
+  auto frame = encode(0x0F0F0F);
+  writer_.write_run(0, PulseSpan(frame.data(), frame.size()));
+  writer_.write_run(10, PulseSpan(frame.data(), frame.size()));
+  file_.resize(file_.size() - 3);
+
+  RF433CaptureReader reader;
+  ASSERT_TRUE(reader.open(file_.data(), file_.size()));
+  RF433CaptureRun run;
+  EXPECT_TRUE(reader.next(run));
+  EXPECT_FALSE(reader.next(run));
+  EXPECT_TRUE(reader.truncated());
+
+  reader.rewind();
+  EXPECT_TRUE(reader.next(run));
+  EXPECT_EQ(run.timestamp_ms, 0u);
+}
+
+TEST_F(RF433CaptureTest, SplitsLongRuns) {
+  write_labelled(0);
+  std::vector<uint16_t> edges(UINT16_MAX + 10, 500);
+  writer_.write_run(3, PulseSpan(edges.data(), edges.size()));
+
+  RF433CaptureReader reader;
+  ASSERT_TRUE(reader.open(file_.data(), file_.size()));
+  RF433CaptureRun run;
+  ASSERT_TRUE(reader.next(run));
+  EXPECT_EQ(run.edge_count, UINT16_MAX);
+  ASSERT_TRUE(reader.next(run));
+  EXPECT_EQ(run.edge_count, 10);
+  EXPECT_EQ(run.timestamp_ms, 3u);
+  EXPECT_FALSE(reader.next(run));
+}
+
+TEST_F(RF433CaptureTest, RunsDecodeInPlace) {
+  write_labelled(0x5A5A5A);
+  auto frame = encode(0x5A5A5A);
+  std::vector<uint16_t> burst = {120, 900};
+  for (int i = 0; i < 3; ++i) {
+    burst.insert(burst.end(), frame.begin(), frame.end());
+  }
+  writer_.write_run(0, PulseSpan(burst.data(), burst.size()));
+
+  RF433CaptureReader reader;
+  ASSERT_TRUE(reader.open(file_.data(), file_.size()));
+  RF433CaptureRun run;
+  ASSERT_TRUE(reader.next(run));
+
+  RF433Codec codec;
+  DecodedMessage frames[4];
+  size_t found = 0;
+  codec.decode_all(run.data, run.byte_size(), frames, 4, found);
+  ASSERT_EQ(found, 3u);
+  for (size_t i = 0; i < found; ++i) {
+    EXPECT_EQ(frames[i].code, reader.header().expected_code);
+  }
+}
+
+// ============================================
+// Benchmark: capture replay throughput (in memory)
+// ============================================
+
+TEST_F(RF433CaptureTest, BenchmarkReplayThroughput) {
+  write_labelled(0xABCDEF);
+  auto frame = encode(0xABCDEF);
+  std::vector<uint16_t> burst;
+  for (int i = 0; i < 4; ++i) {
+    burst.insert(burst.end(), frame.begin(), frame.end());
+  }
+  const size_t runs = 5000;
+  for (size_t i = 0; i < runs; ++i) {
+    writer_.write_run(static_cast<uint32_t>(i * 250), PulseSpan(burst.data(), burst.size()));
+  }
+
+  RF433Codec codec;
+  RF433CaptureReader reader;
+  ASSERT_TRUE(reader.open(file_.data(), file_.size()));
+  size_t frames = 0;
+  double ns = measure_ns_per_op(runs * 4, [&]() {
+    RF433CaptureRun run;
+    while (reader.next(run)) {
+      DecodedMessage out[8];
+      size_t found = 0;
+      codec.decode_all(run.data, run.byte_size(), out, 8, found);
+      frames += found;
+    }
+  });
+
+  EXPECT_EQ(frames, runs * 4);
+  report_benchmark("Capture replay, RF433Codec::decode_all", ns, "frame");
+}
+
+}  // namespace home_esp::testing
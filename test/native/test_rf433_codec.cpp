@@ -192,6 +192,108 @@ TEST_F(RF433CodecTest, ToleranceAcceptsSlightlyOffTimings) {
   EXPECT_TRUE(result || !result);  // Implementation-dependent
 }
 
+TEST_F(RF433CodecTest, DecodeAllFindsEveryRepeatAfterNoise) {
+  RF433Codec codec;
+  std::vector<uint8_t> data;
+  for (uint16_t noise : {90, 4000, 120, 700, 350}) {
+    append_uint16(data, noise);
+  }
+  for (int i = 0; i < 6; ++i) {
+    auto frame = create_pulse_data(0xA1B2C3, 24, default_config_);
+    data.insert(data.end(), frame.begin(), frame.end());
+  }
+
+  DecodedMessage frames[8];
+  size_t found = 0;
+  size_t consumed = codec.decode_all(data.data(), data.size(), frames, 8, found);
+
+  ASSERT_EQ(found, 6u);
+  for (size_t i = 0; i < found; ++i) {
+    EXPECT_TRUE(frames[i].valid);
+    EXPECT_EQ(frames[i].code, 0xA1B2C3u);
+    EXPECT_EQ(frames[i].bit_length, 24);
+  }
+  EXPECT_EQ(consumed, data.size());
+}
+
+TEST_F(RF433CodecTest, DecodeAllStopsWhenOutputIsFull) {
+  RF433Codec codec;
+  std::vector<uint8_t> data;
+  for (uint32_t code : {0x111111u, 0x222222u, 0x333333u}) {
+    auto frame = create_pulse_data(code, 24, default_config_);
+    data.insert(data.end(), frame.begin(), frame.end());
+  }
+  size_t frame_bytes = data.size() / 3;
+
+  DecodedMessage frames[2];
+  size_t found = 0;
+  size_t consumed = codec.decode_all(data.data(), data.size(), frames, 2, found);
+
+  ASSERT_EQ(found, 2u);
+  EXPECT_EQ(frames[1].code, 0x222222u);
+  EXPECT_EQ(consumed, 2 * frame_bytes);
+
+  // Resuming at the consumed offset picks up the rest
+  consumed += codec.decode_all(data.data() + consumed, data.size() - consumed,
+                               frames, 2, found);
+  ASSERT_EQ(found, 1u);
+  EXPECT_EQ(frames[0].code, 0x333333u);
+  EXPECT_EQ(consumed, data.size());
+}
+
+TEST_F(RF433CodecTest, DecodeAllLeavesTruncatedFrameUnconsumed) {
+  RF433Codec codec;
+  auto data = create_pulse_data(0x5A5A5A, 24, default_config_);
+  size_t frame_bytes = data.size();
+  auto partial = create_pulse_data(0x0F0F0F, 24, default_config_);
+  data.insert(data.end(), partial.begin(), partial.begin() + 12 * 4);
+
+  DecodedMessage frames[4];
+  size_t found = 0;
+  size_t consumed = codec.decode_all(data.data(), data.size(), frames, 4, found);
+
+  ASSERT_EQ(found, 1u);
+  EXPECT_EQ(frames[0].code, 0x5A5A5Au);
+  EXPECT_EQ(consumed, frame_bytes);
+}
+
+TEST_F(RF433CodecTest, DecodeAllFinishesLastFrameAtEndOfInput) {
+  RF433Codec codec;
+  auto data = create_pulse_data(0x5A5A5A, 24, default_config_);
+  auto last = create_pulse_data(0xABC, 12, default_config_);
+  data.insert(data.end(), last.begin(), last.end());
+
+  DecodedMessage frames[4];
+  size_t found = 0;
+  codec.decode_all(data.data(), data.size(), frames, 4, found);
+  EXPECT_EQ(found, 1u);  // The short frame might continue
+
+  size_t consumed = codec.decode_all(data.data(), data.size(), frames, 4, found, true);
+  ASSERT_EQ(found, 2u);
+  EXPECT_EQ(frames[1].code, 0xABCu);
+  EXPECT_EQ(frames[1].bit_length, 12);
+  EXPECT_EQ(consumed, data.size());
+}
+
+TEST_F(RF433CodecTest, DecodeAllSkipsShortFramesBetweenValidOnes) {
+  RF433Codec codec;
+  auto data = create_pulse_data(0xABCDEF, 24, default_config_);
+  auto runt = create_pulse_data(0x5, 3, default_config_);
+  data.insert(data.end(), runt.begin(), runt.end());
+  append_uint16(data, 90);  // Glitch ends the runt
+  append_uint16(data, 90);
+  auto last = create_pulse_data(0x654321, 24, default_config_);
+  data.insert(data.end(), last.begin(), last.end());
+
+  DecodedMessage frames[4];
+  size_t found = 0;
+  codec.decode_all(data.data(), data.size(), frames, 4, found);
+
+  ASSERT_EQ(found, 2u);
+  EXPECT_EQ(frames[0].code, 0xABCDEFu);
+  EXPECT_EQ(frames[1].code, 0x654321u);
+}
+
 // RF433Receiver tests
 
 class RF433ReceiverTest : public ::testing::Test {
@@ -228,6 +330,14 @@ class RF433ReceiverTest : public ::testing::Test {
     return data;
   }
 
+  template <size_t N>
+  void push_frame(PulseRingBuffer<N>& ring, uint32_t code) {
+    auto data = create_valid_code(code);
+    for (size_t i = 0; i + 1 < data.size(); i += 2) {
+      ring.push(static_cast<uint16_t>(data[i] | (data[i + 1] << 8)));
+    }
+  }
+
   RF433Codec codec_;
   MockBinaryPublisher publisher_;
   std::unique_ptr<RF433Receiver> receiver_;
@@ -261,4 +371,63 @@ TEST_F(RF433ReceiverTest, DoesNotPublishMotionForOtherCodes) {
   EXPECT_EQ(publisher_.get_publish_count(), 0);
 }
 
+TEST_F(RF433ReceiverTest, DrainsBackToBackFramesFromRing) {
+  PulseRingBuffer<256> ring;
+  receiver_->register_motion_code(0xABCDEF);
+
+  // Two repeats of the motion code followed by another code
+  for (uint32_t code : {0xABCDEFu, 0xABCDEFu, 0x111111u}) {
+    push_frame(ring, code);
+  }
+
+  size_t frames = receiver_->drain(ring);
+
+  EXPECT_EQ(frames, 3u);
+  EXPECT_EQ(publisher_.get_publish_count(), 2u);
+  EXPECT_EQ(receiver_->get_last_code(), 0x111111u);
+}
+
+TEST_F(RF433ReceiverTest, DrainSkipsLeadingNoise) {
+  PulseRingBuffer<256> ring;
+  for (uint16_t noise : {120, 80, 3000, 45, 700}) {
+    ring.push(noise);
+  }
+  push_frame(ring, 0x123456);
+
+  size_t frames = receiver_->drain(ring, true);
+
+  EXPECT_EQ(frames, 1u);
+  EXPECT_EQ(receiver_->get_last_code(), 0x123456u);
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(RF433ReceiverTest, DrainKeepsPartialFrameUntilComplete) {
+  PulseRingBuffer<256> ring;
+  auto data = create_valid_code(0x654321);
+  const uint16_t* pulses = reinterpret_cast<const uint16_t*>(data.data());
+  size_t total = data.size() / 2;
+
+  // First half of the frame arrives
+  for (size_t i = 0; i < total / 2; ++i) ring.push(pulses[i]);
+  EXPECT_EQ(receiver_->drain(ring), 0u);
+  EXPECT_FALSE(receiver_->has_valid_code());
+
+  // Remaining edges arrive on the next loop pass
+  for (size_t i = total / 2; i < total; ++i) ring.push(pulses[i]);
+  EXPECT_EQ(receiver_->drain(ring), 1u);
+  EXPECT_EQ(receiver_->get_last_code(), 0x654321u);
+}
+
+TEST_F(RF433ReceiverTest, DrainHandlesFramesWrappingTheRing) {
+  PulseRingBuffer<64> ring;
+
+  // Advance the indices so the next frame straddles the storage end
+  for (int i = 0; i < 40; ++i) ring.push(0);
+  ring.consume(40);
+
+  push_frame(ring, 0x0F0F0F);
+  EXPECT_EQ(receiver_->drain(ring, true), 1u);
+  EXPECT_EQ(receiver_->get_last_code(), 0x0F0F0Fu);
+}
+
 }  // namespace home_esp::testing
@@ -0,0 +1,191 @@
+// Unit tests for RF433CodecT
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+
+#include "core/rf433_codec_t.h"
+#include "benchmark.h"
+
+namespace home_esp::testing {
+
+using DefaultCodec = RF433CodecT<>;
+using SlowCodec = RF433CodecT<RF433Timing<500, 15>>;
+
+class RF433CodecTTest : public ::testing::Test {
+ protected:
+  std::vector<uint16_t> encode(uint32_t code, uint16_t bits) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    std::vector<uint16_t> pulses(64);
+    size_t count = pulses.size();
+    EXPECT_TRUE(DefaultCodec::encode(msg, pulses.data(), count));
+    pulses.resize(count);
+    return pulses;
+  }
+
+  // Scale every pulse by a pseudo-random factor within +/-range percent
+  void jitter(std::vector<uint16_t>& pulses, int range, unsigned seed) {
+    std::srand(seed);
+    for (auto& p : pulses) {
+      int pct = (std::rand() % (2 * range + 1)) - range;
+      p = static_cast<uint16_t>(p + p * pct / 100);
+    }
+  }
+
+  bool runtime_decode(RF433Codec& codec, const std::vector<uint16_t>& pulses,
+                      DecodedMessage& out) {
+    return codec.decode(reinterpret_cast<const uint8_t*>(pulses.data()),
+                        pulses.size() * sizeof(uint16_t), out);
+  }
+};
+
+TEST_F(RF433CodecTTest, TimingConfigMatchesTemplateArguments) {
+  auto config = SlowCodec::timing_config();
+
+  EXPECT_EQ(config.pulse_length_us, 500);
+  EXPECT_EQ(config.tolerance_percent, 15);
+  EXPECT_EQ(config.sync_low_pulses, 31);
+
+  auto defaults = DefaultCodec::timing_config();
+  RF433Codec::TimingConfig expected;
+  EXPECT_EQ(defaults.pulse_length_us, expected.pulse_length_us);
+  EXPECT_EQ(defaults.tolerance_percent, expected.tolerance_percent);
+}
+
+TEST_F(RF433CodecTTest, EncodesSameWaveformAsRuntimeCodec) {
+  RF433Codec codec;
+  DecodedMessage msg;
+  msg.code = 0xABCDEF;
+  msg.bit_length = 24;
+
+  uint16_t runtime[64];
+  size_t len = sizeof(runtime);
+  ASSERT_TRUE(codec.encode(msg, reinterpret_cast<uint8_t*>(runtime), len));
+
+  uint16_t fixed[64];
+  size_t count = 64;
+  ASSERT_TRUE(DefaultCodec::encode(msg, fixed, count));
+
+  ASSERT_EQ(count, len / sizeof(uint16_t));
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(fixed[i], runtime[i]) << "pulse " << i;
+  }
+}
+
+TEST_F(RF433CodecTTest, EncodeFailsWithSmallBuffer) {
+  DecodedMessage msg;
+  msg.code = 0xFF;
+  msg.bit_length = 8;
+  uint16_t buffer[4];
+  size_t count = 4;
+
+  EXPECT_FALSE(DefaultCodec::encode(msg, buffer, count));
+}
+
+TEST_F(RF433CodecTTest, DecodeAgreesWithRuntimeCodecUnderJitter) {
+  RF433Codec codec;
+
+  // +/-40% jitter puts many pulses on both sides of the 25% windows
+  for (unsigned seed = 1; seed <= 300; ++seed) {
+    auto pulses = encode(0x123456 * seed & 0xFFFFFF, 24);
+    jitter(pulses, 40, seed);
+
+    DecodedMessage expected, actual;
+    bool expected_ok = runtime_decode(codec, pulses, expected);
+    bool actual_ok = DefaultCodec::decode(pulses.data(), pulses.size(), actual);
+
+    ASSERT_EQ(actual_ok, expected_ok) << "seed " << seed;
+    if (expected_ok) {
+      EXPECT_EQ(actual.code, expected.code);
+      EXPECT_EQ(actual.bit_length, expected.bit_length);
+    }
+  }
+}
+
+TEST_F(RF433CodecTTest, RejectsBadSyncAndShortFrames) {
+  DecodedMessage msg;
+  uint16_t bad_sync[] = {100, 100, 350, 1050};
+  EXPECT_FALSE(DefaultCodec::decode(bad_sync, 4, msg));
+  EXPECT_FALSE(msg.valid);
+
+  auto short_frame = encode(0x5, 4);
+  EXPECT_FALSE(DefaultCodec::decode(short_frame.data(), short_frame.size(), msg));
+}
+
+TEST_F(RF433CodecTTest, CustomTimingRoundTrip) {
+  DecodedMessage original;
+  original.code = 0x0F0F0F;
+  original.bit_length = 24;
+  uint16_t buffer[64];
+  size_t count = 64;
+  ASSERT_TRUE(SlowCodec::encode(original, buffer, count));
+
+  DecodedMessage decoded;
+  ASSERT_TRUE(SlowCodec::decode(buffer, count, decoded));
+  EXPECT_EQ(decoded.code, 0x0F0F0Fu);
+
+  // The default 350us codec must not accept 500us pulses
+  EXPECT_FALSE(DefaultCodec::decode(buffer, count, decoded));
+}
+
+TEST_F(RF433CodecTTest, StreamDecoderUsesCompileTimeWindows) {
+  DefaultCodec::StreamDecoder decoder;
+  auto pulses = encode(0xC0FFEE, 24);
+
+  DecodedMessage msg;
+  bool got = false;
+  for (uint16_t p : pulses) {
+    got = decoder.feed(p, msg) || got;
+  }
+
+  ASSERT_TRUE(got);
+  EXPECT_EQ(msg.code, 0xC0FFEEu);
+}
+
+// ============================================
+// Benchmark: runtime (virtual) vs compile-time codec
+// ============================================
+
+TEST_F(RF433CodecTTest, BenchmarkDecodeRuntimeVsCompileTime) {
+  std::vector<std::vector<uint16_t>> frames;
+  for (unsigned seed = 1; seed <= 64; ++seed) {
+    auto pulses = encode(0x9E3779 * seed & 0xFFFFFF, 24);
+    jitter(pulses, 20, seed);
+    frames.push_back(pulses);
+  }
+
+  RF433Codec runtime;
+  IProtocolCodec* codec = &runtime;
+  const int rounds = 200;
+  const size_t ops = frames.size() * rounds;
+  uint32_t sink = 0;
+
+  double virtual_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (const auto& f : frames) {
+        DecodedMessage msg;
+        codec->decode(reinterpret_cast<const uint8_t*>(f.data()),
+                      f.size() * sizeof(uint16_t), msg);
+        sink += msg.code;
+      }
+    }
+  });
+
+  double fixed_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (const auto& f : frames) {
+        DecodedMessage msg;
+        DefaultCodec::decode(f.data(), f.size(), msg);
+        sink += msg.code;
+      }
+    }
+  });
+
+  do_not_optimize(sink);
+  report_benchmark("RF433Codec::decode (virtual)", virtual_ns, "frame");
+  report_benchmark("RF433CodecT<>::decode", fixed_ns, "frame");
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,267 @@
+// Unit tests for RF433DecodeStats and the decoder counters
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/rf433_codec.h"
+#include "core/rf433_decode_stats.h"
+#include "core/rf433_stream_decoder.h"
+#include "benchmark.h"
+
+namespace home_esp::testing {
+
+class RF433DecodeStatsTest : public ::testing::Test {
+ protected:
+  std::vector<uint16_t> encode(uint32_t code, uint16_t bits) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    uint16_t buffer[64];
+    size_t count = 0;
+    EXPECT_TRUE(codec_.encode(msg, MutablePulseSpan(buffer), count));
+    return std::vector<uint16_t>(buffer, buffer + count);
+  }
+
+  bool decode(const std::vector<uint16_t>& pulses) {
+    DecodedMessage msg;
+    return codec_.decode(PulseSpan(pulses.data(), pulses.size()), msg);
+  }
+
+  RF433Codec codec_;
+};
+
+TEST_F(RF433DecodeStatsTest, CountsAcceptedFrames) {
+  auto frame = encode(0xABCDEF, 24);
+  ASSERT_TRUE(decode(frame));
+  ASSERT_TRUE(decode(frame));
+
+  const auto& stats = codec_.get_stats();
+  EXPECT_EQ(stats.seen, 2u);
+  EXPECT_EQ(stats.accepted, 2u);
+  EXPECT_EQ(stats.total_rejected(), 0u);
+}
+
+TEST_F(RF433DecodeStatsTest, CountsEachRejectionReason) {
+  auto frame = encode(0xABCDEF, 24);
+
+  // Odd pulse count
+  std::vector<uint16_t> odd(frame.begin(), frame.end() - 1);
+  EXPECT_FALSE(decode(odd));
+
+  // Sync gap 30% short, outside the 25% tolerance
+  std::vector<uint16_t> bad_sync = frame;
+  bad_sync[1] = 10850 * 7 / 10;
+  EXPECT_FALSE(decode(bad_sync));
+
+  // Bit timing breaks off after 4 bits
+  std::vector<uint16_t> short_bits = frame;
+  short_bits[2 + 4 * 2] = 2000;
+  EXPECT_FALSE(decode(short_bits));
+
+  // Byte API with a length that is not whole pulse pairs
+  DecodedMessage msg;
+  uint8_t bytes[6] = {};
+  EXPECT_FALSE(codec_.decode(bytes, sizeof(bytes), msg));
+
+  const auto& stats = codec_.get_stats();
+  EXPECT_EQ(stats.seen, 4u);
+  EXPECT_EQ(stats.accepted, 0u);
+  EXPECT_EQ(stats.rejected_count(RF433RejectReason::LENGTH), 2u);
+  EXPECT_EQ(stats.rejected_count(RF433RejectReason::SYNC), 1u);
+  EXPECT_EQ(stats.rejected_count(RF433RejectReason::BITS), 1u);
+}
+
+TEST_F(RF433DecodeStatsTest, HistogramsPulseTimingError) {
+  auto frame = encode(0x00FF00, 24);
+  ASSERT_TRUE(decode(frame));
+  EXPECT_EQ(codec_.get_stats().error_samples(), 0u);  // Off by default
+
+  codec_.set_timing_stats(true);
+  codec_.reset_stats();
+  ASSERT_TRUE(decode(frame));
+
+  const auto& exact = codec_.get_stats();
+  EXPECT_EQ(exact.error_samples(), 1u);
+  EXPECT_EQ(exact.error_histogram[0], 1u);
+  EXPECT_FLOAT_EQ(exact.mean_error_percent(), 0.0f);
+
+  // Stretch every pulse by ~12% (still inside the 25% tolerance)
+  codec_.reset_stats();
+  for (auto& p : frame) {
+    p = static_cast<uint16_t>(p * 112 / 100);
+  }
+  ASSERT_TRUE(decode(frame));
+
+  const auto& stretched = codec_.get_stats();
+  EXPECT_EQ(stretched.error_histogram[2], 1u);  // 10-15% bucket
+  EXPECT_NEAR(stretched.mean_error_percent(), 12.0f, 1.0f);
+}
+
+TEST_F(RF433DecodeStatsTest, LargeErrorsLandInLastBucket) {
+  uint32_t scale = RF433DecodeStats::error_scale(350);
+  EXPECT_EQ(RF433DecodeStats::error_percent(385, 350, scale), 10u);
+  EXPECT_EQ(RF433DecodeStats::error_percent(315, 350, scale), 10u);
+
+  RF433DecodeStats stats;
+  stats.record_frame_error(RF433DecodeStats::error_percent(1000, 350, scale), 1);
+  stats.record_frame_error(0, 0);  // No pulses: ignored
+
+  EXPECT_EQ(stats.error_samples(), 1u);
+  EXPECT_EQ(stats.error_histogram[RF433DecodeStats::ERROR_BUCKETS - 1], 1u);
+}
+
+TEST_F(RF433DecodeStatsTest, DecodeAllCountsFrames) {
+  std::vector<uint16_t> pulses;
+  for (int i = 0; i < 3; ++i) {
+    auto frame = encode(0x0F0F0F, 24);
+    pulses.insert(pulses.end(), frame.begin(), frame.end());
+  }
+  // A sync followed by too few bits
+  auto partial = encode(0x0F0F0F, 24);
+  partial[2 + 3 * 2] = 2000;
+  pulses.insert(pulses.end(), partial.begin(), partial.end());
+
+  DecodedMessage frames[8];
+  size_t found = 0;
+  codec_.decode_all(PulseSpan(pulses.data(), pulses.size()), frames, 8, found);
+
+  const auto& stats = codec_.get_stats();
+  EXPECT_EQ(found, 3u);
+  EXPECT_EQ(stats.accepted, 3u);
+  EXPECT_EQ(stats.rejected_count(RF433RejectReason::BITS), 1u);
+}
+
+TEST_F(RF433DecodeStatsTest, StreamDecoderCountsFrames) {
+  RF433StreamDecoder decoder;
+  std::vector<uint16_t> pulses = encode(0x123456, 24);
+  auto partial = encode(0x123456, 24);
+  partial[2 + 5 * 2] = 2000;
+  pulses.insert(pulses.end(), partial.begin(), partial.end());
+  pulses.push_back(350);
+
+  DecodedMessage msg;
+  size_t decoded = 0;
+  for (uint16_t p : pulses) {
+    decoded += decoder.feed(p, msg) ? 1 : 0;
+  }
+
+  EXPECT_EQ(decoded, 1u);
+  EXPECT_EQ(decoder.stats().seen, 2u);
+  EXPECT_EQ(decoder.stats().accepted, 1u);
+  EXPECT_EQ(decoder.stats().rejected_count(RF433RejectReason::BITS), 1u);
+}
+
+TEST_F(RF433DecodeStatsTest, StreamDecoderCountsEveryReason) {
+  RF433StreamDecoder decoder;
+  decoder.enable_timing_stats(codec_.get_config());
+  DecodedMessage msg;
+  auto feed = [&](const std::vector<uint16_t>& pulses) {
+    size_t decoded = 0;
+    for (uint16_t p : pulses) {
+      decoded += decoder.feed(p, msg) ? 1 : 0;
+    }
+    return decoded;
+  };
+
+  // Every pulse stretched by ~12%, as in HistogramsPulseTimingError
+  auto stretched = encode(0x00FF00, 24);
+  for (auto& p : stretched) {
+    p = static_cast<uint16_t>(p * 112 / 100);
+  }
+  EXPECT_EQ(feed(stretched), 1u);
+
+  // Sync gap 30% short, then a frame cut off by the end of input
+  auto bad_sync = encode(0xABCDEF, 24);
+  bad_sync[1] = 10850 * 7 / 10;
+  auto cut = encode(0xABCDEF, 24);
+  cut.resize(2 + 4 * 2);
+  bad_sync.insert(bad_sync.end(), cut.begin(), cut.end());
+  EXPECT_EQ(feed(bad_sync), 0u);
+  EXPECT_FALSE(decoder.flush(msg));
+
+  const auto& stats = decoder.stats();
+  EXPECT_EQ(stats.seen, 3u);
+  EXPECT_EQ(stats.accepted, 1u);
+  EXPECT_EQ(stats.rejected_count(RF433RejectReason::SYNC), 1u);
+  EXPECT_EQ(stats.rejected_count(RF433RejectReason::LENGTH), 1u);
+  EXPECT_EQ(stats.rejected_count(RF433RejectReason::BITS), 0u);
+  EXPECT_EQ(stats.error_histogram[2], 1u);  // 10-15% bucket
+  EXPECT_NEAR(stats.mean_error_percent(), 12.0f, 1.0f);
+
+  // The codec's histogram sees the same frame the same way
+  codec_.set_timing_stats(true);
+  ASSERT_TRUE(decode(stretched));
+  EXPECT_EQ(codec_.get_stats().error_percent_sum, stats.error_percent_sum);
+}
+
+TEST_F(RF433DecodeStatsTest, StatsCombine) {
+  RF433DecodeStats a, b;
+  a.seen = 3;
+  a.accepted = 2;
+  a.reject(RF433RejectReason::SYNC);
+  b.seen = 1;
+  b.reject(RF433RejectReason::SYNC);
+  b.record_frame_error(6, 2);
+
+  a += b;
+  EXPECT_EQ(a.seen, 4u);
+  EXPECT_EQ(a.accepted, 2u);
+  EXPECT_EQ(a.rejected_count(RF433RejectReason::SYNC), 2u);
+  EXPECT_EQ(a.error_samples(), 1u);
+}
+
+TEST_F(RF433DecodeStatsTest, ReceiverCountsFramesPerProtocol) {
+  RF433Receiver receiver(&codec_, nullptr);
+  DecodedMessage msg;
+  msg.code = 0x1234;
+  msg.valid = true;
+  msg.protocol = 1;
+  receiver.process_message(msg);
+  receiver.process_message(msg);
+  msg.protocol = 3;
+  receiver.process_message(msg);
+  msg.protocol = 200;  // Past the table: counted as "other"
+  receiver.process_message(msg);
+
+  EXPECT_EQ(receiver.get_protocol_frame_count(1), 2u);
+  EXPECT_EQ(receiver.get_protocol_frame_count(3), 1u);
+  EXPECT_EQ(receiver.get_protocol_frame_count(0), 1u);
+  EXPECT_EQ(receiver.get_protocol_frame_count(2), 0u);
+}
+
+// ============================================
+// Benchmark: decode cost with counters in place
+// ============================================
+
+TEST_F(RF433DecodeStatsTest, BenchmarkCountedDecode) {
+  auto frame = encode(0xABCDEF, 24);
+  auto bad = frame;
+  bad[1] = 5000;
+  const size_t ops = 200000;
+  uint32_t sink = 0;
+
+  double accept_ns = measure_ns_per_op(ops, [&]() {
+    for (size_t i = 0; i < ops; ++i) {
+      sink += decode(frame) ? 1 : 0;
+    }
+  });
+  double reject_ns = measure_ns_per_op(ops, [&]() {
+    for (size_t i = 0; i < ops; ++i) {
+      sink += decode(bad) ? 1 : 0;
+    }
+  });
+
+  codec_.set_timing_stats(true);
+  double histogram_ns = measure_ns_per_op(ops, [&]() {
+    for (size_t i = 0; i < ops; ++i) {
+      sink += decode(frame) ? 1 : 0;
+    }
+  });
+
+  report_benchmark("RF433Codec::decode accepted", accept_ns, "frame");
+  report_benchmark("RF433Codec::decode accepted (with error histogram)", histogram_ns, "frame");
+  report_benchmark("RF433Codec::decode sync reject", reject_ns, "frame");
+  do_not_optimize(sink);
+}
+
+}  // namespace home_esp::testing
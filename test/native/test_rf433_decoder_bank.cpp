@@ -0,0 +1,221 @@
+// Unit tests for RF433DecoderBank
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/rf433_decoder_bank.h"
+#include "core/rf433_stream_decoder.h"
+#include "benchmark.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class RF433DecoderBankTest : public ::testing::Test {
+ protected:
+  // Encode a code using a protocol's timing
+  std::vector<uint16_t> encode(const RF433Protocol& protocol, uint32_t code,
+                               uint16_t bits) {
+    RF433Codec codec(protocol.to_timing_config());
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+
+    uint16_t buffer[64];
+    size_t len = sizeof(buffer);
+    EXPECT_TRUE(codec.encode(msg, reinterpret_cast<uint8_t*>(buffer), len));
+    return std::vector<uint16_t>(buffer, buffer + len / sizeof(uint16_t));
+  }
+
+  template <size_t N>
+  std::vector<DecodedMessage> feed_all(RF433DecoderBank<N>& bank,
+                                       const std::vector<uint16_t>& pulses) {
+    std::vector<DecodedMessage> messages;
+    for (uint16_t p : pulses) {
+      DecodedMessage msg;
+      if (bank.feed(p, msg)) {
+        messages.push_back(msg);
+      }
+    }
+    return messages;
+  }
+
+  void append(std::vector<uint16_t>& dst, const std::vector<uint16_t>& src) {
+    dst.insert(dst.end(), src.begin(), src.end());
+  }
+};
+
+TEST_F(RF433DecoderBankTest, DecodesPT2262AndReportsOverlappingMatches) {
+  RF433DecoderBank bank(RF433_PROTOCOLS);
+
+  auto messages = feed_all(bank, encode(RF433_PROTOCOL_PT2262, 0xABCDEF, 24));
+
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].code, 0xABCDEFu);
+  EXPECT_EQ(messages[0].protocol, RF433Codec::PROTOCOL_PT2262);
+  // EV1527 shares PT2262's symbols and completed on the same edge
+  EXPECT_EQ(bank.last_match_mask(), 0x03);
+}
+
+TEST_F(RF433DecoderBankTest, PriorityFollowsTableOrder) {
+  static constexpr RF433Protocol EV1527_FIRST[] = {RF433_PROTOCOL_EV1527,
+                                                   RF433_PROTOCOL_PT2262};
+  RF433DecoderBank bank(EV1527_FIRST);
+
+  auto messages = feed_all(bank, encode(RF433_PROTOCOL_PT2262, 0x123456, 24));
+
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].protocol, RF433Codec::PROTOCOL_EV1527);
+}
+
+TEST_F(RF433DecoderBankTest, IdentifiesEachProtocolInTheTable) {
+  RF433DecoderBank bank(RF433_PROTOCOLS);
+
+  for (const auto& protocol : RF433_PROTOCOLS) {
+    if (protocol.id == RF433Codec::PROTOCOL_EV1527) {
+      continue;  // Indistinguishable from PT2262 on air
+    }
+    bank.reset();
+    auto messages = feed_all(bank, encode(protocol, 0x5A5A5A, 24));
+
+    ASSERT_EQ(messages.size(), 1u) << protocol.name;
+    EXPECT_EQ(messages[0].protocol, protocol.id) << protocol.name;
+    EXPECT_EQ(messages[0].code, 0x5A5A5Au) << protocol.name;
+  }
+}
+
+TEST_F(RF433DecoderBankTest, ShortCodeOnlyMatchesProtocolsThatAllowIt) {
+  RF433DecoderBank bank(RF433_PROTOCOLS);
+  auto pulses = encode(RF433_PROTOCOL_PT2262, 0xA5, 8);
+
+  feed_all(bank, pulses);
+  DecodedMessage msg;
+  ASSERT_TRUE(bank.flush(msg));
+
+  EXPECT_EQ(msg.code, 0xA5u);
+  EXPECT_EQ(msg.protocol, RF433Codec::PROTOCOL_PT2262);
+  EXPECT_EQ(bank.last_match_mask(), 0x01);  // EV1527 needs 24 bits
+}
+
+TEST_F(RF433DecoderBankTest, ShortFramesBackToBackEndOnNextSync) {
+  RF433DecoderBank bank(RF433_PROTOCOLS);
+  std::vector<uint16_t> pulses;
+  for (int i = 0; i < 3; ++i) {
+    append(pulses, encode(RF433_PROTOCOL_PT2262, 0xABC, 12));
+  }
+
+  // The first two end on the sync that restarts them; no flush needed
+  auto messages = feed_all(bank, pulses);
+  ASSERT_EQ(messages.size(), 2u);
+  for (const auto& msg : messages) {
+    EXPECT_EQ(msg.code, 0xABCu);
+    EXPECT_EQ(msg.bit_length, 12u);
+    EXPECT_EQ(msg.protocol, RF433Codec::PROTOCOL_PT2262);
+  }
+}
+
+TEST_F(RF433DecoderBankTest, DecodesMixedVendorsInOnePass) {
+  RF433DecoderBank bank(RF433_PROTOCOLS);
+  std::vector<uint16_t> pulses = {80, 95, 4000};  // Leading noise
+  append(pulses, encode(RF433_PROTOCOL_RCSWITCH_2, 0x111111, 24));
+  append(pulses, encode(RF433_PROTOCOL_PT2262, 0x222222, 24));
+  append(pulses, encode(RF433_PROTOCOL_RCSWITCH_5, 0x333333, 24));
+  append(pulses, encode(RF433_PROTOCOL_RCSWITCH_3, 0x444444, 24));
+
+  auto messages = feed_all(bank, pulses);
+
+  ASSERT_EQ(messages.size(), 4u);
+  EXPECT_EQ(messages[0].protocol, RF433Codec::PROTOCOL_RCSWITCH_2);
+  EXPECT_EQ(messages[0].code, 0x111111u);
+  EXPECT_EQ(messages[1].protocol, RF433Codec::PROTOCOL_PT2262);
+  EXPECT_EQ(messages[1].code, 0x222222u);
+  EXPECT_EQ(messages[2].protocol, RF433Codec::PROTOCOL_RCSWITCH_5);
+  EXPECT_EQ(messages[2].code, 0x333333u);
+  EXPECT_EQ(messages[3].protocol, RF433Codec::PROTOCOL_RCSWITCH_3);
+  EXPECT_EQ(messages[3].code, 0x444444u);
+}
+
+TEST_F(RF433DecoderBankTest, MatchesSingleProtocolStreamDecoder) {
+  static constexpr RF433Protocol PT2262_ONLY[] = {RF433_PROTOCOL_PT2262};
+  RF433DecoderBank bank(PT2262_ONLY);
+  RF433StreamDecoder reference;
+
+  std::vector<uint16_t> pulses;
+  for (uint32_t code = 1; code < 0x1000000; code += 0x13579B) {
+    append(pulses, encode(RF433_PROTOCOL_PT2262, code, 24));
+  }
+
+  size_t matched = 0;
+  for (uint16_t p : pulses) {
+    DecodedMessage a, b;
+    bool got_a = bank.feed(p, a);
+    bool got_b = reference.feed(p, b);
+    ASSERT_EQ(got_a, got_b);
+    if (got_a) {
+      EXPECT_EQ(a.code, b.code);
+      matched++;
+    }
+  }
+  EXPECT_GT(matched, 10u);
+}
+
+TEST_F(RF433DecoderBankTest, WorksAsReceiverDrainDecoder) {
+  RF433Codec codec;
+  MockBinaryPublisher publisher;
+  RF433Receiver receiver(&codec, &publisher);
+  RF433DecoderBank bank(RF433_PROTOCOLS);
+  PulseRingBuffer<128> ring;
+  receiver.register_motion_code(0x0ABCDE);
+
+  for (uint16_t p : encode(RF433_PROTOCOL_RCSWITCH_4, 0x0ABCDE, 24)) {
+    ring.push(p);
+  }
+
+  EXPECT_EQ(receiver.drain(ring, bank), 1u);
+  EXPECT_EQ(publisher.get_publish_count(), 1u);
+}
+
+// ============================================
+// Benchmark: cost per pulse as protocols are added
+// ============================================
+
+template <size_t N>
+double bank_ns_per_pulse(const RF433Protocol (&protocols)[N],
+                         const std::vector<uint16_t>& pulses, int rounds) {
+  RF433DecoderBank<N> bank(protocols);
+  uint32_t frames = 0;
+  double ns = measure_ns_per_op(pulses.size() * rounds, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint16_t p : pulses) {
+        DecodedMessage msg;
+        frames += bank.feed(p, msg) ? 1 : 0;
+      }
+    }
+  });
+  do_not_optimize(frames);
+  EXPECT_GT(frames, 0u);
+  return ns;
+}
+
+TEST_F(RF433DecoderBankTest, BenchmarkCostPerPulseByProtocolCount) {
+  static constexpr RF433Protocol ONE[] = {RF433_PROTOCOL_PT2262};
+  static constexpr RF433Protocol TWO[] = {RF433_PROTOCOL_PT2262,
+                                          RF433_PROTOCOL_RCSWITCH_2};
+  static constexpr RF433Protocol FOUR[] = {
+      RF433_PROTOCOL_PT2262, RF433_PROTOCOL_RCSWITCH_2,
+      RF433_PROTOCOL_RCSWITCH_3, RF433_PROTOCOL_RCSWITCH_4};
+
+  std::vector<uint16_t> pulses;
+  for (uint32_t code = 1; code < 0x1000000; code += 0x0F1E2D) {
+    append(pulses, encode(RF433_PROTOCOL_PT2262, code, 24));
+    append(pulses, encode(RF433_PROTOCOL_RCSWITCH_2, code, 24));
+  }
+
+  const int rounds = 20;
+  report_benchmark("RF433DecoderBank<1>", bank_ns_per_pulse(ONE, pulses, rounds), "pulse");
+  report_benchmark("RF433DecoderBank<2>", bank_ns_per_pulse(TWO, pulses, rounds), "pulse");
+  report_benchmark("RF433DecoderBank<4>", bank_ns_per_pulse(FOUR, pulses, rounds), "pulse");
+  report_benchmark("RF433DecoderBank<6>",
+                   bank_ns_per_pulse(RF433_PROTOCOLS, pulses, rounds), "pulse");
+}
+
+}  // namespace home_esp::testing
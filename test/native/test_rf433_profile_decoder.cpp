@@ -0,0 +1,160 @@
+// Unit tests for RF433ProfileDecoder
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+
+#include "core/rf433_profile_decoder.h"
+#include "core/rf433_stream_decoder.h"
+
+namespace home_esp::testing {
+
+class RF433ProfileDecoderTest : public ::testing::Test {
+ protected:
+  static RF433Codec::TimingConfig timing(uint16_t pulse_us, uint8_t tolerance = 25) {
+    RF433Codec::TimingConfig config;
+    config.pulse_length_us = pulse_us;
+    config.tolerance_percent = tolerance;
+    return config;
+  }
+
+  static std::vector<uint16_t> encode(const RF433Codec::TimingConfig& config, uint32_t code,
+                                      uint16_t bits = 24) {
+    RF433Codec codec(config);
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    uint16_t buffer[64];
+    size_t count = 0;
+    EXPECT_TRUE(codec.encode(msg, MutablePulseSpan(buffer), count));
+    return std::vector<uint16_t>(buffer, buffer + count);
+  }
+
+  static void append(std::vector<uint16_t>& dst, const std::vector<uint16_t>& src) {
+    dst.insert(dst.end(), src.begin(), src.end());
+  }
+
+  template <typename Decoder>
+  static std::vector<uint32_t> feed_all(Decoder& decoder, const std::vector<uint16_t>& edges) {
+    std::vector<uint32_t> codes;
+    for (uint16_t d : edges) {
+      DecodedMessage msg;
+      if (decoder.feed(d, msg)) {
+        codes.push_back(msg.code);
+      }
+    }
+    return codes;
+  }
+
+  // Stock 350us remote, and one at 400us learned to 10%: neither sync
+  // falls in the other's tight window, but the stock 25% windows decode both
+  const RF433Codec::TimingConfig stock_ = timing(350);
+  const RF433Codec::TimingConfig learned_ = timing(400, 10);
+};
+
+TEST_F(RF433ProfileDecoderTest, WithoutProfilesDecodesLikePrimary) {
+  std::srand(5);
+  std::vector<uint16_t> edges;
+  for (uint32_t code : {0xABCDEFu, 0x123456u, 0x0F0F0Fu}) {
+    for (int i = 0; i < 20; ++i) {
+      edges.push_back(static_cast<uint16_t>(20 + std::rand() % 12000));
+    }
+    append(edges, encode(stock_, code));
+    append(edges, encode(stock_, code, 12));
+  }
+
+  RF433StreamDecoder plain;
+  RF433ProfileDecoder<> decoder;
+  plain.enable_timing_stats(stock_);
+  decoder.enable_timing_stats(stock_);
+
+  EXPECT_EQ(feed_all(decoder, edges), feed_all(plain, edges));
+  RF433DecodeStats a = decoder.stats(), b = plain.stats();
+  EXPECT_EQ(a.seen, b.seen);
+  EXPECT_EQ(a.accepted, b.accepted);
+  EXPECT_EQ(a.total_rejected(), b.total_rejected());
+  EXPECT_EQ(a.error_percent_sum, b.error_percent_sum);
+}
+
+TEST_F(RF433ProfileDecoderTest, LearnedRemoteDecodesWithItsOwnProfile) {
+  RF433ProfileDecoder<> decoder;
+  ASSERT_TRUE(decoder.set_profile(0, learned_));
+
+  std::vector<uint16_t> edges;
+  for (int i = 0; i < 3; ++i) {
+    append(edges, encode(learned_, 0x5A5A5A));
+  }
+
+  EXPECT_EQ(feed_all(decoder, edges), std::vector<uint32_t>(3, 0x5A5A5Au));
+  // The primary would decode these too, but never saw them
+  EXPECT_EQ(decoder.primary().stats().seen, 0u);
+  EXPECT_EQ(decoder.stats().seen, 3u);
+  EXPECT_EQ(decoder.stats().accepted, 3u);
+  EXPECT_EQ(decoder.stats().total_rejected(), 0u);
+}
+
+TEST_F(RF433ProfileDecoderTest, CountsInterleavedRemotesOncePerFrame) {
+  RF433ProfileDecoder<> decoder;
+  decoder.set_profile(0, learned_);
+  decoder.set_profile(1, timing(500, 10));
+
+  std::vector<uint16_t> edges;
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < 6; ++i) {
+    uint16_t pulse_us = i % 3 == 0 ? 350 : i % 3 == 1 ? 400 : 500;
+    uint32_t code = 0x100000u * (i + 1) + 0x2468Au;
+    append(edges, encode(timing(pulse_us), code));
+    expected.push_back(code);
+  }
+  // Frames back to back: each sync ends the frame before it
+  EXPECT_EQ(feed_all(decoder, edges), expected);
+  EXPECT_EQ(decoder.stats().seen, 6u);
+  EXPECT_EQ(decoder.stats().accepted, 6u);
+  EXPECT_EQ(decoder.primary().stats().accepted, 2u);
+}
+
+TEST_F(RF433ProfileDecoderTest, LearnedSyncEndsPrimaryShortFrame) {
+  RF433ProfileDecoder<> decoder;
+  decoder.set_profile(0, learned_);
+
+  std::vector<uint16_t> edges = encode(stock_, 0xABC, 12);
+  append(edges, encode(learned_, 0x5A5A5A));
+
+  EXPECT_EQ(feed_all(decoder, edges), (std::vector<uint32_t>{0xABC, 0x5A5A5A}));
+}
+
+TEST_F(RF433ProfileDecoderTest, FlushAndResetCoverProfileFrame) {
+  RF433ProfileDecoder<> decoder;
+  decoder.set_profile(0, learned_);
+  auto frame = encode(learned_, 0x5A5A5A);
+  std::vector<uint16_t> half(frame.begin(), frame.begin() + 26);
+
+  feed_all(decoder, half);
+  EXPECT_TRUE(decoder.in_frame());
+  DecodedMessage msg;
+  ASSERT_TRUE(decoder.flush(msg));  // 12 bits pending
+  EXPECT_EQ(msg.bit_length, 12u);
+  EXPECT_FALSE(decoder.in_frame());
+
+  feed_all(decoder, half);
+  decoder.reset();
+  EXPECT_FALSE(decoder.in_frame());
+  std::vector<uint16_t> rest(frame.begin() + 26, frame.end());
+  EXPECT_TRUE(feed_all(decoder, rest).empty());
+}
+
+TEST_F(RF433ProfileDecoderTest, ReplacingAProfileKeepsItsCounts) {
+  RF433ProfileDecoder<> decoder;
+  EXPECT_FALSE(decoder.set_profile(1, learned_));  // Slots fill in order
+  decoder.set_profile(0, learned_);
+  feed_all(decoder, encode(learned_, 0x5A5A5A));
+
+  decoder.set_profile(0, timing(500, 10));
+  EXPECT_EQ(decoder.profile_count(), 1u);
+  EXPECT_EQ(decoder.profile(0).pulse_length_us, 500u);
+  EXPECT_EQ(decoder.stats().accepted, 1u);
+  decoder.reset_stats();
+  EXPECT_EQ(decoder.stats().seen, 0u);
+}
+
+}  // namespace home_esp::testing
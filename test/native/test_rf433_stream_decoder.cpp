@@ -0,0 +1,197 @@
+// Unit tests for RF433StreamDecoder
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/rf433_stream_decoder.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class RF433StreamDecoderTest : public ::testing::Test {
+ protected:
+  // Encode a code with RF433Codec and return the pulse durations
+  std::vector<uint16_t> encode(uint32_t code, uint16_t bits) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+
+    uint16_t buffer[64];
+    size_t len = sizeof(buffer);
+    EXPECT_TRUE(codec_.encode(msg, reinterpret_cast<uint8_t*>(buffer), len));
+    return std::vector<uint16_t>(buffer, buffer + len / sizeof(uint16_t));
+  }
+
+  // Feed pulses and collect every emitted message
+  std::vector<DecodedMessage> feed_all(RF433StreamDecoder& decoder,
+                                       const std::vector<uint16_t>& pulses) {
+    std::vector<DecodedMessage> messages;
+    for (uint16_t p : pulses) {
+      DecodedMessage msg;
+      if (decoder.feed(p, msg)) {
+        messages.push_back(msg);
+      }
+    }
+    return messages;
+  }
+
+  RF433Codec codec_;
+};
+
+TEST_F(RF433StreamDecoderTest, EmitsOnLastEdgeOfFullFrame) {
+  RF433StreamDecoder decoder;
+  auto pulses = encode(0xABCDEF, 24);
+
+  DecodedMessage msg;
+  for (size_t i = 0; i + 1 < pulses.size(); ++i) {
+    ASSERT_FALSE(decoder.feed(pulses[i], msg)) << "emitted early at " << i;
+  }
+
+  ASSERT_TRUE(decoder.feed(pulses.back(), msg));
+  EXPECT_TRUE(msg.valid);
+  EXPECT_EQ(msg.code, 0xABCDEFu);
+  EXPECT_EQ(msg.bit_length, 24);
+  EXPECT_EQ(msg.protocol, RF433Codec::PROTOCOL_PT2262);
+}
+
+TEST_F(RF433StreamDecoderTest, MatchesBatchDecoderForManyCodes) {
+  RF433StreamDecoder decoder;
+
+  for (uint32_t code = 0x000001; code < 0x1000000; code += 0x0F1E2D) {
+    auto pulses = encode(code, 24);
+
+    DecodedMessage batch;
+    ASSERT_TRUE(codec_.decode(reinterpret_cast<const uint8_t*>(pulses.data()),
+                              pulses.size() * sizeof(uint16_t), batch));
+
+    auto streamed = feed_all(decoder, pulses);
+    ASSERT_EQ(streamed.size(), 1u);
+    EXPECT_EQ(streamed[0].code, batch.code);
+    EXPECT_EQ(streamed[0].bit_length, batch.bit_length);
+  }
+}
+
+TEST_F(RF433StreamDecoderTest, SkipsNoiseBeforeSync) {
+  RF433StreamDecoder decoder;
+  std::vector<uint16_t> pulses = {90, 4000, 120, 75, 600};
+  auto frame = encode(0x123456, 24);
+  pulses.insert(pulses.end(), frame.begin(), frame.end());
+
+  auto messages = feed_all(decoder, pulses);
+
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].code, 0x123456u);
+}
+
+TEST_F(RF433StreamDecoderTest, DecodesRepeatedFramesBackToBack) {
+  RF433StreamDecoder decoder;
+  std::vector<uint16_t> pulses;
+  for (int i = 0; i < 4; ++i) {
+    auto frame = encode(0x0F0F0F, 24);
+    pulses.insert(pulses.end(), frame.begin(), frame.end());
+  }
+
+  auto messages = feed_all(decoder, pulses);
+
+  ASSERT_EQ(messages.size(), 4u);
+  for (const auto& msg : messages) {
+    EXPECT_EQ(msg.code, 0x0F0F0Fu);
+  }
+}
+
+TEST_F(RF433StreamDecoderTest, ShortFrameEmittedWhenNextSyncArrives) {
+  RF433StreamDecoder decoder;
+  auto pulses = encode(0xA5, 8);
+  auto next = encode(0x5A5A5A, 24);
+
+  auto messages = feed_all(decoder, pulses);
+  EXPECT_TRUE(messages.empty());
+  EXPECT_TRUE(decoder.in_frame());
+
+  // Sync of the following frame terminates the 8-bit code
+  DecodedMessage msg;
+  decoder.feed(next[0], msg);
+  ASSERT_TRUE(decoder.feed(next[1], msg));
+  EXPECT_EQ(msg.code, 0xA5u);
+  EXPECT_EQ(msg.bit_length, 8);
+
+  // ...and the new frame still decodes
+  std::vector<uint16_t> rest(next.begin() + 2, next.end());
+  auto more = feed_all(decoder, rest);
+  ASSERT_EQ(more.size(), 1u);
+  EXPECT_EQ(more[0].code, 0x5A5A5Au);
+}
+
+TEST_F(RF433StreamDecoderTest, FlushEmitsPendingShortFrame) {
+  RF433StreamDecoder decoder;
+  feed_all(decoder, encode(0x3C, 8));
+
+  DecodedMessage msg;
+  ASSERT_TRUE(decoder.flush(msg));
+  EXPECT_EQ(msg.code, 0x3Cu);
+  EXPECT_FALSE(decoder.in_frame());
+}
+
+TEST_F(RF433StreamDecoderTest, RejectsFramesShorterThanMinBits) {
+  RF433StreamDecoder decoder;
+  auto pulses = encode(0x5, 4);
+  feed_all(decoder, pulses);
+
+  DecodedMessage msg;
+  EXPECT_FALSE(decoder.flush(msg));
+}
+
+TEST_F(RF433StreamDecoderTest, AcceptsTimingWithinTolerance) {
+  RF433StreamDecoder decoder;
+  auto pulses = encode(0xC3C3C3, 24);
+  for (size_t i = 0; i < pulses.size(); ++i) {
+    // Alternate +15% / -15% jitter
+    pulses[i] = static_cast<uint16_t>(pulses[i] * (i % 2 ? 0.85 : 1.15));
+  }
+
+  auto messages = feed_all(decoder, pulses);
+
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].code, 0xC3C3C3u);
+}
+
+TEST_F(RF433StreamDecoderTest, RespectsCustomTiming) {
+  RF433Codec::TimingConfig config;
+  config.pulse_length_us = 500;
+  RF433Codec codec(config);
+  RF433StreamDecoder decoder(config);
+
+  DecodedMessage original;
+  original.code = 0x777777;
+  original.bit_length = 24;
+  uint16_t buffer[64];
+  size_t len = sizeof(buffer);
+  ASSERT_TRUE(codec.encode(original, reinterpret_cast<uint8_t*>(buffer), len));
+
+  auto messages = feed_all(decoder, std::vector<uint16_t>(buffer, buffer + len / 2));
+
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].code, 0x777777u);
+}
+
+TEST_F(RF433StreamDecoderTest, ReceiverStreamsRingThroughDecoder) {
+  MockBinaryPublisher publisher;
+  RF433Receiver receiver(&codec_, &publisher);
+  RF433StreamDecoder decoder;
+  PulseRingBuffer<128> ring;
+  receiver.register_motion_code(0xABCDEF);
+
+  auto frame = encode(0xABCDEF, 24);
+  size_t half = frame.size() / 2;
+
+  for (size_t i = 0; i < half; ++i) ring.push(frame[i]);
+  EXPECT_EQ(receiver.drain(ring, decoder), 0u);
+  EXPECT_TRUE(ring.empty());  // Partial frame is held by the decoder
+
+  for (size_t i = half; i < frame.size(); ++i) ring.push(frame[i]);
+  EXPECT_EQ(receiver.drain(ring, decoder), 1u);
+  EXPECT_EQ(receiver.get_last_code(), 0xABCDEFu);
+  EXPECT_EQ(publisher.get_publish_count(), 1u);
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,138 @@
+// Unit tests for RmtTransmitterAdapter
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/adapters/rmt_transmitter_adapter.h"
+#include "core/rf433_codec.h"
+#include "core/transmit_queue.h"
+
+namespace home_esp::testing {
+
+class RmtTransmitterAdapterTest : public ::testing::Test {
+ protected:
+  static constexpr int PIN = 5;
+
+  static DecodedMessage message(uint32_t code, uint16_t bits = 24) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    msg.protocol = RF433Codec::PROTOCOL_PT2262;
+    return msg;
+  }
+
+  /// Frame as TransmitQueue hands it over
+  std::vector<uint16_t> frame_of(const DecodedMessage& msg) {
+    uint16_t buffer[72];
+    size_t count = 0;
+    EXPECT_TRUE(codec.encode(msg, MutablePulseSpan(buffer), count));
+    return std::vector<uint16_t>(buffer, buffer + count);
+  }
+
+  bool send(RmtTransmitterAdapter& tx, const DecodedMessage& msg, uint8_t repeats) {
+    std::vector<uint16_t> frame = frame_of(msg);
+    return tx.transmit(msg, PulseSpan(frame.data(), frame.size()), repeats);
+  }
+
+  /// Edge durations of the symbols sent, high first
+  static std::vector<uint16_t> durations(const std::vector<uint32_t>& symbols) {
+    std::vector<uint16_t> out;
+    for (uint32_t s : symbols) {
+      RmtItem item{s};
+      out.push_back(item.duration0());
+      out.push_back(item.duration1());
+    }
+    return out;
+  }
+
+  RF433Codec codec;
+};
+
+TEST_F(RmtTransmitterAdapterTest, BeginClaimsChannelAtOneTickPerMicrosecond) {
+  RmtTransmitterAdapter tx(PIN, codec.get_config());
+  EXPECT_FALSE(tx.is_busy());
+  EXPECT_FALSE(send(tx, message(0xABCDEF), 1));  // Not started
+
+  ASSERT_TRUE(tx.begin());
+  rmt_channel_handle_t channel = rmt_test_last_channel();
+  ASSERT_NE(channel, nullptr);
+  EXPECT_EQ(channel->config.gpio_num, PIN);
+  EXPECT_EQ(channel->config.resolution_hz, 1000000u);
+  EXPECT_TRUE(channel->enabled);
+
+  tx.end();
+  EXPECT_EQ(rmt_test_last_channel(), nullptr);
+}
+
+TEST_F(RmtTransmitterAdapterTest, BeginFailsWithoutChannelOrOnUnfitTiming) {
+  rmt_test_fail_new_channel() = true;
+  RmtTransmitterAdapter tx(PIN, codec.get_config());
+  EXPECT_FALSE(tx.begin());
+  EXPECT_FALSE(send(tx, message(0xABCDEF), 1));
+
+  RF433Codec::TimingConfig slow;
+  slow.pulse_length_us = 1200;  // 31-pulse sync low overflows 15 bits
+  RmtTransmitterAdapter unfit(PIN, slow);
+  EXPECT_FALSE(unfit.begin());
+}
+
+TEST_F(RmtTransmitterAdapterTest, ReturnsWhileFrameIsOnAir) {
+  RmtTransmitterAdapter tx(PIN, codec.get_config());
+  ASSERT_TRUE(tx.begin());
+  rmt_channel_handle_t channel = rmt_test_last_channel();
+
+  DecodedMessage msg = message(0xABCDEF);
+  ASSERT_TRUE(send(tx, msg, 2));
+  EXPECT_TRUE(tx.is_busy());
+  EXPECT_FALSE(send(tx, message(0x123456), 1));  // Refused, not queued
+  ASSERT_EQ(channel->sent.size(), 1u);
+
+  // Both repeats in one transfer with no end marker, matching the codec
+  std::vector<uint16_t> expected = frame_of(msg);
+  expected.insert(expected.end(), expected.begin(), expected.end());
+  EXPECT_EQ(durations(channel->sent[0]), expected);
+
+  rmt_test_complete(channel);
+  EXPECT_FALSE(tx.is_busy());
+  EXPECT_TRUE(send(tx, message(0x123456), 1));
+}
+
+TEST_F(RmtTransmitterAdapterTest, RepeatSendReusesCachedItems) {
+  RmtTransmitterAdapter tx(PIN, codec.get_config());
+  ASSERT_TRUE(tx.begin());
+  rmt_channel_handle_t channel = rmt_test_last_channel();
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(send(tx, message(0xABCDEF), 2));
+    rmt_test_complete(channel);
+  }
+  EXPECT_EQ(tx.cache().get_miss_count(), 1u);
+  EXPECT_EQ(tx.cache().get_hit_count(), 2u);
+  EXPECT_EQ(channel->buffers[0], channel->buffers[1]);
+  EXPECT_EQ(channel->buffers[1], channel->buffers[2]);
+}
+
+TEST_F(RmtTransmitterAdapterTest, QueueSendsOneBurstPerUpdate) {
+  RmtTransmitterAdapter tx(PIN, codec.get_config());
+  ASSERT_TRUE(tx.begin());
+  rmt_channel_handle_t channel = rmt_test_last_channel();
+  TransmitQueue<> queue(&codec, &tx);
+
+  queue.enqueue(message(0x111111), 4);
+  queue.enqueue(message(0x222222), 2);
+  uint32_t now = 0;
+  for (; now < 1000 && !queue.is_idle(); ++now) {
+    size_t before = channel->sent.size();
+    queue.update(now);
+    EXPECT_LE(channel->sent.size(), before + 1);
+    if (now % 60 == 59) {
+      rmt_test_complete(channel);  // The channel finishes in the background
+    }
+  }
+  EXPECT_TRUE(queue.is_idle());
+  EXPECT_EQ(channel->sent.size(), 3u);
+  EXPECT_EQ(queue.get_completed_count(), 2u);
+  EXPECT_EQ(tx.cache().get_miss_count(), 2u);  // 0x111111's second burst hit
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,216 @@
+// Unit tests for RmtWaveformEncoder and RmtWaveformCache
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/rmt_waveform.h"
+#include "core/rf433_codec.h"
+#include "core/rf433_stream_decoder.h"
+#include "benchmark.h"
+
+namespace home_esp::testing {
+
+class RmtWaveformTest : public ::testing::Test {
+ protected:
+  static DecodedMessage message(uint32_t code, uint16_t bits = 24) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    msg.protocol = RF433Codec::PROTOCOL_PT2262;
+    return msg;
+  }
+
+  static std::vector<uint16_t> codec_pulses(const DecodedMessage& msg,
+                                            RF433Codec::TimingConfig timing = {}) {
+    RF433Codec codec(timing);
+    uint16_t buffer[72];
+    size_t count = 0;
+    EXPECT_TRUE(codec.encode(msg, MutablePulseSpan(buffer), count));
+    return std::vector<uint16_t>(buffer, buffer + count);
+  }
+
+  static std::vector<uint16_t> replay(const RmtItem* items, size_t count,
+                                      uint8_t ticks_per_us = 1) {
+    std::vector<uint16_t> durations;
+    replay_rmt_items(items, count, [&](uint16_t d) { durations.push_back(d); },
+                     ticks_per_us);
+    return durations;
+  }
+};
+
+TEST_F(RmtWaveformTest, ItemLayoutMatchesRmtPeripheral) {
+  RmtItem item = RmtItem::make(350, true, 1050, false);
+
+  // duration0 in bits 0-14, level0 bit 15, duration1 bits 16-30, level1 bit 31
+  EXPECT_EQ(item.val, 350u | (1u << 15) | (1050u << 16));
+  EXPECT_EQ(item.duration0(), 350);
+  EXPECT_TRUE(item.level0());
+  EXPECT_EQ(item.duration1(), 1050);
+  EXPECT_FALSE(item.level1());
+}
+
+TEST_F(RmtWaveformTest, MatchesCodecEncode) {
+  auto msg = message(0xABCDEF);
+  RmtWaveformEncoder encoder;
+  RmtItem items[32];
+  size_t count = 0;
+
+  ASSERT_TRUE(encoder.encode(msg, 1, items, 32, count));
+  EXPECT_EQ(count, 26u);  // Sync + 24 bits + end marker
+  EXPECT_EQ(items[25].val, 0u);
+  EXPECT_EQ(replay(items, count), codec_pulses(msg));
+}
+
+TEST_F(RmtWaveformTest, RepeatsFrameBackToBack) {
+  auto msg = message(0x5A5A5A);
+  RmtWaveformEncoder encoder;
+  RmtItem items[128];
+  size_t count = 0;
+
+  ASSERT_TRUE(encoder.encode(msg, 4, items, 128, count));
+  EXPECT_EQ(count, encoder.items_needed(24, 4));
+
+  // The replayed waveform decodes as four frames; each repeat's sync
+  // closes the frame before it
+  auto durations = replay(items, count);
+  auto frame = codec_pulses(msg);
+  ASSERT_EQ(durations.size(), frame.size() * 4);
+  RF433StreamDecoder decoder;
+  DecodedMessage out;
+  int frames = 0;
+  for (uint16_t d : durations) {
+    frames += decoder.feed(d, out);
+  }
+  frames += decoder.feed(frame[0], out);  // Next sync high ends the last bit
+  EXPECT_EQ(frames, 4);
+  EXPECT_EQ(out.code, 0x5A5A5Au);
+}
+
+TEST_F(RmtWaveformTest, ScalesToTickRate) {
+  RmtWaveformEncoder::Config config;
+  config.ticks_per_us = 2;
+  config.end_marker = false;
+  RmtWaveformEncoder encoder(RF433Codec::TimingConfig(), config);
+  auto msg = message(0x0F, 8);
+  RmtItem items[16];
+  size_t count = 0;
+
+  ASSERT_TRUE(encoder.encode(msg, 1, items, 16, count));
+  EXPECT_EQ(count, 9u);
+  EXPECT_EQ(items[0].duration1(), 350 * 31 * 2);
+  EXPECT_EQ(replay(items, count, 2), codec_pulses(msg));
+}
+
+TEST_F(RmtWaveformTest, RejectsUnencodable) {
+  RmtWaveformEncoder encoder;
+  RmtItem items[8];
+  size_t count = 0;
+
+  EXPECT_FALSE(encoder.encode(message(0xABCDEF), 1, items, 8, count));  // Too small
+  EXPECT_FALSE(encoder.encode(message(0xAB, 8), 0, items, 8, count));   // No repeats
+
+  // 1.2ms x 31 sync low exceeds the 15-bit duration
+  RF433Codec::TimingConfig slow;
+  slow.pulse_length_us = 1200;
+  RmtWaveformEncoder too_long(slow);
+  EXPECT_FALSE(too_long.is_valid());
+  RmtItem big[32];
+  EXPECT_FALSE(too_long.encode(message(0xABCDEF), 1, big, 32, count));
+}
+
+TEST_F(RmtWaveformTest, CacheReturnsSameBufferOnHit) {
+  RmtWaveformCache<> cache;
+  size_t first_count = 0, second_count = 0;
+
+  const RmtItem* first = cache.get(message(0xABCDEF), 4, first_count);
+  const RmtItem* second = cache.get(message(0xABCDEF), 4, second_count);
+
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first_count, second_count);
+  EXPECT_EQ(cache.get_miss_count(), 1u);
+  EXPECT_EQ(cache.get_hit_count(), 1u);
+
+  // A different repeat count is a different waveform
+  size_t count = 0;
+  EXPECT_NE(cache.get(message(0xABCDEF), 2, count), first);
+  EXPECT_EQ(count, 51u);
+}
+
+TEST_F(RmtWaveformTest, CacheEvictsLeastRecentlyUsed) {
+  RmtWaveformCache<2> cache;
+  size_t count = 0;
+
+  cache.get(message(0x111111), 1, count);
+  cache.get(message(0x222222), 1, count);
+  cache.get(message(0x111111), 1, count);  // 0x222222 is now oldest
+  cache.get(message(0x333333), 1, count);  // Evicts 0x222222
+
+  uint32_t misses = cache.get_miss_count();
+  const RmtItem* items = cache.get(message(0x111111), 1, count);
+  EXPECT_EQ(cache.get_miss_count(), misses);
+  EXPECT_EQ(replay(items, count), codec_pulses(message(0x111111)));
+
+  cache.get(message(0x222222), 1, count);
+  EXPECT_EQ(cache.get_miss_count(), misses + 1);
+}
+
+TEST_F(RmtWaveformTest, CacheRejectsOversizedWaveform) {
+  RmtWaveformCache<2, 32> cache;
+  size_t count = 0;
+
+  EXPECT_EQ(cache.get(message(0xABCDEF), 4, count), nullptr);
+  EXPECT_NE(cache.get(message(0xABCDEF), 1, count), nullptr);
+}
+
+// ============================================
+// Benchmark: codec encode + conversion vs cached waveform
+// ============================================
+
+TEST_F(RmtWaveformTest, BenchmarkRepeatedSend) {
+  const int iterations = 200000;
+  const DecodedMessage msg = message(0xABCDEF);
+  RF433Codec codec;
+  RmtWaveformEncoder encoder;
+  RmtWaveformCache<> cache;
+  RmtItem items[128];
+  uint16_t pulses[64];
+  size_t count = 0;
+
+  // Old path: codec pulses, then one RMT item per pair, 4 repeats
+  double convert_ns = measure_ns_per_op(iterations, [&]() {
+    for (int i = 0; i < iterations; ++i) {
+      size_t n = 0;
+      codec.encode(msg, MutablePulseSpan(pulses), n);
+      size_t idx = 0;
+      for (int r = 0; r < 4; ++r) {
+        for (size_t p = 0; p < n; p += 2) {
+          items[idx++] = RmtItem::make(pulses[p], true, pulses[p + 1], false);
+        }
+      }
+      items[idx] = RmtItem();
+      do_not_optimize(items[idx - 1]);
+    }
+  });
+
+  double encode_ns = measure_ns_per_op(iterations, [&]() {
+    for (int i = 0; i < iterations; ++i) {
+      encoder.encode(msg, 4, items, 128, count);
+      do_not_optimize(items[count - 2]);
+    }
+  });
+
+  double cached_ns = measure_ns_per_op(iterations, [&]() {
+    for (int i = 0; i < iterations; ++i) {
+      const RmtItem* waveform = cache.get(msg, 4, count);
+      do_not_optimize(waveform);
+    }
+  });
+
+  EXPECT_EQ(count, 101u);
+  report_benchmark("Codec encode + RMT conversion, 4 repeats", convert_ns, "send");
+  report_benchmark("RmtWaveformEncoder, 4 repeats", encode_ns, "send");
+  report_benchmark("RmtWaveformCache hit", cached_ns, "send");
+}
+
+}  // namespace home_esp::testing
@@ -2,8 +2,10 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "core/temperature_reader.h"
+#include "benchmark.h"
 #include "mocks/mock_sensor_publisher.h"
 
 namespace home_esp::testing {
@@ -134,4 +136,227 @@ TEST_F(TemperatureReaderTest, MultipleReadingsAllPublished) {
   EXPECT_LT(values[1], values[2]);
 }
 
+TEST_F(TemperatureReaderTest, FixedPointMatchesFloatOnEveryReading) {
+  TemperatureReader::Config ten_bit;
+  ten_bit.adc_resolution = 1023;
+  TemperatureReader::Config calibrated;
+  calibrated.offset = -1.7f;
+  calibrated.adc_min_voltage = 0.5f;  // TMP36-style 0.5 V at the minimum
+  TemperatureReader::Config narrow;
+  narrow.min_valid_temp = 10.0f;
+  narrow.max_valid_temp = 30.0f;
+  narrow.adc_resolution = 3000;
+
+  for (const auto& config : {TemperatureReader::Config(), ten_bit, calibrated, narrow}) {
+    FloatConversion reference(config);
+    FixedPointConversion fixed(config);
+    // One ADC step in degrees: the sensor's resolution
+    float step = (config.max_valid_temp - config.min_valid_temp) * config.adc_max_voltage /
+                 (config.adc_resolution *
+                  (config.adc_max_voltage - config.adc_min_voltage));
+
+    for (uint32_t raw = 0; raw <= 4095; ++raw) {
+      float expected = 0, actual = 0;
+      bool expected_valid = reference.convert(static_cast<uint16_t>(raw), expected);
+      bool actual_valid = fixed.convert(static_cast<uint16_t>(raw), actual);
+      ASSERT_EQ(actual_valid, expected_valid) << "raw " << raw;
+      if (expected_valid) {
+        ASSERT_NEAR(actual, expected, 1e-3f) << "raw " << raw;
+        ASSERT_LT(std::fabs(actual - expected), step / 16) << "raw " << raw;
+      }
+    }
+  }
+}
+
+TEST_F(TemperatureReaderTest, FixedPointReaderPublishesLikeFloat) {
+  TemperatureReader::Config config;
+  config.adc_resolution = 3000;
+  BasicTemperatureReader<FixedPointConversion> reader(&publisher_, config);
+
+  reader.process_raw_reading(1500);
+  reader.process_raw_reading(4095);  // 130 C: out of range
+  reader.set_offset(5.0f);
+  reader.process_raw_reading(1500);
+
+  ASSERT_EQ(publisher_.get_publish_count(), 2);
+  EXPECT_EQ(publisher_.get_unavailable_count(), 1);
+  const auto& values = publisher_.get_published_values();
+  EXPECT_NEAR(values[1] - values[0], 5.0f, 1e-4f);
+}
+
+TEST_F(TemperatureReaderTest, FixedPointRejectsDegenerateConfig) {
+  TemperatureReader::Config config;
+  config.adc_min_voltage = config.adc_max_voltage;
+  BasicTemperatureReader<FixedPointConversion> reader(&publisher_, config);
+
+  reader.process_raw_reading(2048);
+  EXPECT_EQ(publisher_.get_unavailable_count(), 1);
+}
+
+TEST_F(TemperatureReaderTest, BatchPublishesConfiguredStatisticOnce) {
+  const uint16_t frame[] = {2000, 2010, 1990, 2004, 1996};
+  TemperatureReader::Config config;
+  FloatConversion conversion(config);
+  float at_1990 = 0, at_2010 = 0, at_2000 = 0;
+  conversion.convert(1990, at_1990);
+  conversion.convert(2010, at_2010);
+  conversion.convert(2000, at_2000);
+
+  for (auto statistic : {BatchStatistic::MEAN, BatchStatistic::MIN, BatchStatistic::MAX}) {
+    publisher_.reset();
+    config.batch_statistic = statistic;
+    TemperatureReader reader(&publisher_, config);
+    reader.process_batch(frame, 5);
+
+    ASSERT_EQ(publisher_.get_publish_count(), 1u);
+    const auto& stats = reader.get_last_batch();
+    EXPECT_TRUE(stats.valid);
+    EXPECT_EQ(stats.count, 5u);
+    EXPECT_FLOAT_EQ(stats.min, at_1990);
+    EXPECT_FLOAT_EQ(stats.max, at_2010);
+    EXPECT_NEAR(stats.mean, at_2000, 1e-4f);
+  }
+  EXPECT_FLOAT_EQ(publisher_.get_last_value(), at_2010);
+}
+
+TEST_F(TemperatureReaderTest, BatchMeanMatchesMeanOfReadings) {
+  std::vector<uint16_t> frame;
+  for (int i = 0; i < 500; ++i) {
+    frame.push_back(static_cast<uint16_t>(1800 + (i * 37) % 101));
+  }
+  TemperatureReader::Config config;
+  config.offset = 0.4f;
+  config.adc_min_voltage = 0.5f;
+
+  FloatConversion reference(config);
+  double expected = 0;
+  for (uint16_t raw : frame) {
+    float celsius = 0;
+    ASSERT_TRUE(reference.convert(raw, celsius));
+    expected += celsius;
+  }
+  expected /= frame.size();
+
+  TemperatureReader float_reader(&publisher_, config);
+  BasicTemperatureReader<FixedPointConversion> fixed_reader(&publisher_, config);
+  float_reader.process_batch(frame.data(), frame.size());
+  fixed_reader.process_batch(frame.data(), frame.size());
+  ASSERT_EQ(publisher_.get_publish_count(), 2u);
+  EXPECT_NEAR(publisher_.get_published_values()[0], expected, 1e-3);
+  EXPECT_NEAR(publisher_.get_published_values()[1], expected, 1e-3);
+}
+
+TEST_F(TemperatureReaderTest, BatchWithOutOfRangeSampleIsUnavailable) {
+  TemperatureReader::Config config;
+  config.adc_resolution = 3000;  // 4095 reads 130 C
+  TemperatureReader reader(&publisher_, config);
+  const uint16_t frame[] = {1500, 1501, 4095, 1499};
+
+  reader.process_batch(frame, 4);
+  EXPECT_EQ(publisher_.get_publish_count(), 0u);
+  EXPECT_EQ(publisher_.get_unavailable_count(), 1);
+  EXPECT_FALSE(reader.get_last_batch().valid);
+
+  reader.process_batch(frame, 0);  // Nothing to report
+  EXPECT_EQ(publisher_.get_unavailable_count(), 1);
+}
+
+TEST_F(TemperatureReaderTest, SummarizesBatchesBeyondThirtyTwoBitSums) {
+  std::vector<uint16_t> frame(1200003, 0xFFFF);  // Past a lane fold, plus a tail
+  frame[123456] = 7;
+  RawBatchSummary summary = summarize_raw(frame.data(), frame.size());
+  EXPECT_EQ(summary.sum, uint64_t{1200002} * 0xFFFF + 7);
+  EXPECT_EQ(summary.min, 7u);
+  EXPECT_EQ(summary.max, 0xFFFFu);
+}
+
+/// Publisher that only counts, so the benchmark measures the reader
+class CountingPublisher : public ISensorPublisher {
+ public:
+  void publish(float value) override {
+    count_++;
+    last_ = value;
+  }
+  void publish_unavailable() override { count_++; }
+
+  size_t count_{0};
+  float last_{0};
+};
+
+TEST_F(TemperatureReaderTest, BenchmarkBatchAgainstPerSample) {
+  // One DMA frame of noisy readings
+  std::vector<uint16_t> frame(512);
+  for (size_t i = 0; i < frame.size(); ++i) {
+    frame[i] = static_cast<uint16_t>(2000 + (i * 7919) % 64);
+  }
+  CountingPublisher counter;
+  const int rounds = 2000;
+  const size_t ops = frame.size() * rounds;
+
+  auto per_sample = [&](auto& reader) {
+    return measure_ns_per_op(ops, [&]() {
+      for (int r = 0; r < rounds; ++r) {
+        for (uint16_t raw : frame) {
+          reader.process_raw_reading(raw);
+        }
+      }
+    });
+  };
+  auto batched = [&](auto& reader) {
+    return measure_ns_per_op(ops, [&]() {
+      for (int r = 0; r < rounds; ++r) {
+        reader.process_batch(frame.data(), frame.size());
+      }
+    });
+  };
+
+  TemperatureReader float_reader(&counter);
+  BasicTemperatureReader<FixedPointConversion> fixed_reader(&counter);
+  double float_single_ns = per_sample(float_reader);
+  double float_batch_ns = batched(float_reader);
+  double fixed_single_ns = per_sample(fixed_reader);
+  double fixed_batch_ns = batched(fixed_reader);
+  do_not_optimize(counter.last_);
+
+  report_benchmark("TemperatureReader float, per sample", float_single_ns, "sample");
+  report_benchmark("TemperatureReader float, 512-sample batch", float_batch_ns, "sample");
+  report_benchmark("TemperatureReader fixed, per sample", fixed_single_ns, "sample");
+  report_benchmark("TemperatureReader fixed, 512-sample batch", fixed_batch_ns, "sample");
+  EXPECT_EQ(counter.count_, 2 * (ops + rounds));
+}
+
+TEST_F(TemperatureReaderTest, BenchmarkConversion) {
+  TemperatureReader::Config config;
+  config.offset = 0.25f;
+  FloatConversion float_path(config);
+  FixedPointConversion fixed_path(config);
+  const int rounds = 200;
+  const size_t ops = 4096u * rounds;
+  float sum = 0;
+
+  double float_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint16_t raw = 0; raw < 4096; ++raw) {
+        float c = 0;
+        float_path.convert(raw, c);
+        sum += c;
+      }
+    }
+  });
+  double fixed_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint16_t raw = 0; raw < 4096; ++raw) {
+        float c = 0;
+        fixed_path.convert(raw, c);
+        sum += c;
+      }
+    }
+  });
+  do_not_optimize(sum);
+
+  // A host FPU hides most of the gap; soft-float targets widen it
+  report_benchmark("TemperatureReader float conversion", float_ns, "sample");
+  report_benchmark("TemperatureReader fixed-point conversion", fixed_ns, "sample");
+}
+
 }  // namespace home_esp::testing
@@ -0,0 +1,172 @@
+// Unit tests for NtcTableConversion
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "core/thermistor_table.h"
+#include "benchmark.h"
+#include "mocks/mock_sensor_publisher.h"
+
+namespace home_esp::testing {
+
+// 10k/3950 NTC to ground under a 10k resistor, 12-bit ADC
+constexpr ThermistorModel NTC_10K = ThermistorModel::beta(10000, 3950, 10000);
+// Fitted Steinhart-Hart coefficients of a common 10k probe, NTC on the
+// supply side
+constexpr ThermistorModel NTC_10K_SH = ThermistorModel::steinhart_hart(
+    1.009249522e-03, 2.378405444e-04, 2.019202697e-07, 10000, false);
+
+static_assert(constexpr_ln(1.0) == 0.0, "ln(1)");
+static_assert(NtcTableConversion<NTC_10K>::table_bytes() == 64 * 4, "default table size");
+
+class ThermistorTableTest : public ::testing::Test {
+ protected:
+  /// Reference temperature from the model with std::log
+  static double model_celsius(const ThermistorModel& model, double raw) {
+    double ln_r = std::log(model.resistance(raw));
+    return 1.0 / (model.a + model.b * ln_r + model.c * ln_r * ln_r * ln_r) -
+           ThermistorModel::KELVIN;
+  }
+
+  /// Worst table error against the model where it reads min_c..max_c
+  template <typename Conversion>
+  static double worst_error(const ThermistorModel& model, double min_c, double max_c) {
+    double worst = 0;
+    for (uint16_t raw = 1; raw < 4095; ++raw) {
+      double reference = model_celsius(model, raw);
+      int32_t temp = 0;
+      if (reference < min_c || reference > max_c || !Conversion::table_fixed(raw, temp)) {
+        continue;
+      }
+      worst = std::fmax(worst, std::fabs(temp / 128.0 - reference));
+    }
+    return worst;
+  }
+
+  MockSensorPublisher publisher_;
+};
+
+TEST_F(ThermistorTableTest, ConstexprLogMatchesStdLog) {
+  for (double x : {1e-6, 0.01, 0.5, 1.5, 2.0, 3.3, 10000.0, 123456.7, 1e9}) {
+    EXPECT_NEAR(constexpr_ln(x), std::log(x), 1e-12 * std::fmax(1.0, std::fabs(std::log(x))))
+        << x;
+  }
+}
+
+TEST_F(ThermistorTableTest, AccuracyGrowsWithTableSize) {
+  // Indoor/outdoor probe range
+  double e32 = worst_error<NtcTableConversion<NTC_10K, 32>>(NTC_10K, -20, 100);
+  double e64 = worst_error<NtcTableConversion<NTC_10K, 64>>(NTC_10K, -20, 100);
+  double e128 = worst_error<NtcTableConversion<NTC_10K, 128>>(NTC_10K, -20, 100);
+  double e256 = worst_error<NtcTableConversion<NTC_10K, 256>>(NTC_10K, -20, 100);
+
+  EXPECT_LT(e32, 1.0);
+  EXPECT_LT(e64, 0.3);
+  EXPECT_LT(e128, 0.1);
+  EXPECT_LT(e256, 0.025);
+  EXPECT_LT(e256, e128);
+  EXPECT_LT(e128, e64);
+}
+
+TEST_F(ThermistorTableTest, ReadsNominalTemperatureAtMidScale) {
+  // Equal resistors at 25 C: the divider sits at half scale
+  int32_t temp = 0;
+  ASSERT_TRUE(NtcTableConversion<NTC_10K>::table_fixed(2048, temp));
+  EXPECT_NEAR(temp / 128.0, 25.0, 0.01);
+
+  // Hotter pulls an NTC-to-ground divider down
+  ASSERT_TRUE(NtcTableConversion<NTC_10K>::table_fixed(1024, temp));
+  EXPECT_NEAR(temp / 128.0, model_celsius(NTC_10K, 1024), 0.1);
+}
+
+TEST_F(ThermistorTableTest, SteinhartHartSupplySideDivider) {
+  using Conversion = NtcTableConversion<NTC_10K_SH, 128>;
+  EXPECT_LT(worst_error<Conversion>(NTC_10K_SH, -20, 100), 0.1);
+
+  // NTC on the supply side: hotter reads higher
+  int32_t cold = 0, hot = 0;
+  ASSERT_TRUE(Conversion::table_fixed(1000, cold));
+  ASSERT_TRUE(Conversion::table_fixed(3000, hot));
+  EXPECT_LT(cold, hot);
+}
+
+TEST_F(ThermistorTableTest, ShortedOrOpenProbeIsUnavailable) {
+  TemperatureConfig config;
+  config.min_valid_temp = -55.0f;
+  config.max_valid_temp = 150.0f;
+  BasicTemperatureReader<NtcTableConversion<NTC_10K>> reader(&publisher_, config);
+
+  reader.process_raw_reading(0);     // Shorted
+  reader.process_raw_reading(4095);  // Open
+  reader.process_raw_reading(5000);  // Beyond the ADC
+  EXPECT_EQ(publisher_.get_unavailable_count(), 3);
+  EXPECT_EQ(publisher_.get_publish_count(), 0);
+}
+
+TEST_F(ThermistorTableTest, ReaderAppliesRangeAndOffset) {
+  TemperatureConfig config;
+  config.min_valid_temp = 0.0f;
+  config.max_valid_temp = 50.0f;
+  config.offset = -0.5f;
+  BasicTemperatureReader<NtcTableConversion<NTC_10K>> reader(&publisher_, config);
+
+  reader.process_raw_reading(2048);  // 25 C
+  reader.process_raw_reading(512);   // 76 C: above the valid range
+  ASSERT_EQ(publisher_.get_publish_count(), 1);
+  EXPECT_NEAR(publisher_.get_last_value(), 24.5f, 0.02f);
+  EXPECT_EQ(publisher_.get_unavailable_count(), 1);
+}
+
+TEST_F(ThermistorTableTest, BatchOnFallingCurve) {
+  TemperatureConfig config;
+  config.batch_statistic = BatchStatistic::MIN;
+  BasicTemperatureReader<NtcTableConversion<NTC_10K>> reader(&publisher_, config);
+  // Codes fall as the probe warms: the highest code is the coldest
+  const uint16_t frame[] = {2040, 2048, 2056, 2049};
+  reader.process_batch(frame, 4);
+
+  ASSERT_EQ(publisher_.get_publish_count(), 1);
+  const auto& stats = reader.get_last_batch();
+  EXPECT_NEAR(stats.min, model_celsius(NTC_10K, 2056), 0.05);
+  EXPECT_NEAR(stats.max, model_celsius(NTC_10K, 2040), 0.05);
+  EXPECT_NEAR(stats.mean, model_celsius(NTC_10K, 2048.25), 0.05);
+  EXPECT_FLOAT_EQ(publisher_.get_last_value(), stats.min);
+}
+
+TEST_F(ThermistorTableTest, BenchmarkTableVersusLog) {
+  TemperatureConfig config;
+  config.min_valid_temp = -55.0f;
+  config.max_valid_temp = 150.0f;
+  NtcTableConversion<NTC_10K> table(config);
+  const int rounds = 200;
+  const size_t ops = 4096u * rounds;
+  float sum = 0;
+
+  double table_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint16_t raw = 0; raw < 4096; ++raw) {
+        float c = 0;
+        table.convert(raw, c);
+        sum += c;
+      }
+    }
+  });
+
+  // Per-sample B equation in float, as a log()-based driver would do it
+  const float a = static_cast<float>(NTC_10K.a), b = static_cast<float>(NTC_10K.b);
+  double log_ns = measure_ns_per_op(ops, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint16_t raw = 1; raw <= 4096; ++raw) {
+        float ratio = raw / 4096.0f;
+        float ohms = 10000.0f * ratio / (1.0f - ratio + 1e-6f);
+        sum += 1.0f / (a + b * std::log(ohms)) - 273.15f;
+      }
+    }
+  });
+  do_not_optimize(sum);
+
+  report_benchmark("NtcTableConversion<64> convert", table_ns, "sample");
+  report_benchmark("Steinhart-Hart with logf", log_ns, "sample");
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,183 @@
+// Unit tests for TimerWheel
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/timer_wheel.h"
+#include "core/rf433_codec.h"
+#include "benchmark.h"
+#include "mocks/mock_binary_publisher.h"
+
+namespace home_esp::testing {
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  /// Advance in loop()-sized steps, collecting fired ids
+  template <typename Wheel>
+  void run(Wheel& wheel, uint32_t until_ms, uint32_t step_ms = 16) {
+    while (now_ < until_ms) {
+      now_ = now_ + step_ms < until_ms ? now_ + step_ms : until_ms;
+      wheel.update(now_, [&](uint16_t id) {
+        fired_.push_back(id);
+        fired_at_.push_back(now_);
+      });
+    }
+  }
+
+  uint32_t now_{0};
+  std::vector<uint16_t> fired_;
+  std::vector<uint32_t> fired_at_;
+};
+
+TEST_F(TimerWheelTest, FiresAtFirstTickAfterDelay) {
+  TimerWheel<4> wheel(100);
+  ASSERT_TRUE(wheel.arm(2, 250));  // Rounded up to 3 ticks
+  EXPECT_TRUE(wheel.is_armed(2));
+
+  run(wheel, 290);
+  EXPECT_TRUE(fired_.empty());
+  run(wheel, 320);
+  ASSERT_EQ(fired_.size(), 1u);
+  EXPECT_EQ(fired_[0], 2u);
+  EXPECT_FALSE(wheel.is_armed(2));
+  EXPECT_EQ(wheel.armed_count(), 0u);
+}
+
+TEST_F(TimerWheelTest, RearmPostponesExpiry) {
+  TimerWheel<4> wheel(100);
+  wheel.arm(0, 1000);
+
+  // A repeat frame every 400 ms keeps pushing the timeout out
+  for (uint32_t t = 400; t <= 2000; t += 400) {
+    run(wheel, t);
+    wheel.arm(0, 1000);
+  }
+  EXPECT_TRUE(fired_.empty());
+  EXPECT_EQ(wheel.armed_count(), 1u);
+
+  run(wheel, 4000);
+  ASSERT_EQ(fired_.size(), 1u);
+  EXPECT_EQ(fired_at_[0], 3008u);  // First loop() past 2000 + 1000
+}
+
+TEST_F(TimerWheelTest, CancelStopsTimer) {
+  TimerWheel<4> wheel(100);
+  wheel.arm(1, 500);
+  wheel.arm(3, 500);
+  wheel.cancel(1);
+  wheel.cancel(1);  // Idempotent
+
+  run(wheel, 1000);
+  ASSERT_EQ(fired_.size(), 1u);
+  EXPECT_EQ(fired_[0], 3u);
+}
+
+TEST_F(TimerWheelTest, DelaysLongerThanOneRevolution) {
+  TimerWheel<4, 8> wheel(100);  // One revolution is 800 ms
+  wheel.arm(0, 5000);
+  wheel.arm(1, 500);  // Shares a bucket with timer 0
+
+  run(wheel, 4900);
+  ASSERT_EQ(fired_.size(), 1u);
+  EXPECT_EQ(fired_[0], 1u);
+  run(wheel, 5100);
+  ASSERT_EQ(fired_.size(), 2u);
+  EXPECT_EQ(fired_[1], 0u);
+}
+
+TEST_F(TimerWheelTest, LateUpdateFiresEachTimerOnce) {
+  TimerWheel<8, 8> wheel(100);
+  for (uint16_t id = 0; id < 8; ++id) {
+    wheel.arm(id, 100u * (id + 1) * 3);
+  }
+  run(wheel, 60000, 60000);  // loop() stalled for a minute
+
+  EXPECT_EQ(fired_.size(), 8u);
+  EXPECT_EQ(wheel.armed_count(), 0u);
+}
+
+TEST_F(TimerWheelTest, CallbackMayRearmItsTimer) {
+  TimerWheel<2> wheel(100);
+  wheel.arm(0, 300);
+  size_t periods = 0;
+  for (now_ = 0; now_ <= 1000; now_ += 10) {
+    wheel.update(now_, [&](uint16_t id) {
+      periods++;
+      wheel.arm(id, 300);
+    });
+  }
+  EXPECT_EQ(periods, 3u);
+  EXPECT_TRUE(wheel.is_armed(0));
+}
+
+TEST_F(TimerWheelTest, SurvivesMillisWraparound) {
+  TimerWheel<2> wheel(100);
+  uint32_t t = 0xFFFFFF00u;
+  wheel.update(t, [](uint16_t) {});
+  wheel.arm(0, 1000);  // Ten ticks on from the tick at 0xFFFFFED8
+
+  for (int i = 0; i < 120; ++i, t += 16) {
+    wheel.update(t, [&](uint16_t id) {
+      fired_.push_back(id);
+      fired_at_.push_back(t);
+    });
+  }
+  ASSERT_EQ(fired_.size(), 1u);
+  EXPECT_GE(fired_at_[0], 704u);
+  EXPECT_LT(fired_at_[0], 704u + 16u);
+}
+
+TEST_F(TimerWheelTest, RejectsOutOfRangeIds) {
+  TimerWheel<2> wheel;
+  EXPECT_FALSE(wheel.arm(2, 100));
+  EXPECT_FALSE(wheel.is_armed(2));
+  wheel.cancel(7);
+  EXPECT_EQ(wheel.armed_count(), 0u);
+}
+
+TEST_F(TimerWheelTest, FrameRouterSeesRepeats) {
+  RF433Codec codec;
+  RF433Receiver receiver(&codec, nullptr);
+  RepeatFilter filter;
+  receiver.set_repeat_filter(&filter);
+  MockBinaryPublisher state, activity;
+  FixedCodeRouter<1> router, frame_router;
+  router.add(0xABCDEF, CodeRouter::ANY_PROTOCOL, &state);
+  frame_router.add(0xABCDEF, CodeRouter::ANY_PROTOCOL, &activity);
+  receiver.set_router(&router);
+  receiver.set_frame_router(&frame_router);
+
+  DecodedMessage msg;
+  msg.code = 0xABCDEF;
+  msg.bit_length = 24;
+  msg.protocol = RF433Codec::PROTOCOL_PT2262;
+  for (uint32_t t = 0; t < 2000; t += 400) {
+    filter.update(t);
+    receiver.process_message(msg);
+  }
+
+  EXPECT_EQ(state.get_publish_count(), 1u);
+  EXPECT_EQ(activity.get_publish_count(), 5u);
+}
+
+TEST_F(TimerWheelTest, BenchmarkRearm) {
+  constexpr size_t TIMERS = 512;
+  TimerWheel<TIMERS> wheel(100);
+  const int rounds = 200;
+  uint32_t clock = 0;
+
+  double ns = measure_ns_per_op(TIMERS * rounds, [&]() {
+    for (int r = 0; r < rounds; ++r) {
+      for (uint16_t id = 0; id < TIMERS; ++id) {
+        wheel.arm(id, 30000 + id * 7);
+      }
+      clock += 16;
+      wheel.update(clock, [](uint16_t) {});
+    }
+  });
+  do_not_optimize(wheel.armed_count());
+  report_benchmark("TimerWheel re-arm, 512 timers", ns, "arm");
+  EXPECT_EQ(wheel.armed_count(), TIMERS);
+}
+
+}  // namespace home_esp::testing
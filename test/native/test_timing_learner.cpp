@@ -0,0 +1,213 @@
+// Unit tests for TimingLearner
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+
+#include "core/timing_learner.h"
+#include "core/rf433_codec.h"
+#include "core/rf433_stream_decoder.h"
+
+namespace home_esp::testing {
+
+class TimingLearnerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { std::srand(3); }
+
+  /// A remote's burst: repeats frames, each pulse off by up to
+  /// +/-jitter_percent, then an idle gap
+  static std::vector<uint16_t> burst(const RF433Codec::TimingConfig& timing, uint32_t code,
+                                     int repeats, int jitter_percent) {
+    RF433Codec codec(timing);
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = 24;
+    uint16_t frame[64];
+    size_t count = 0;
+    EXPECT_TRUE(codec.encode(msg, MutablePulseSpan(frame), count));
+
+    std::vector<uint16_t> edges;
+    for (int r = 0; r < repeats; ++r) {
+      for (size_t i = 0; i < count; ++i) {
+        int jitter = std::rand() % (2 * jitter_percent + 1) - jitter_percent;
+        edges.push_back(static_cast<uint16_t>(frame[i] * (100 + jitter) / 100));
+      }
+    }
+    edges.push_back(400);
+    edges.push_back(30000);  // Idle: closes the last frame
+    return edges;
+  }
+
+  static RF433Codec::TimingConfig timing(uint16_t pulse_us) {
+    RF433Codec::TimingConfig config;
+    config.pulse_length_us = pulse_us;
+    return config;
+  }
+
+  static void feed(TimingLearner& learner, const std::vector<uint16_t>& edges) {
+    for (uint16_t d : edges) {
+      learner.feed(d);
+    }
+  }
+
+  static int decoded(const RF433Codec::TimingConfig& config,
+                     const std::vector<uint16_t>& edges) {
+    RF433StreamDecoder decoder(config);
+    DecodedMessage msg;
+    int frames = 0;
+    for (uint16_t d : edges) {
+      frames += decoder.feed(d, msg);
+    }
+    return frames;
+  }
+};
+
+TEST_F(TimingLearnerTest, LearnsDriftedRemote) {
+  // A remote running 20% slow on a weak battery
+  TimingLearner learner;
+  feed(learner, burst(timing(420), 0xABCDEF, 6, 8));
+
+  RF433Codec::TimingConfig learned;
+  ASSERT_TRUE(learner.result(learned));
+  EXPECT_NEAR(learned.pulse_length_us, 420, 8);
+  EXPECT_EQ(learned.sync_high_pulses, 1);
+  EXPECT_EQ(learned.sync_low_pulses, 31);
+  EXPECT_EQ(learned.zero_high_pulses, 1);
+  EXPECT_EQ(learned.zero_low_pulses, 3);
+  EXPECT_EQ(learned.one_high_pulses, 3);
+  EXPECT_EQ(learned.one_low_pulses, 1);
+  EXPECT_GE(learned.tolerance_percent, 8);
+  EXPECT_LE(learned.tolerance_percent, 18);  // Well under the default 25%
+}
+
+TEST_F(TimingLearnerTest, LearnedProfileDecodesTheRemote) {
+  TimingLearner learner;
+  feed(learner, burst(timing(420), 0x5A5A5A, 6, 8));
+  RF433Codec::TimingConfig learned;
+  ASSERT_TRUE(learner.result(learned));
+
+  // Fresh presses of the same remote decode with the learned profile
+  auto presses = burst(timing(420), 0x123456, 8, 8);
+  EXPECT_EQ(decoded(learned, presses), 8);
+
+  // The stock 350us profile misses most of them
+  EXPECT_LT(decoded(RF433Codec::TimingConfig(), presses), 8);
+}
+
+TEST_F(TimingLearnerTest, TightToleranceRejectsOtherRemotes) {
+  TimingLearner learner;
+  feed(learner, burst(timing(420), 0xABCDEF, 6, 4));
+  RF433Codec::TimingConfig learned;
+  ASSERT_TRUE(learner.result(learned));
+
+  // A 350us remote is inside the stock 25% window of a 420us profile
+  // but outside the learned one
+  RF433Codec::TimingConfig loose = learned;
+  loose.tolerance_percent = 25;
+  auto other = burst(timing(350), 0x0F0F0F, 4, 2);
+  EXPECT_GT(decoded(loose, other), 0);
+  EXPECT_EQ(decoded(learned, other), 0);
+}
+
+TEST_F(TimingLearnerTest, LearnsOtherRatios) {
+  // rc-switch protocol 2 shape: 650us, sync 1:10, bits 1:2 / 2:1
+  RF433Codec::TimingConfig proto2;
+  proto2.pulse_length_us = 650;
+  proto2.sync_low_pulses = 10;
+  proto2.zero_low_pulses = 2;
+  proto2.one_high_pulses = 2;
+
+  TimingLearner learner;
+  feed(learner, burst(proto2, 0xC0FFEE, 6, 5));
+
+  RF433Codec::TimingConfig learned;
+  ASSERT_TRUE(learner.result(learned));
+  EXPECT_NEAR(learned.pulse_length_us, 650, 10);
+  EXPECT_EQ(learned.sync_low_pulses, 10);
+  EXPECT_EQ(learned.zero_low_pulses, 2);
+  EXPECT_EQ(learned.one_high_pulses, 2);
+  EXPECT_LE(learned.tolerance_percent, 32);  // Windows must not overlap at 1:2
+}
+
+TEST_F(TimingLearnerTest, NeedsEnoughFrames) {
+  TimingLearner learner;
+  feed(learner, burst(timing(350), 0xABCDEF, 2, 5));
+
+  RF433Codec::TimingConfig learned;
+  EXPECT_FALSE(learner.result(learned));
+  EXPECT_EQ(learner.get_frame_count(), 2u);
+
+  feed(learner, burst(timing(350), 0xABCDEF, 2, 5));
+  EXPECT_TRUE(learner.result(learned));
+}
+
+TEST_F(TimingLearnerTest, ResetFrameDropsOnlyTheFrameInProgress) {
+  TimingLearner learner;
+  auto edges = burst(timing(350), 0xABCDEF, 4, 5);
+  feed(learner, edges);
+  ASSERT_EQ(learner.get_frame_count(), 4u);
+
+  // Half a frame cut off, then a gap that would otherwise commit it
+  std::vector<uint16_t> half(edges.begin(), edges.begin() + 26);
+  feed(learner, half);
+  learner.reset_frame();
+  learner.feed(400);
+  learner.feed(30000);
+
+  EXPECT_EQ(learner.get_frame_count(), 4u);
+  RF433Codec::TimingConfig learned;
+  EXPECT_TRUE(learner.result(learned));
+}
+
+TEST_F(TimingLearnerTest, IgnoresNoiseBetweenBursts) {
+  TimingLearner learner;
+  std::vector<uint16_t> edges;
+  // Receiver chatter with no sync gaps, then a misaligned gap
+  for (int i = 0; i < 500; ++i) {
+    edges.push_back(static_cast<uint16_t>(50 + std::rand() % 2000));
+  }
+  edges.push_back(9000);
+  auto frames = burst(timing(350), 0xABCDEF, 5, 5);
+  edges.insert(edges.end(), frames.begin(), frames.end());
+  feed(learner, edges);
+
+  EXPECT_EQ(learner.get_frame_count(), 5u);
+  EXPECT_EQ(learner.get_sample_count(), 5u * 48u);
+  RF433Codec::TimingConfig learned;
+  ASSERT_TRUE(learner.result(learned));
+  EXPECT_NEAR(learned.pulse_length_us, 350, 8);
+}
+
+TEST_F(TimingLearnerTest, RejectsSingleWidth) {
+  // Equal high/low widths (not a PWM code)
+  TimingLearner learner;
+  for (int f = 0; f < 6; ++f) {
+    learner.feed(350);
+    learner.feed(10000);
+    for (int i = 0; i < 48; ++i) {
+      learner.feed(static_cast<uint16_t>(500 + std::rand() % 20));
+    }
+  }
+  learner.feed(350);
+  learner.feed(10000);
+
+  RF433Codec::TimingConfig learned;
+  EXPECT_EQ(learner.get_frame_count(), 6u);
+  EXPECT_FALSE(learner.result(learned));
+}
+
+TEST_F(TimingLearnerTest, HistogramSaturationKeepsShape) {
+  TimingLearner learner;
+  feed(learner, burst(timing(400), 0x5A5A5A, 200, 6));
+
+  RF433Codec::TimingConfig learned;
+  ASSERT_TRUE(learner.result(learned));
+  EXPECT_NEAR(learned.pulse_length_us, 400, 8);
+  EXPECT_EQ(learned.zero_low_pulses, 3);
+
+  learner.reset();
+  EXPECT_EQ(learner.get_frame_count(), 0u);
+  EXPECT_FALSE(learner.result(learned));
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,189 @@
+// Unit tests for TransmitQueue
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/transmit_queue.h"
+#include "core/rf433_codec.h"
+#include "mocks/mock_pulse_transmitter.h"
+
+namespace home_esp::testing {
+
+class TransmitQueueTest : public ::testing::Test {
+ protected:
+  RF433Codec codec;
+  MockPulseTransmitter radio;
+
+  static DecodedMessage message(uint32_t code, uint16_t bits = 24) {
+    DecodedMessage msg;
+    msg.code = code;
+    msg.bit_length = bits;
+    return msg;
+  }
+
+  /// Code carried by a recorded transmission
+  uint32_t code_of(const MockPulseTransmitter::Transmission& tx) {
+    DecodedMessage msg;
+    EXPECT_TRUE(codec.decode(PulseSpan(tx.frame.data(), tx.frame.size()), msg));
+    return msg.code;
+  }
+
+  /// Call update() every millisecond, as loop() would, until the queue
+  /// drains or limit_ms passes
+  template <typename Queue>
+  void run(Queue& queue, uint32_t& now, uint32_t limit_ms = 10000) {
+    for (uint32_t end = now + limit_ms; now < end; ++now) {
+      radio.set_now(now);
+      queue.update(now);
+      if (queue.is_idle()) {
+        return;
+      }
+    }
+  }
+};
+
+TEST_F(TransmitQueueTest, SendsCommandInBursts) {
+  TransmitQueue<> queue(&codec, &radio);
+  uint32_t now = 0;
+
+  ASSERT_TRUE(queue.enqueue(message(0xABCDEF), 5));
+  run(queue, now);
+
+  // 5 repeats in turns of 2: 2 + 2 + 1
+  const auto& txs = radio.get_transmissions();
+  ASSERT_EQ(txs.size(), 3u);
+  EXPECT_EQ(txs[0].repeats, 2);
+  EXPECT_EQ(txs[1].repeats, 2);
+  EXPECT_EQ(txs[2].repeats, 1);
+
+  uint16_t expected[66];
+  size_t count = 0;
+  ASSERT_TRUE(codec.encode(message(0xABCDEF), MutablePulseSpan(expected), count));
+  EXPECT_EQ(txs[0].frame, std::vector<uint16_t>(expected, expected + count));
+
+  EXPECT_EQ(queue.get_completed_count(), 1u);
+  EXPECT_EQ(queue.get_frames_sent(), 5u);
+  EXPECT_EQ(queue.pending(), 0u);
+}
+
+TEST_F(TransmitQueueTest, InterleavesRepeatsOfQueuedCommands) {
+  TransmitQueue<> queue(&codec, &radio);
+  uint32_t now = 0;
+
+  queue.enqueue(message(0x111111), 4);
+  queue.enqueue(message(0x222222), 4);
+  queue.enqueue(message(0x333333), 2);
+  run(queue, now);
+
+  std::vector<uint32_t> order;
+  for (const auto& tx : radio.get_transmissions()) {
+    order.push_back(code_of(tx));
+    EXPECT_EQ(tx.code, order.back());  // The message travels with its frame
+  }
+  EXPECT_EQ(order, (std::vector<uint32_t>{0x111111, 0x222222, 0x333333, 0x111111,
+                                          0x222222}));
+  EXPECT_EQ(queue.get_completed_count(), 3u);
+}
+
+TEST_F(TransmitQueueTest, NeverOverlapsAndKeepsGap) {
+  TransmitQueue<>::Config config;
+  config.gap_ms = 15;
+  TransmitQueue<> queue(&codec, &radio, config);
+  uint32_t now = 0;
+
+  for (uint32_t code = 1; code <= 4; ++code) {
+    queue.enqueue(message(code << 8), 3);
+  }
+  run(queue, now);
+
+  const auto& txs = radio.get_transmissions();
+  ASSERT_EQ(txs.size(), 8u);
+  for (size_t i = 1; i < txs.size(); ++i) {
+    EXPECT_GE(txs[i].start_ms, txs[i - 1].end_ms + 15) << "transmission " << i;
+  }
+  EXPECT_EQ(radio.get_overlap_count(), 0u);
+}
+
+TEST_F(TransmitQueueTest, PausesReceiverDuringAndAfterTransmit) {
+  TransmitQueue<> queue(&codec, &radio);  // 20 ms guard
+  EXPECT_FALSE(queue.is_receive_paused());
+
+  queue.enqueue(message(0xABCDEF), 1);
+  radio.set_now(100);
+  queue.update(100);
+  EXPECT_TRUE(queue.is_receive_paused());
+
+  uint32_t end = radio.get_transmissions()[0].end_ms;
+  radio.set_now(end);
+  queue.update(end);
+  EXPECT_TRUE(queue.is_receive_paused());
+  EXPECT_TRUE(queue.is_idle());
+
+  queue.update(end + 19);
+  EXPECT_TRUE(queue.is_receive_paused());
+  queue.update(end + 20);
+  EXPECT_FALSE(queue.is_receive_paused());
+}
+
+TEST_F(TransmitQueueTest, RetriesWhenRadioRefuses) {
+  TransmitQueue<> queue(&codec, &radio);
+  radio.set_accepting(false);
+  queue.enqueue(message(0x123456), 1);
+  queue.update(0);
+  queue.update(1);
+  EXPECT_TRUE(radio.get_transmissions().empty());
+  EXPECT_EQ(queue.pending(), 1u);
+
+  radio.set_accepting(true);
+  queue.update(2);
+  ASSERT_EQ(radio.get_transmissions().size(), 1u);
+  EXPECT_EQ(queue.get_max_latency_ms(), 2u);
+}
+
+TEST_F(TransmitQueueTest, DropsWhenFullOrUnencodable) {
+  TransmitQueue<2> queue(&codec, &radio);
+
+  EXPECT_TRUE(queue.enqueue(message(0x1), 1));
+  EXPECT_TRUE(queue.enqueue(message(0x2), 1));
+  EXPECT_FALSE(queue.enqueue(message(0x3), 1));
+  EXPECT_EQ(queue.get_dropped_count(), 1u);
+
+  TransmitQueue<4, 16> small(&codec, &radio);
+  EXPECT_FALSE(small.enqueue(message(0xABCDEF), 1));  // 50 edges > 16
+  EXPECT_FALSE(small.enqueue(message(0x1, 4), 0));     // No repeats
+  EXPECT_EQ(small.get_dropped_count(), 2u);
+}
+
+TEST_F(TransmitQueueTest, LatencyAndOrderUnderLoad) {
+  // A Home Assistant scene closing 8 blinds at once, 4 repeats each
+  TransmitQueue<8> queue(&codec, &radio);
+  uint32_t now = 1000;
+  radio.set_now(now);
+  queue.update(now);
+  for (uint32_t i = 0; i < 8; ++i) {
+    ASSERT_TRUE(queue.enqueue(message(0xB00000 | i), 4));
+  }
+  run(queue, now);
+
+  const auto& txs = radio.get_transmissions();
+  ASSERT_EQ(txs.size(), 16u);
+  EXPECT_EQ(queue.get_completed_count(), 8u);
+
+  // First turns go out in enqueue order, then the second round
+  for (uint32_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(code_of(txs[i]), 0xB00000u | (i % 8)) << "transmission " << i;
+  }
+
+  // Every blind hears its first frames after 7 turns at most (~90 ms
+  // each plus gaps), rather than behind 7 full repeat counts
+  uint32_t last_first_start = txs[7].start_ms - 1000;
+  EXPECT_EQ(queue.get_max_latency_ms(), last_first_start);
+  EXPECT_LT(queue.get_max_latency_ms(), 7u * 110u);
+
+  // A command queued after the burst goes out on its own
+  queue.enqueue(message(0xC0FFEE), 2);
+  run(queue, now);
+  EXPECT_EQ(code_of(radio.get_transmissions().back()), 0xC0FFEEu);
+}
+
+}  // namespace home_esp::testing
@@ -0,0 +1,466 @@
+#pragma once
+
+// OokDemodulator - SDR IQ samples to RF433 edge durations
+// Host-side stage for the replay tool; not part of the firmware build
+// RTL-SDR .cu8/.cs16 recordings, with SSE2/AVX2 kernels on x86
+
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HOME_ESP_OOK_X86 1
+#include <immintrin.h>
+#endif
+
+namespace home_esp {
+
+/// On-off keying envelope detector with an adaptive threshold.
+///
+/// Samples are processed in blocks of BLOCK_SAMPLES:
+/// 1. Envelope: |IQ|^2 per sample (vectorised), with the block's maximum
+///    and sum.
+/// 2. Threshold: a noise floor (mean power of blocks with no carrier) and
+///    a decaying peak are tracked per block; the threshold sits a quarter
+///    of the way from noise to peak, and never below min_snr x noise.
+/// 3. Edges: samples above the threshold become a bitmask (vectorised
+///    compare), and transitions are found with count-trailing-zeros.
+///    Runs shorter than min_pulse_us are threshold flicker and are
+///    merged back into the surrounding run.
+///
+/// Edges leave through sink(uint16_t duration_us), high first, the same
+/// contract as PulseFilter, so the output can go to a PulseFilter, a
+/// stream decoder or a ring for RF433Receiver::drain(). Durations are
+/// computed from absolute sample positions, so they don't drift, and
+/// saturate at 65535us. Like PulseFilter, edges leave one edge late.
+class OokDemodulator {
+ public:
+  /// Envelope and compare implementation
+  enum class Kernel : uint8_t { SCALAR, SSE2, AVX2 };
+
+  /// Configuration for demodulation
+  struct Config {
+    uint32_t sample_rate;   // Complex samples per second
+    uint8_t min_snr;        // Threshold floor, as a multiple of noise power
+    uint16_t min_pulse_us;  // Shorter runs are merged as flicker
+    Kernel kernel;
+
+    // min_snr 16 (12 dB) keeps noise-only crossings to ~1e-7 per sample
+    Config()
+        : sample_rate(2000000),
+          min_snr(16),
+          min_pulse_us(20),
+          kernel(best_kernel()) {}
+  };
+
+  /// Samples per threshold update (128us at 2 Msps)
+  static constexpr size_t BLOCK_SAMPLES = 256;
+
+  explicit OokDemodulator(Config config = Config())
+      : config_(config),
+        min_pulse_samples_(static_cast<uint64_t>(config.min_pulse_us) *
+                           config.sample_rate / 1000000) {
+    if (!kernel_supported(config_.kernel)) {
+      config_.kernel = Kernel::SCALAR;
+    }
+  }
+
+  /// Fastest kernel this CPU runs
+  static Kernel best_kernel() {
+#ifdef HOME_ESP_OOK_X86
+    if (__builtin_cpu_supports("avx2")) {
+      return Kernel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+      return Kernel::SSE2;
+    }
+#endif
+    return Kernel::SCALAR;
+  }
+
+  static bool kernel_supported(Kernel kernel) {
+#ifdef HOME_ESP_OOK_X86
+    if (kernel == Kernel::AVX2) {
+      return __builtin_cpu_supports("avx2");
+    }
+    if (kernel == Kernel::SSE2) {
+      return __builtin_cpu_supports("sse2");
+    }
+#endif
+    return kernel == Kernel::SCALAR;
+  }
+
+  /// Demodulate unsigned 8-bit IQ (RTL-SDR .cu8): I, Q, I, Q, ...
+  /// @param samples Complex samples, i.e. half the byte count
+  template <typename Sink>
+  void process_cu8(const uint8_t* iq, size_t samples, Sink&& sink) {
+    process(iq, samples, sink, &OokDemodulator::magnitude_cu8);
+  }
+
+  /// Demodulate signed 16-bit IQ (.cs16). Samples are scaled to 12 bits,
+  /// beyond the resolution of common SDR front ends.
+  template <typename Sink>
+  void process_cs16(const int16_t* iq, size_t samples, Sink&& sink) {
+    process(iq, samples, sink, &OokDemodulator::magnitude_cs16);
+  }
+
+  /// Release the held edge and the run in progress (e.g. at the end of
+  /// a recording)
+  template <typename Sink>
+  void flush(Sink&& sink) {
+    if (have_pending_) {
+      emit(pending_start_, run_start_, sink);
+      have_pending_ = false;
+    }
+    if (started_) {
+      emit(run_start_, position_, sink);
+      started_ = false;
+    }
+  }
+
+  /// Forget levels and edges, e.g. before an unrelated recording
+  void reset() {
+    position_ = 0;
+    run_start_ = 0;
+    pending_start_ = 0;
+    noise_ = 0;
+    peak_ = 0;
+    threshold_ = 0;
+    primed_ = false;
+    level_ = false;
+    started_ = false;
+    have_pending_ = false;
+  }
+
+  /// Current detection threshold, noise floor and peak, in |IQ|^2 units
+  uint32_t get_threshold() const { return threshold_; }
+  uint32_t get_noise_floor() const { return noise_; }
+  uint32_t get_peak() const { return peak_; }
+
+  /// Complex samples processed since construction or reset()
+  uint64_t get_sample_count() const { return position_; }
+
+  const Config& get_config() const { return config_; }
+
+ private:
+  static constexpr uint8_t PEAK_DECAY_SHIFT = 5;    // ~4ms at 2 Msps
+  static constexpr uint8_t NOISE_AVERAGE_SHIFT = 4;
+  static constexpr uint8_t CS16_SHIFT = 4;          // 16 -> 12 bits
+
+  using MagnitudeFn = uint32_t (*)(Kernel, const void*, size_t, uint32_t*, uint32_t&);
+
+  template <typename Sample, typename Sink>
+  void process(const Sample* iq, size_t samples, Sink& sink, MagnitudeFn magnitude) {
+    uint32_t mag[BLOCK_SAMPLES];
+    uint64_t bits[BLOCK_SAMPLES / 64];
+
+    while (samples > 0) {
+      size_t n = samples < BLOCK_SAMPLES ? samples : BLOCK_SAMPLES;
+      uint32_t max = 0;
+      uint32_t sum = magnitude(config_.kernel, iq, n, mag, max);
+      update_threshold(max, sum / n);
+      compare(config_.kernel, mag, n, threshold_, bits);
+      find_edges(bits, n, sink);
+
+      position_ += n;
+      iq += n * 2;
+      samples -= n;
+    }
+  }
+
+  void update_threshold(uint32_t block_max, uint32_t block_mean) {
+    if (!primed_) {
+      noise_ = block_mean;
+      peak_ = block_max;
+      primed_ = true;
+    }
+    peak_ = block_max > peak_ ? block_max : peak_ - (peak_ >> PEAK_DECAY_SHIFT);
+    if (block_max < threshold_) {
+      // No carrier in this block: follow the noise floor
+      int64_t delta = static_cast<int64_t>(block_mean) - noise_;
+      noise_ = static_cast<uint32_t>(noise_ + delta / (1 << NOISE_AVERAGE_SHIFT));
+    }
+    uint64_t floor = static_cast<uint64_t>(noise_) * config_.min_snr;
+    uint64_t mid = noise_ + (peak_ > noise_ ? (peak_ - noise_) / 4 : 0);
+    uint64_t threshold = floor > mid ? floor : mid;
+    threshold_ = threshold > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(threshold);
+  }
+
+  /// Walk level transitions of one block's above-threshold bitmask
+  template <typename Sink>
+  void find_edges(const uint64_t* bits, size_t n, Sink& sink) {
+    for (size_t w = 0; w * 64 < n; ++w) {
+      size_t valid = n - w * 64 < 64 ? n - w * 64 : 64;
+      uint64_t mask = valid == 64 ? ~0ull : (1ull << valid) - 1;
+      uint64_t word = bits[w] & mask;
+      uint64_t changes = (word ^ ((word << 1) | (level_ ? 1u : 0u))) & mask;
+
+      while (changes != 0) {
+        unsigned bit = __builtin_ctzll(changes);
+        changes &= changes - 1;
+        edge(position_ + w * 64 + bit, sink);
+      }
+      level_ = (word >> (valid - 1)) & 1;
+    }
+  }
+
+  template <typename Sink>
+  void edge(uint64_t sample, Sink& sink) {
+    level_ = !level_;
+    if (!started_) {
+      // Output starts with a high, so skip everything before the first rise
+      started_ = level_;
+      run_start_ = sample;
+      return;
+    }
+
+    if (have_pending_ && sample - run_start_ < min_pulse_samples_) {
+      // Flicker: the held run continues through it
+      run_start_ = pending_start_;
+      have_pending_ = false;
+      return;
+    }
+    if (have_pending_) {
+      emit(pending_start_, run_start_, sink);
+    }
+    pending_start_ = run_start_;
+    have_pending_ = true;
+    run_start_ = sample;
+  }
+
+  template <typename Sink>
+  void emit(uint64_t start, uint64_t end, Sink& sink) {
+    uint64_t us = to_us(end) - to_us(start);
+    sink(us > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(us));
+  }
+
+  uint64_t to_us(uint64_t sample) const {
+    return sample * 1000000 / config_.sample_rate;
+  }
+
+  // ---- Kernels ----
+  // Each envelope kernel writes |IQ|^2 for n samples into mag, sets max
+  // and returns the sum. Sums fit 32 bits: cu8 power is at most 2^15 and
+  // scaled cs16 at most 2^23, over at most BLOCK_SAMPLES = 2^8 samples.
+
+  static uint32_t magnitude_cu8(Kernel kernel, const void* data, size_t n,
+                                uint32_t* mag, uint32_t& max) {
+    const uint8_t* iq = static_cast<const uint8_t*>(data);
+    size_t done = 0;
+    uint32_t sum = 0;
+#ifdef HOME_ESP_OOK_X86
+    if (kernel == Kernel::AVX2) {
+      done = magnitude_cu8_avx2(iq, n, mag, max, sum);
+    } else if (kernel == Kernel::SSE2) {
+      done = magnitude_cu8_sse2(iq, n, mag, max, sum);
+    }
+#else
+    (void)kernel;
+#endif
+    for (size_t i = done; i < n; ++i) {
+      int32_t re = static_cast<int32_t>(iq[i * 2]) - 128;
+      int32_t im = static_cast<int32_t>(iq[i * 2 + 1]) - 128;
+      mag[i] = static_cast<uint32_t>(re * re + im * im);
+      max = mag[i] > max ? mag[i] : max;
+      sum += mag[i];
+    }
+    return sum;
+  }
+
+  static uint32_t magnitude_cs16(Kernel kernel, const void* data, size_t n,
+                                 uint32_t* mag, uint32_t& max) {
+    const int16_t* iq = static_cast<const int16_t*>(data);
+    size_t done = 0;
+    uint32_t sum = 0;
+#ifdef HOME_ESP_OOK_X86
+    if (kernel == Kernel::AVX2) {
+      done = magnitude_cs16_avx2(iq, n, mag, max, sum);
+    } else if (kernel == Kernel::SSE2) {
+      done = magnitude_cs16_sse2(iq, n, mag, max, sum);
+    }
+#else
+    (void)kernel;
+#endif
+    for (size_t i = done; i < n; ++i) {
+      int32_t re = iq[i * 2] >> CS16_SHIFT;
+      int32_t im = iq[i * 2 + 1] >> CS16_SHIFT;
+      mag[i] = static_cast<uint32_t>(re * re + im * im);
+      max = mag[i] > max ? mag[i] : max;
+      sum += mag[i];
+    }
+    return sum;
+  }
+
+  /// Set bit i of bits when mag[i] > threshold
+  static void compare(Kernel kernel, const uint32_t* mag, size_t n, uint32_t threshold,
+                      uint64_t* bits) {
+    for (size_t w = 0; w * 64 < n; ++w) {
+      bits[w] = 0;
+    }
+    size_t done = 0;
+#ifdef HOME_ESP_OOK_X86
+    if (kernel == Kernel::AVX2) {
+      done = compare_avx2(mag, n, threshold, bits);
+    } else if (kernel == Kernel::SSE2) {
+      done = compare_sse2(mag, n, threshold, bits);
+    }
+#else
+    (void)kernel;
+#endif
+    for (size_t i = done; i < n; ++i) {
+      bits[i / 64] |= static_cast<uint64_t>(mag[i] > threshold) << (i % 64);
+    }
+  }
+
+#ifdef HOME_ESP_OOK_X86
+  // Magnitudes stay below 2^31, so signed 32-bit compares are exact
+
+  __attribute__((target("sse2"))) static __m128i max_epi32_sse2(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+  }
+
+  __attribute__((target("sse2"))) static uint32_t reduce_sse2(__m128i vmax, __m128i vsum,
+                                                              uint32_t& max) {
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), vmax);
+    for (uint32_t v : lanes) {
+      max = v > max ? v : max;
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), vsum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+
+  /// 8 samples (16 bytes) per iteration: widen, centre, then
+  /// madd(v, v) gives I*I + Q*Q for each interleaved pair
+  __attribute__((target("sse2"))) static size_t magnitude_cu8_sse2(
+      const uint8_t* iq, size_t n, uint32_t* mag, uint32_t& max, uint32_t& sum) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    __m128i vmax = zero, vsum = zero;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iq + i * 2));
+      __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(raw, zero), bias);
+      __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(raw, zero), bias);
+      __m128i p0 = _mm_madd_epi16(lo, lo);
+      __m128i p1 = _mm_madd_epi16(hi, hi);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(mag + i), p0);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(mag + i + 4), p1);
+      vmax = max_epi32_sse2(vmax, max_epi32_sse2(p0, p1));
+      vsum = _mm_add_epi32(vsum, _mm_add_epi32(p0, p1));
+    }
+    sum += reduce_sse2(vmax, vsum, max);
+    return i;
+  }
+
+  __attribute__((target("sse2"))) static size_t magnitude_cs16_sse2(
+      const int16_t* iq, size_t n, uint32_t* mag, uint32_t& max, uint32_t& sum) {
+    __m128i vmax = _mm_setzero_si128(), vsum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iq + i * 2));
+      __m128i v = _mm_srai_epi16(raw, CS16_SHIFT);
+      __m128i p = _mm_madd_epi16(v, v);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(mag + i), p);
+      vmax = max_epi32_sse2(vmax, p);
+      vsum = _mm_add_epi32(vsum, p);
+    }
+    sum += reduce_sse2(vmax, vsum, max);
+    return i;
+  }
+
+  __attribute__((target("sse2"))) static size_t compare_sse2(
+      const uint32_t* mag, size_t n, uint32_t threshold, uint64_t* bits) {
+    const __m128i thr = _mm_set1_epi32(static_cast<int32_t>(threshold > INT32_MAX ? INT32_MAX : threshold));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mag + i));
+      uint64_t m = static_cast<uint64_t>(
+          _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, thr))));
+      bits[i / 64] |= m << (i % 64);
+    }
+    return i;
+  }
+
+  __attribute__((target("avx2"))) static uint32_t reduce_avx2(__m256i vmax, __m256i vsum,
+                                                              uint32_t& max) {
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), vmax);
+    for (uint32_t v : lanes) {
+      max = v > max ? v : max;
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), vsum);
+    uint32_t sum = 0;
+    for (uint32_t v : lanes) {
+      sum += v;
+    }
+    return sum;
+  }
+
+  /// 16 samples (32 bytes) per iteration
+  __attribute__((target("avx2"))) static size_t magnitude_cu8_avx2(
+      const uint8_t* iq, size_t n, uint32_t* mag, uint32_t& max, uint32_t& sum) {
+    const __m256i bias = _mm256_set1_epi16(128);
+    __m256i vmax = _mm256_setzero_si256(), vsum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      __m128i raw_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iq + i * 2));
+      __m128i raw_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iq + i * 2 + 16));
+      __m256i lo = _mm256_sub_epi16(_mm256_cvtepu8_epi16(raw_lo), bias);
+      __m256i hi = _mm256_sub_epi16(_mm256_cvtepu8_epi16(raw_hi), bias);
+      __m256i p0 = _mm256_madd_epi16(lo, lo);
+      __m256i p1 = _mm256_madd_epi16(hi, hi);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(mag + i), p0);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(mag + i + 8), p1);
+      vmax = _mm256_max_epi32(vmax, _mm256_max_epi32(p0, p1));
+      vsum = _mm256_add_epi32(vsum, _mm256_add_epi32(p0, p1));
+    }
+    sum += reduce_avx2(vmax, vsum, max);
+    return i;
+  }
+
+  __attribute__((target("avx2"))) static size_t magnitude_cs16_avx2(
+      const int16_t* iq, size_t n, uint32_t* mag, uint32_t& max, uint32_t& sum) {
+    __m256i vmax = _mm256_setzero_si256(), vsum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(iq + i * 2));
+      __m256i v = _mm256_srai_epi16(raw, CS16_SHIFT);
+      __m256i p = _mm256_madd_epi16(v, v);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(mag + i), p);
+      vmax = _mm256_max_epi32(vmax, p);
+      vsum = _mm256_add_epi32(vsum, p);
+    }
+    sum += reduce_avx2(vmax, vsum, max);
+    return i;
+  }
+
+  __attribute__((target("avx2"))) static size_t compare_avx2(
+      const uint32_t* mag, size_t n, uint32_t threshold, uint64_t* bits) {
+    const __m256i thr = _mm256_set1_epi32(static_cast<int32_t>(threshold > INT32_MAX ? INT32_MAX : threshold));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mag + i));
+      uint64_t m = static_cast<uint64_t>(
+          _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, thr))));
+      bits[i / 64] |= m << (i % 64);
+    }
+    return i;
+  }
+#endif
+
+  Config config_;
+  uint64_t min_pulse_samples_;
+  uint64_t position_{0};       // Absolute sample index of the next block
+  uint64_t run_start_{0};      // Start of the run in progress
+  uint64_t pending_start_{0};  // Start of the held run (ends at run_start_)
+  uint32_t noise_{0};
+  uint32_t peak_{0};
+  uint32_t threshold_{0};
+  bool primed_{false};
+  bool level_{false};       // Comparator level of the last sample
+  bool started_{false};     // First rising edge seen
+  bool have_pending_{false};
+};
+
+}  // namespace home_esp
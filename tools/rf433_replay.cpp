@@ -0,0 +1,492 @@
+// rf433_replay - Replay RF pulse captures through the RF433 decoders
+// Host-side tool (POSIX); not part of the firmware build
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -Wall -Wextra -I lib -I lib/core tools/rf433_replay.cpp -o rf433_replay
+//
+// Usage:
+//   rf433_replay [--stream] [--filter] [--repeat N] [--rate HZ] [--write OUT] CAPTURE...
+//       Decode each capture (see core/rf433_capture.h) and report
+//       throughput, decode statistics and, for labelled captures, how
+//       many of the expected frames decoded to the expected code.
+//       Files ending in .cu8 or .cs16 are SDR IQ recordings: they are
+//       demodulated by OokDemodulator first (demodulation throughput is
+//       reported separately) and then decoded like a capture.
+//       --stream  Decode edge by edge (RF433StreamDecoder, as the bridge
+//                 does) instead of frame scanning (RF433Codec::decode_all)
+//       --filter  Run edges through PulseFilter first (implies --stream)
+//       --repeat  Replay each capture N times, for steadier timings
+//       --rate    IQ sample rate in Hz (default 2000000)
+//       --write   Save the capture demodulated from an IQ recording
+//   rf433_replay --generate FILE FRAMES [CODE]
+//       Write a labelled synthetic capture: FRAMES PT2262 frames of CODE
+//       (default 0xABCDEF), each burst of 4 repeats separated by noise.
+
+#include "core/pulse_filter.h"
+#include "core/rf433_capture.h"
+#include "core/rf433_codec.h"
+#include "core/rf433_stream_decoder.h"
+#include "ook_demodulator.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace home_esp;
+
+namespace {
+
+struct Options {
+  bool stream{false};
+  bool filter{false};
+  unsigned repeat{1};
+  uint32_t sample_rate{2000000};
+  const char* write_path{nullptr};
+};
+
+struct ReplayResult {
+  uint64_t runs{0};
+  uint64_t edges{0};
+  uint64_t frames{0};
+  uint64_t matched{0};
+  RF433DecodeStats stats;
+};
+
+/// Read-only mapping of a whole file
+class MappedFile {
+ public:
+  bool open(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      std::perror(path);
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      std::fprintf(stderr, "%s: empty or unreadable\n", path);
+      ::close(fd);
+      return false;
+    }
+    len_ = static_cast<size_t>(st.st_size);
+    void* map = mmap(nullptr, len_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (map == MAP_FAILED) {
+      std::perror(path);
+      return false;
+    }
+    madvise(map, len_, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t*>(map);
+    return true;
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      munmap(const_cast<uint8_t*>(data_), len_);
+    }
+  }
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return len_; }
+
+ private:
+  const uint8_t* data_{nullptr};
+  size_t len_{0};
+};
+
+/// Counts decoded frames against the capture's label
+class FrameCounter {
+ public:
+  FrameCounter(const RF433CaptureHeader& header, ReplayResult& result)
+      : header_(header), result_(result) {}
+
+  void operator()(const DecodedMessage& msg) {
+    result_.frames++;
+    if (msg.code == header_.expected_code && msg.bit_length == header_.expected_bits) {
+      result_.matched++;
+    }
+  }
+
+ private:
+  const RF433CaptureHeader& header_;
+  ReplayResult& result_;
+};
+
+/// Edges in the longest frame decode_all() can hold back: sync + 24 bits
+constexpr size_t MAX_FRAME_EDGES = (1 + 24) * 2;
+
+/// Run decode_all() over edges [0, edges) until it stops finding frames.
+/// decode(from, out, max_out, found) decodes from edge `from` and returns
+/// the edges it consumed.
+/// @return Edges consumed
+template <typename Decode>
+size_t scan_edges(size_t edges, Decode&& decode, RF433Receiver& receiver,
+                  FrameCounter& count) {
+  size_t consumed = 0;
+  while (consumed < edges) {
+    DecodedMessage frames[16];
+    size_t found = 0;
+    size_t used = decode(consumed, frames, sizeof(frames) / sizeof(frames[0]), found);
+    for (size_t i = 0; i < found; ++i) {
+      receiver.process_message(frames[i]);
+      count(frames[i]);
+    }
+    consumed += used;
+    if (found == 0 || used == 0) {
+      break;
+    }
+  }
+  return consumed;
+}
+
+void replay_scan(RF433CaptureReader& reader, RF433Codec& codec,
+                 RF433Receiver& receiver, FrameCounter& count, ReplayResult& result) {
+  // Edges decode_all() left unconsumed at the end of the previous run: a
+  // frame can straddle two runs
+  std::vector<uint16_t> carry;
+  auto decode_carry = [&](bool end_of_input) {
+    return [&codec, &carry, end_of_input](size_t from, DecodedMessage* out, size_t max_out,
+                                          size_t& found) {
+      return codec.decode_all(PulseSpan(carry.data() + from, carry.size() - from), out,
+                              max_out, found, end_of_input);
+    };
+  };
+
+  RF433CaptureRun run;
+  while (reader.next(run)) {
+    result.runs++;
+    result.edges += run.edge_count;
+
+    LEPulseBytes edges = run.edges();
+    size_t start = 0;
+    if (!carry.empty()) {
+      // Decode the carried edges with just enough of this run to finish
+      // any frame they start, then continue in place where that stopped
+      size_t carried = carry.size();
+      size_t head = std::min(edges.size(), MAX_FRAME_EDGES);
+      for (size_t i = 0; i < head; ++i) {
+        carry.push_back(edges.duration_us(i));
+      }
+      size_t used = scan_edges(carry.size(), decode_carry(false), receiver, count);
+      if (head == edges.size()) {
+        carry.erase(carry.begin(), carry.begin() + used);  // Whole run was stitched
+        continue;
+      }
+      start = used > carried ? used - carried : 0;
+      carry.clear();
+    }
+
+    size_t used = scan_edges(
+        edges.size() - start,
+        [&](size_t from, DecodedMessage* out, size_t max_out, size_t& found) {
+          const uint8_t* data = run.data + (start + from) * 2;
+          size_t len = (edges.size() - start - from) * 2;
+          return codec.decode_all(data, len, out, max_out, found) / 2;
+        },
+        receiver, count);
+    for (size_t i = start + used; i < edges.size(); ++i) {
+      carry.push_back(edges.duration_us(i));
+    }
+  }
+
+  // Nothing follows the last run: finish a frame cut off there
+  scan_edges(carry.size(), decode_carry(true), receiver, count);
+}
+
+template <typename Decoder>
+void replay_stream(RF433CaptureReader& reader, Decoder& decoder, PulseFilter* filter,
+                   RF433Receiver& receiver, FrameCounter& count, ReplayResult& result) {
+  auto feed = [&](uint16_t duration_us) {
+    DecodedMessage msg;
+    if (decoder.feed(duration_us, msg)) {
+      receiver.process_message(msg);
+      count(msg);
+    }
+  };
+
+  RF433CaptureRun run;
+  while (reader.next(run)) {
+    result.runs++;
+    result.edges += run.edge_count;
+
+    LEPulseBytes edges = run.edges();
+    for (size_t i = 0; i < edges.size(); ++i) {
+      if (filter != nullptr) {
+        filter->feed(edges.duration_us(i), feed);
+      } else {
+        feed(edges.duration_us(i));
+      }
+    }
+  }
+  if (filter != nullptr) {
+    filter->flush(feed);
+  }
+  DecodedMessage msg;
+  if (decoder.flush(msg)) {
+    receiver.process_message(msg);
+    count(msg);
+  }
+}
+
+bool ends_with(const char* text, const char* suffix) {
+  size_t len = std::strlen(text), suffix_len = std::strlen(suffix);
+  return len >= suffix_len && std::strcmp(text + len - suffix_len, suffix) == 0;
+}
+
+/// Demodulate an IQ recording into an in-memory capture
+std::vector<uint8_t> demodulate(const char* path, const MappedFile& file,
+                                const Options& options) {
+  std::vector<uint8_t> capture;
+  auto sink = [&](const uint8_t* data, size_t len) {
+    capture.insert(capture.end(), data, data + len);
+  };
+  RF433CaptureWriter<decltype(sink)> writer(sink);
+  writer.write_header(RF433CaptureHeader());
+
+  OokDemodulator::Config config;
+  config.sample_rate = options.sample_rate;
+  OokDemodulator demod(config);
+
+  // Runs end after a quiet gap (a saturated low) or every 4096 edges
+  std::vector<uint16_t> run;
+  uint32_t run_ms = 0;
+  auto edge = [&](uint16_t duration_us) {
+    if (run.empty()) {
+      run_ms = static_cast<uint32_t>(demod.get_sample_count() * 1000 / options.sample_rate);
+    }
+    run.push_back(duration_us);
+    if (run.size() % 2 == 0 && (duration_us == UINT16_MAX || run.size() >= 4096)) {
+      writer.write_run(run_ms, PulseSpan(run.data(), run.size()));
+      run.clear();
+    }
+  };
+
+  bool cs16 = ends_with(path, ".cs16");
+  size_t samples = file.size() / (cs16 ? 4 : 2);
+  auto start = std::chrono::steady_clock::now();
+  if (cs16) {
+    demod.process_cs16(reinterpret_cast<const int16_t*>(file.data()), samples, edge);
+  } else {
+    demod.process_cu8(file.data(), samples, edge);
+  }
+  demod.flush(edge);
+  if (!run.empty()) {
+    writer.write_run(run_ms, PulseSpan(run.data(), run.size()));
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const char* kernels[] = {"scalar", "SSE2", "AVX2"};
+  double air = static_cast<double>(samples) / options.sample_rate;
+  std::printf("%s: %.1f s of %s IQ at %.2f Msps, demodulated (%s) in %.3f s "
+              "(%.1f Msps, %.0fx real time)\n",
+              path, air, cs16 ? "cs16" : "cu8", options.sample_rate / 1e6,
+              kernels[static_cast<int>(demod.get_config().kernel)], seconds,
+              samples / seconds / 1e6, air / seconds);
+
+  if (options.write_path != nullptr) {
+    FILE* out = std::fopen(options.write_path, "wb");
+    if (out == nullptr || std::fwrite(capture.data(), 1, capture.size(), out) != capture.size()) {
+      std::perror(options.write_path);
+    }
+    if (out != nullptr) {
+      std::fclose(out);
+    }
+  }
+  return capture;
+}
+
+int replay(const char* path, const Options& options) {
+  MappedFile file;
+  if (!file.open(path)) {
+    return 1;
+  }
+
+  const uint8_t* data = file.data();
+  size_t size = file.size();
+  std::vector<uint8_t> demodulated;
+  if (ends_with(path, ".cu8") || ends_with(path, ".cs16")) {
+    demodulated = demodulate(path, file, options);
+    data = demodulated.data();
+    size = demodulated.size();
+  }
+
+  RF433CaptureReader reader;
+  if (!reader.open(data, size)) {
+    std::fprintf(stderr, "%s: not an RF433 capture (or unsupported version)\n", path);
+    return 1;
+  }
+  const RF433CaptureHeader& header = reader.header();
+
+  ReplayResult result;
+  FrameCounter count(header, result);
+  RF433Codec codec;
+  RF433StreamDecoder decoder;
+  codec.set_timing_stats(true);
+  decoder.enable_timing_stats(codec.get_config());
+  PulseFilter filter;
+  RF433Receiver receiver(&codec, nullptr);
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < options.repeat; ++r) {
+    reader.rewind();
+    if (options.stream) {
+      replay_stream(reader, decoder, options.filter ? &filter : nullptr, receiver,
+                    count, result);
+    } else {
+      replay_scan(reader, codec, receiver, count, result);
+    }
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  result.stats = codec.get_stats();
+  result.stats += decoder.stats();
+
+  double mb = static_cast<double>(size) * options.repeat / (1024.0 * 1024.0);
+  std::printf("%s: %.1f MiB x %u, %llu runs, %llu edges%s\n", path,
+              static_cast<double>(size) / (1024.0 * 1024.0), options.repeat,
+              static_cast<unsigned long long>(result.runs),
+              static_cast<unsigned long long>(result.edges),
+              reader.truncated() ? " (last run truncated)" : "");
+  std::printf("  decoder:    %s\n", options.filter   ? "PulseFilter + RF433StreamDecoder"
+                                    : options.stream ? "RF433StreamDecoder"
+                                                     : "RF433Codec::decode_all");
+  std::printf("  frames:     %llu in %.3f s (%.0f frames/s, %.1f Medges/s, %.1f MiB/s)\n",
+              static_cast<unsigned long long>(result.frames), seconds,
+              result.frames / seconds, result.edges / seconds / 1e6, mb / seconds);
+  std::printf("  seen %u, accepted %u, rejected length %u / sync %u / bits %u\n",
+              result.stats.seen, result.stats.accepted,
+              result.stats.rejected_count(RF433RejectReason::LENGTH),
+              result.stats.rejected_count(RF433RejectReason::SYNC),
+              result.stats.rejected_count(RF433RejectReason::BITS));
+  if (result.stats.error_samples() > 0) {
+    std::printf("  mean pulse timing error: %.1f%%\n", result.stats.mean_error_percent());
+  }
+  if (filter.get_passed_count() > 0) {
+    std::printf("  filter: %u merged, %u dropped, %u passed\n", filter.get_merged_count(),
+                filter.get_dropped_count(), filter.get_passed_count());
+  }
+
+  if (header.has_expected_code()) {
+    // Out of the frames sent, so missed frames count against accuracy;
+    // anything else decoded is a false decode
+    uint64_t expected = static_cast<uint64_t>(header.expected_frames) * options.repeat;
+    std::printf("  expected 0x%06X/%u: ", header.expected_code, header.expected_bits);
+    if (expected > 0) {
+      std::printf("%llu of %llu frames decoded (%.2f%%)",
+                  static_cast<unsigned long long>(result.matched),
+                  static_cast<unsigned long long>(expected),
+                  100.0 * result.matched / expected);
+    } else {
+      std::printf("%llu frames decoded (frame count not recorded)",
+                  static_cast<unsigned long long>(result.matched));
+    }
+    std::printf(", %llu other frames\n",
+                static_cast<unsigned long long>(result.frames - result.matched));
+  }
+  return 0;
+}
+
+int generate(const char* path, unsigned long frames, uint32_t code) {
+  FILE* out = std::fopen(path, "wb");
+  if (out == nullptr) {
+    std::perror(path);
+    return 1;
+  }
+  auto sink = [out](const uint8_t* data, size_t len) { std::fwrite(data, 1, len, out); };
+  RF433CaptureWriter<decltype(sink)> writer(sink);
+
+  RF433CaptureHeader header;
+  header.expected_code = code;
+  header.expected_bits = 24;
+  header.protocol_hint = 1;
+  header.expected_frames = static_cast<uint32_t>(frames);
+  writer.write_header(header);
+
+  RF433Codec codec;
+  DecodedMessage msg;
+  msg.code = code;
+  msg.bit_length = 24;
+  uint16_t frame[64];
+  size_t frame_len = 0;
+  codec.encode(msg, MutablePulseSpan(frame), frame_len);
+
+  // Bursts of 4 repeats, with idle receiver noise between bursts
+  const unsigned REPEATS = 4;
+  std::vector<uint16_t> burst;
+  std::srand(1);
+  uint32_t timestamp_ms = 0;
+  for (unsigned long sent = 0; sent < frames; sent += REPEATS) {
+    burst.clear();
+    for (int i = 0; i < 200; ++i) {
+      burst.push_back(static_cast<uint16_t>(20 + std::rand() % 1500));
+    }
+    for (unsigned r = 0; r < REPEATS && sent + r < frames; ++r) {
+      burst.insert(burst.end(), frame, frame + frame_len);
+    }
+    writer.write_run(timestamp_ms, PulseSpan(burst.data(), burst.size()));
+    timestamp_ms += 250;
+  }
+
+  bool ok = std::fclose(out) == 0;
+  if (!ok) {
+    std::perror(path);
+  }
+  return ok ? 0 : 1;
+}
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: rf433_replay [--stream] [--filter] [--repeat N] [--rate HZ]\n"
+               "                    [--write OUT] CAPTURE|IQ.cu8|IQ.cs16...\n"
+               "       rf433_replay --generate FILE FRAMES [CODE]\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc >= 4 && std::strcmp(argv[1], "--generate") == 0) {
+    uint32_t code = argc >= 5 ? std::strtoul(argv[4], nullptr, 0) : 0xABCDEF;
+    return generate(argv[2], std::strtoul(argv[3], nullptr, 0), code);
+  }
+
+  Options options;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; ++i) {
+    if (std::strcmp(argv[i], "--stream") == 0) {
+      options.stream = true;
+    } else if (std::strcmp(argv[i], "--filter") == 0) {
+      options.stream = true;
+      options.filter = true;
+    } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+      options.repeat = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+      options.repeat = options.repeat > 0 ? options.repeat : 1;
+    } else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+      options.sample_rate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+      options.sample_rate = options.sample_rate > 0 ? options.sample_rate : 2000000;
+    } else if (std::strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+      options.write_path = argv[++i];
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (i == argc) {
+    usage();
+    return 2;
+  }
+
+  int status = 0;
+  for (; i < argc; ++i) {
+    status |= replay(argv[i], options);
+  }
+  return status;
+}